@@ -22,6 +22,9 @@
 #include <utils/network.hpp>
 #include <utils/options.hpp>
 
+// Longer than the time a node process waits for the nodes of a selector, so that its summary is not missed
+static constexpr const int RESPONSE_TIMEOUT = 15000;
+
 static struct Options
 {
     bool dumpNodes{};
@@ -46,10 +49,12 @@ static std::set<int> FindProcesses()
     return res;
 }
 
-static uint16_t DiscoverNode(const std::string &node, int &skippedDueToVersion)
+static std::set<uint16_t> DiscoverNodes(const std::string &node, int &skippedDueToVersion)
 {
+    std::set<uint16_t> found{};
+
     if (!io::Exists(cons::PROC_TABLE_DIR))
-        return 0;
+        return found;
 
     // Find all processes in the environment
     auto processes = FindProcesses();
@@ -64,7 +69,7 @@ static uint16_t DiscoverNode(const std::string &node, int &skippedDueToVersion)
         entries[file] = app::ProcTableEntry::Decode(content);
     }
 
-    uint16_t found = 0;
+    bool isSelector = app::IsNodeSelector(node);
     skippedDueToVersion = 0;
 
     for (auto &e : entries)
@@ -80,10 +85,10 @@ static uint16_t DiscoverNode(const std::string &node, int &skippedDueToVersion)
         // If searching node exists in this file, extract port number from it.
         for (auto &n : e.second.nodes)
         {
-            if (n == node)
+            if (isSelector ? app::MatchesNodeSelector(node, n) : n == node)
             {
                 if (e.second.major == cons::Major && e.second.minor == cons::Minor && e.second.patch == cons::Patch)
-                    found = e.second.port;
+                    found.insert(e.second.port);
                 else
                     skippedDueToVersion++;
             }
@@ -134,15 +139,17 @@ static std::vector<std::string> DumpNames()
 static void ReadOptions(int argc, char **argv)
 {
     opt::OptionsDescription desc{"UERANSIM",  cons::Tag, "Command Line Interface",
-                                 cons::Owner, "nr-cli",  {"<node-name> [option...]", "--dump"},
+                                 cons::Owner, "nr-cli",  {"<node-name|node-selector> [option...]", "--dump"},
                                  {},          true,      false};
 
     opt::OptionItem itemDump = {'d', "dump", "List all UE and gNBs in the environment", std::nullopt};
     opt::OptionItem itemExec = {'e', "exec", "Execute the given command directly without an interactive shell",
                                 "command"};
+    opt::OptionItem itemAll = {'a', "all", "Execute the command on all nodes in the environment", std::nullopt};
 
     desc.items.push_back(itemDump);
     desc.items.push_back(itemExec);
+    desc.items.push_back(itemAll);
 
     opt::OptionsResult opt{argc, argv, desc, false, nullptr};
 
@@ -150,19 +157,31 @@ static void ReadOptions(int argc, char **argv)
 
     if (!g_options.dumpNodes)
     {
-        if (opt.positionalCount() == 0)
+        if (opt.hasFlag(itemAll))
         {
-            opt.showError("Node name is expected");
-            return;
+            if (opt.positionalCount() > 0)
+            {
+                opt.showError("Node name is not expected together with --all");
+                return;
+            }
+            g_options.nodeName = "*";
         }
-        if (opt.positionalCount() > 1)
+        else
         {
-            opt.showError("Only one node name is expected");
-            return;
+            if (opt.positionalCount() == 0)
+            {
+                opt.showError("Node name is expected");
+                return;
+            }
+            if (opt.positionalCount() > 1)
+            {
+                opt.showError("Only one node name is expected");
+                return;
+            }
+            g_options.nodeName = opt.getPositional(0);
         }
 
-        g_options.nodeName = opt.getPositional(0);
-        if (g_options.nodeName.size() < cons::MinNodeName)
+        if (g_options.nodeName.size() < cons::MinNodeName && !app::IsNodeSelector(g_options.nodeName))
         {
             opt.showError("Node name is too short");
             return;
@@ -182,13 +201,13 @@ static void ReadOptions(int argc, char **argv)
     }
 }
 
-static bool HandleMessage(const app::CliMessage &msg, bool isOneShot)
+// Returns true if the message is the final response of a node process
+static bool HandleMessage(const app::CliMessage &msg, bool &hasError)
 {
     if (msg.type == app::CliMessage::Type::ERROR)
     {
         std::cerr << "ERROR: " << msg.value << std::endl;
-        if (isOneShot)
-            exit(1);
+        hasError = true;
         return true;
     }
 
@@ -201,15 +220,52 @@ static bool HandleMessage(const app::CliMessage &msg, bool isOneShot)
     if (msg.type == app::CliMessage::Type::RESULT)
     {
         std::cout << msg.value << std::endl;
-        if (isOneShot)
-            exit(0);
         return true;
     }
 
+    // Per-node result of a command sent with a node selector, the summary follows as the final result
+    if (msg.type == app::CliMessage::Type::PARTIAL_RESULT)
+    {
+        std::cout << msg.value << std::endl;
+        return false;
+    }
+
     return false;
 }
 
-[[noreturn]] static void SendCommand(uint16_t port)
+// Sends the command to every given node process and waits for the final response of each
+static bool ExecuteCommand(app::CliServer &server, const std::set<uint16_t> &ports, const std::string &command)
+{
+    for (uint16_t port : ports)
+    {
+        server.sendMessage(
+            app::CliMessage::Command(InetAddress{cons::CMD_SERVER_IP, port}, command, g_options.nodeName));
+    }
+
+    bool hasError = false;
+    size_t pending = ports.size();
+    int64_t lastReceived = utils::CurrentTimeMillis();
+    while (pending > 0)
+    {
+        auto msg = server.receiveMessage();
+        if (msg.type == app::CliMessage::Type::EMPTY)
+        {
+            if (utils::CurrentTimeMillis() - lastReceived > RESPONSE_TIMEOUT)
+            {
+                std::cerr << "ERROR: No response received, the response may have been lost" << std::endl;
+                return false;
+            }
+            continue;
+        }
+
+        lastReceived = utils::CurrentTimeMillis();
+        if (HandleMessage(msg, hasError))
+            pending--;
+    }
+    return !hasError;
+}
+
+[[noreturn]] static void SendCommand(const std::set<uint16_t> &ports)
 {
     app::CliServer server{};
 
@@ -233,22 +289,12 @@ static bool HandleMessage(const app::CliMessage &msg, bool isOneShot)
             if (line.empty())
                 continue;
 
-            server.sendMessage(
-                app::CliMessage::Command(InetAddress{cons::CMD_SERVER_IP, port}, line, g_options.nodeName));
-
-            while (!HandleMessage(server.receiveMessage(), false))
-            {
-                // empty
-            }
+            ExecuteCommand(server, ports, line);
         }
     }
     else
     {
-        server.sendMessage(
-            app::CliMessage::Command(InetAddress{cons::CMD_SERVER_IP, port}, g_options.directCmd, g_options.nodeName));
-
-        while (true)
-            HandleMessage(server.receiveMessage(), true);
+        exit(ExecuteCommand(server, ports, g_options.directCmd) ? 0 : 1);
     }
 }
 
@@ -277,25 +323,25 @@ int main(int argc, char **argv)
         exit(1);
     }
 
-    if (g_options.nodeName.size() < cons::MinNodeName)
+    if (g_options.nodeName.size() < cons::MinNodeName && !app::IsNodeSelector(g_options.nodeName))
     {
         std::cerr << "ERROR: Node name is too short" << std::endl;
         exit(1);
     }
 
-    uint16_t cmdPort{};
+    std::set<uint16_t> cmdPorts{};
     int skippedDueToVersion{};
 
     try
     {
-        cmdPort = DiscoverNode(g_options.nodeName, skippedDueToVersion);
+        cmdPorts = DiscoverNodes(g_options.nodeName, skippedDueToVersion);
     }
     catch (const std::runtime_error &e)
     {
         throw std::runtime_error("Node discovery failure: " + std::string{e.what()});
     }
 
-    if (cmdPort == 0)
+    if (cmdPorts.empty())
     {
         std::cerr << "ERROR: No node found with name: " << g_options.nodeName << std::endl;
         if (skippedDueToVersion > 0)
@@ -304,6 +350,6 @@ int main(int argc, char **argv)
         return 1;
     }
 
-    SendCommand(cmdPort);
+    SendCommand(cmdPorts);
     return 0;
 }
\ No newline at end of file
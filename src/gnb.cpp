@@ -13,12 +13,16 @@
 #include <unistd.h>
 
 #include <gnb/gnb.hpp>
+#include <gnb/gtp/transport.hpp>
+#include <gnb/rls/transport.hpp>
 #include <lib/app/base_app.hpp>
 #include <lib/app/cli_base.hpp>
 #include <lib/app/cli_cmd.hpp>
 #include <lib/app/proc_table.hpp>
+#include <utils/common.hpp>
 #include <utils/constants.hpp>
 #include <utils/io.hpp>
+#include <utils/libc_error.hpp>
 #include <utils/options.hpp>
 #include <utils/yaml_utils.hpp>
 #include <yaml-cpp/yaml.h>
@@ -32,8 +36,17 @@ static struct Options
 {
     std::string configFile{};
     bool disableCmd{};
+    int count{};
+    int tacStep{};
 } g_options{};
 
+static std::string MakeGnbName(const nr::gnb::GnbConfig &config)
+{
+    // NOTE: Avoid using "/" dir separator character.
+    return "UERANSIM-gnb-" + std::to_string(config.plmn.mcc) + "-" + std::to_string(config.plmn.mnc) + "-" +
+           std::to_string(config.getGnbId());
+}
+
 static nr::gnb::GnbConfig *ReadConfigYaml()
 {
     auto *result = new nr::gnb::GnbConfig();
@@ -56,9 +69,46 @@ static nr::gnb::GnbConfig *ReadConfigYaml()
         result->gtpAdvertiseIp = yaml::GetIpAddress(config, "gtpAdvertiseIp");
 
     result->ignoreStreamIds = yaml::GetBool(config, "ignoreStreamIds");
+    result->downlinkCutThrough = !yaml::HasField(config, "downlinkCutThrough") ||
+                                 yaml::GetBool(config, "downlinkCutThrough");
+    result->ngapDecodeWorkers =
+        yaml::HasField(config, "ngapDecodeWorkers") ? yaml::GetInt32(config, "ngapDecodeWorkers", 0, 16) : 2;
+    result->signallingShards =
+        yaml::HasField(config, "signallingShards") ? yaml::GetInt32(config, "signallingShards", 1, 16) : 1;
+
+    if (yaml::HasField(config, "position"))
+    {
+        auto position = config["position"];
+        result->phyLocation.x = yaml::GetInt32(position, "x");
+        result->phyLocation.y = yaml::GetInt32(position, "y");
+        result->phyLocation.z = yaml::GetInt32(position, "z");
+    }
+
+    if (yaml::HasField(config, "pathLoss"))
+    {
+        auto pathLoss = config["pathLoss"];
+        std::string model = yaml::GetString(pathLoss, "model");
+        if (model == "distance")
+            result->pathLoss.model = nr::gnb::EPathLossModel::DISTANCE;
+        else if (model == "free-space")
+            result->pathLoss.model = nr::gnb::EPathLossModel::FREE_SPACE;
+        else if (model == "log-distance")
+            result->pathLoss.model = nr::gnb::EPathLossModel::LOG_DISTANCE;
+        else
+            throw std::runtime_error("Invalid path loss model: " + model);
+
+        if (yaml::HasField(pathLoss, "txPower"))
+            result->pathLoss.txPower = yaml::GetDouble(pathLoss, "txPower", -50.0, 80.0);
+        if (yaml::HasField(pathLoss, "frequency"))
+            result->pathLoss.frequency = yaml::GetDouble(pathLoss, "frequency", 1.0, 100'000.0);
+        if (yaml::HasField(pathLoss, "exponent"))
+            result->pathLoss.exponent = yaml::GetDouble(pathLoss, "exponent", 1.0, 8.0);
+        if (yaml::HasField(pathLoss, "referenceDistance"))
+            result->pathLoss.referenceDistance = yaml::GetDouble(pathLoss, "referenceDistance", 0.1, 10'000.0);
+    }
+
     result->pagingDrx = EPagingDrx::V128;
-    result->name = "UERANSIM-gnb-" + std::to_string(result->plmn.mcc) + "-" + std::to_string(result->plmn.mnc) + "-" +
-                   std::to_string(result->getGnbId()); // NOTE: Avoid using "/" dir separator character.
+    result->name = MakeGnbName(*result);
 
     for (auto &amfConfig : yaml::GetSequence(config, "amfConfigs"))
     {
@@ -95,9 +145,15 @@ static void ReadOptions(int argc, char **argv)
     opt::OptionItem itemConfigFile = {'c', "config", "Use specified configuration file for gNB", "config-file"};
     opt::OptionItem itemDisableCmd = {'l', "disable-cmd", "Disable command line functionality for this instance",
                                       std::nullopt};
+    opt::OptionItem itemCount = {'n', "num-of-gNB", "Generate specified number of gNBs starting from the given gNB ID",
+                                 "num"};
+    opt::OptionItem itemTacStep = {'t', "tac-step", "TAC increment between the generated gNBs, 0 by default",
+                                   "step"};
 
     desc.items.push_back(itemConfigFile);
     desc.items.push_back(itemDisableCmd);
+    desc.items.push_back(itemCount);
+    desc.items.push_back(itemTacStep);
 
     opt::OptionsResult opt{argc, argv, desc, false, nullptr};
 
@@ -107,7 +163,35 @@ static void ReadOptions(int argc, char **argv)
 
     try
     {
+        if (opt.hasFlag(itemCount))
+        {
+            g_options.count = utils::ParseInt(opt.getOption(itemCount));
+            if (g_options.count <= 0)
+                throw std::runtime_error("Invalid number of gNBs");
+            if (g_options.count > 512)
+                throw std::runtime_error("Number of gNBs is too big");
+        }
+        else
+        {
+            g_options.count = 1;
+        }
+
+        if (opt.hasFlag(itemTacStep))
+        {
+            g_options.tacStep = utils::ParseInt(opt.getOption(itemTacStep));
+            if (g_options.tacStep < 0)
+                throw std::runtime_error("Invalid TAC step");
+        }
+
         g_refConfig = ReadConfigYaml();
+
+        int64_t lastGnbId = static_cast<int64_t>(g_refConfig->getGnbId()) + g_options.count - 1;
+        if (lastGnbId >= (1LL << g_refConfig->gnbIdLength))
+            throw std::runtime_error("gNB ID range exceeds the gNB ID length");
+
+        int64_t lastTac = g_refConfig->tac + static_cast<int64_t>(g_options.tacStep) * (g_options.count - 1);
+        if (lastTac > 0xFFFFFF)
+            throw std::runtime_error("TAC range exceeds the maximum TAC value");
     }
     catch (const std::runtime_error &e)
     {
@@ -116,6 +200,18 @@ static void ReadOptions(int argc, char **argv)
     }
 }
 
+static nr::gnb::GnbConfig *GetConfigByGnb(int gnbIndex)
+{
+    if (gnbIndex == 0)
+        return g_refConfig;
+
+    auto *c = new nr::gnb::GnbConfig(*g_refConfig);
+    c->nci += static_cast<int64_t>(gnbIndex) << (36 - c->gnbIdLength);
+    c->tac += gnbIndex * g_options.tacStep;
+    c->name = MakeGnbName(*c);
+    return c;
+}
+
 static void ReceiveCommand(app::CliMessage &msg)
 {
     if (msg.value.empty())
@@ -157,6 +253,25 @@ static void ReceiveCommand(app::CliMessage &msg)
         return;
     }
 
+    if (app::IsNodeSelector(msg.nodeName))
+    {
+        std::vector<std::string> nodes{};
+        for (auto &item : g_gnbMap)
+            if (app::MatchesNodeSelector(msg.nodeName, item.first))
+                nodes.push_back(item.first);
+
+        if (nodes.empty())
+        {
+            g_cliServer->sendMessage(app::CliMessage::Error(msg.clientAddr, "No node matches: " + msg.nodeName));
+            return;
+        }
+
+        g_cliRespTask->push(std::make_unique<app::NwCliBulkBegin>(msg.clientAddr, nodes));
+        for (auto &node : nodes)
+            g_gnbMap[node]->pushCommand(std::make_unique<app::GnbCliCommand>(*cmd), msg.clientAddr);
+        return;
+    }
+
     if (g_gnbMap.count(msg.nodeName) == 0)
     {
         g_cliServer->sendMessage(app::CliMessage::Error(msg.clientAddr, "Node not found: " + msg.nodeName));
@@ -207,14 +322,35 @@ int main(int argc, char **argv)
 
     std::cout << cons::Name << std::endl;
 
+    // Sockets are shared by all gNBs of the process
+    auto *logBase = new LogBase("logs/nr-gnb.log");
+    nr::gnb::GtpTransport *gtpTransport;
+    nr::gnb::RlsTransport *rlsTransport;
+    try
+    {
+        gtpTransport = new nr::gnb::GtpTransport(g_refConfig->gtpIp, cons::GtpPort);
+        rlsTransport = new nr::gnb::RlsTransport(logBase, g_refConfig->linkIp, cons::RadioLinkPort);
+    }
+    catch (const LibError &e)
+    {
+        std::cerr << "ERROR: " << e.what() << std::endl;
+        return 1;
+    }
+
     if (!g_options.disableCmd)
     {
         g_cliServer = new app::CliServer{};
         g_cliRespTask = new app::CliResponseTask(g_cliServer);
     }
 
-    auto *gnb = new nr::gnb::GNodeB(g_refConfig, nullptr, g_cliRespTask);
-    g_gnbMap[g_refConfig->name] = gnb;
+    std::vector<nr::gnb::GNodeB *> gnbs{};
+    for (int i = 0; i < g_options.count; i++)
+    {
+        auto *config = GetConfigByGnb(i);
+        auto *gnb = new nr::gnb::GNodeB(config, nullptr, g_cliRespTask, gtpTransport, rlsTransport);
+        g_gnbMap[config->name] = gnb;
+        gnbs.push_back(gnb);
+    }
 
     if (!g_options.disableCmd)
     {
@@ -222,7 +358,11 @@ int main(int argc, char **argv)
         g_cliRespTask->start();
     }
 
-    gnb->start();
+    for (auto *gnb : gnbs)
+        gnb->start();
+
+    gtpTransport->start();
+    rlsTransport->start();
 
     while (true)
         Loop();
@@ -8,96 +8,30 @@
 
 #include "cmd_handler.hpp"
 
+#include <memory>
+#include <optional>
+#include <vector>
+
 #include <gnb/app/task.hpp>
-#include <gnb/gtp/task.hpp>
 #include <gnb/ngap/task.hpp>
-#include <gnb/rls/task.hpp>
-#include <gnb/rrc/task.hpp>
-#include <gnb/sctp/task.hpp>
-#include <utils/common.hpp>
 #include <utils/printer.hpp>
 
-#define PAUSE_CONFIRM_TIMEOUT 3000
-#define PAUSE_POLLING 10
-
 namespace nr::gnb
 {
 
 void GnbCmdHandler::sendResult(const InetAddress &address, const std::string &output)
 {
-    m_base->cliCallbackTask->push(std::make_unique<app::NwCliSendResponse>(address, output, false));
+    m_base->cliCallbackTask->push(
+        std::make_unique<app::NwCliSendResponse>(address, output, false, m_base->config->name));
 }
 
 void GnbCmdHandler::sendError(const InetAddress &address, const std::string &output)
 {
-    m_base->cliCallbackTask->push(std::make_unique<app::NwCliSendResponse>(address, output, true));
-}
-
-void GnbCmdHandler::pauseTasks()
-{
-    m_base->gtpTask->requestPause();
-    m_base->rlsTask->requestPause();
-    m_base->ngapTask->requestPause();
-    m_base->rrcTask->requestPause();
-    m_base->sctpTask->requestPause();
-}
-
-void GnbCmdHandler::unpauseTasks()
-{
-    m_base->gtpTask->requestUnpause();
-    m_base->rlsTask->requestUnpause();
-    m_base->ngapTask->requestUnpause();
-    m_base->rrcTask->requestUnpause();
-    m_base->sctpTask->requestUnpause();
-}
-
-bool GnbCmdHandler::isAllPaused()
-{
-    if (!m_base->gtpTask->isPauseConfirmed())
-        return false;
-    if (!m_base->rlsTask->isPauseConfirmed())
-        return false;
-    if (!m_base->ngapTask->isPauseConfirmed())
-        return false;
-    if (!m_base->rrcTask->isPauseConfirmed())
-        return false;
-    if (!m_base->sctpTask->isPauseConfirmed())
-        return false;
-    return true;
+    m_base->cliCallbackTask->push(
+        std::make_unique<app::NwCliSendResponse>(address, output, true, m_base->config->name));
 }
 
 void GnbCmdHandler::handleCmd(NmGnbCliCommand &msg)
-{
-    pauseTasks();
-
-    uint64_t currentTime = utils::CurrentTimeMillis();
-    uint64_t endTime = currentTime + PAUSE_CONFIRM_TIMEOUT;
-
-    bool isPaused = false;
-    while (currentTime < endTime)
-    {
-        currentTime = utils::CurrentTimeMillis();
-        if (isAllPaused())
-        {
-            isPaused = true;
-            break;
-        }
-        utils::Sleep(PAUSE_POLLING);
-    }
-
-    if (!isPaused)
-    {
-        sendError(msg.address, "gNB is unable process command due to pausing timeout");
-    }
-    else
-    {
-        handleCmdImpl(msg);
-    }
-
-    unpauseTasks();
-}
-
-void GnbCmdHandler::handleCmdImpl(NmGnbCliCommand &msg)
 {
     switch (msg.cmd->present)
     {
@@ -111,49 +45,82 @@ void GnbCmdHandler::handleCmdImpl(NmGnbCliCommand &msg)
     }
     case app::GnbCliCommand::AMF_LIST: {
         Json json = Json::Arr({});
-        for (auto &amf : m_base->ngapTask->m_amfCtx)
-            json.push(Json::Obj({{"id", amf.first}}));
+        m_base->ngapStatus[0]->access([&json](auto &status) {
+            for (auto &amf : status.amfs)
+                json.push(Json::Obj({{"id", amf.first}}));
+        });
         sendResult(msg.address, json.dumpYaml());
         break;
     }
     case app::GnbCliCommand::AMF_INFO: {
-        if (m_base->ngapTask->m_amfCtx.count(msg.cmd->amfId) == 0)
+        std::optional<Json> json{};
+        m_base->ngapStatus[0]->access([&json, &msg](auto &status) {
+            if (status.amfs.count(msg.cmd->amfId))
+                json = status.amfs.at(msg.cmd->amfId);
+        });
+        if (!json.has_value())
             sendError(msg.address, "AMF not found with given ID");
         else
-        {
-            auto amf = m_base->ngapTask->m_amfCtx[msg.cmd->amfId];
-            sendResult(msg.address, ToJson(*amf).dumpYaml());
-        }
+            sendResult(msg.address, json->dumpYaml());
         break;
     }
     case app::GnbCliCommand::UE_LIST: {
-        Json json = Json::Arr({});
-        for (auto &ue : m_base->ngapTask->m_ueCtx)
+        // The versions are taken first so that the formatting below works on immutable copies
+        std::vector<std::shared_ptr<const NgapStatus>> statuses{};
+        statuses.reserve(m_base->ngapStatus.size());
+        for (auto &ngapStatus : m_base->ngapStatus)
+            statuses.push_back(ngapStatus->get());
+
+        YamlSequenceWriter writer{};
+        for (auto &status : statuses)
         {
-            json.push(Json::Obj({
-                {"ue-id", ue.first},
-                {"ran-ngap-id", ue.second->ranUeNgapId},
-                {"amf-ngap-id", ue.second->amfUeNgapId},
-            }));
+            for (auto &ue : status->ues)
+            {
+                writer.beginItem();
+                writer.field("ue-id", ue.ueId);
+                writer.field("ran-ngap-id", ue.ranUeNgapId);
+                writer.field("amf-ngap-id", ue.amfUeNgapId);
+            }
         }
-        sendResult(msg.address, json.dumpYaml());
+        sendResult(msg.address, writer.take());
         break;
     }
     case app::GnbCliCommand::UE_COUNT: {
-        sendResult(msg.address, std::to_string(m_base->ngapTask->m_ueCtx.size()));
+        size_t count = 0;
+        for (auto &ngapStatus : m_base->ngapStatus)
+            count += ngapStatus->get<size_t>([](auto &status) { return status.ues.size(); });
+        sendResult(msg.address, std::to_string(count));
         break;
     }
     case app::GnbCliCommand::UE_RELEASE_REQ: {
-        if (m_base->ngapTask->m_ueCtx.count(msg.cmd->ueId) == 0)
+        int ueId = msg.cmd->ueId;
+        bool found = false;
+        for (auto &ngapStatus : m_base->ngapStatus)
+        {
+            ngapStatus->access([&found, ueId](auto &status) {
+                for (auto &ue : status.ues)
+                    found |= ue.ueId == ueId;
+            });
+        }
+        if (!found)
             sendError(msg.address, "UE not found with given ID");
         else
         {
-            auto ue = m_base->ngapTask->m_ueCtx[msg.cmd->ueId];
-            m_base->ngapTask->sendContextRelease(ue->ctxId, NgapCause::RadioNetwork_unspecified);
+            auto w = std::make_unique<NmGnbAppToNgap>(NmGnbAppToNgap::UE_RELEASE_REQUEST);
+            w->ueId = ueId;
+            m_base->ngapTaskOf(ueId)->push(std::move(w));
             sendResult(msg.address, "Requesting UE context release");
         }
         break;
     }
+    case app::GnbCliCommand::GTP_PATHS: {
+        sendResult(msg.address, m_base->gtpStatus.get()->paths.dumpYaml());
+        break;
+    }
+    case app::GnbCliCommand::QOS_MONITORING: {
+        sendResult(msg.address, m_base->gtpStatus.get()->qosMonitoring.dumpYaml());
+        break;
+    }
     }
 }
 
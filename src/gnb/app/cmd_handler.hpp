@@ -26,14 +26,6 @@ class GnbCmdHandler
 
     void handleCmd(NmGnbCliCommand &msg);
 
-  private:
-    void pauseTasks();
-    void unpauseTasks();
-    bool isAllPaused();
-
-  private:
-    void handleCmdImpl(NmGnbCliCommand &msg);
-
   private:
     void sendResult(const InetAddress &address, const std::string &output);
     void sendError(const InetAddress &address, const std::string &output);
@@ -11,6 +11,7 @@
 #include "gtp/task.hpp"
 #include "ngap/task.hpp"
 #include "rls/task.hpp"
+#include "rls/ue_table.hpp"
 #include "rrc/task.hpp"
 #include "sctp/task.hpp"
 
@@ -19,18 +20,28 @@
 namespace nr::gnb
 {
 
-GNodeB::GNodeB(GnbConfig *config, app::INodeListener *nodeListener, NtsTask *cliCallbackTask)
+GNodeB::GNodeB(GnbConfig *config, app::INodeListener *nodeListener, NtsTask *cliCallbackTask,
+               GtpTransport *gtpTransport, RlsTransport *rlsTransport)
 {
     auto *base = new TaskBase();
     base->config = config;
     base->logBase = new LogBase("logs/" + config->name + ".log");
     base->nodeListener = nodeListener;
     base->cliCallbackTask = cliCallbackTask;
+    base->gtpTransport = gtpTransport;
+    base->rlsTransport = rlsTransport;
+    base->rlsUeTable = new RlsUeTable();
 
     base->appTask = new GnbAppTask(base);
     base->sctpTask = new SctpTask(base);
-    base->ngapTask = new NgapTask(base);
-    base->rrcTask = new GnbRrcTask(base);
+    for (int i = 0; i < config->signallingShards; i++)
+    {
+        base->ngapShards.push_back(new NgapTask(base, i));
+        base->ngapStatus.push_back(std::make_unique<Snapshot<NgapStatus>>());
+        base->rrcShards.push_back(new GnbRrcTask(base, i));
+    }
+    base->ngapTask = base->ngapShards[0];
+    base->rrcTask = base->rrcShards[0];
     base->gtpTask = new GtpTask(base);
     base->rlsTask = new GnbRlsTask(base);
 
@@ -41,18 +52,23 @@ GNodeB::~GNodeB()
 {
     taskBase->appTask->quit();
     taskBase->sctpTask->quit();
-    taskBase->ngapTask->quit();
-    taskBase->rrcTask->quit();
+    for (auto *task : taskBase->ngapShards)
+        task->quit();
+    for (auto *task : taskBase->rrcShards)
+        task->quit();
     taskBase->gtpTask->quit();
     taskBase->rlsTask->quit();
 
     delete taskBase->appTask;
     delete taskBase->sctpTask;
-    delete taskBase->ngapTask;
-    delete taskBase->rrcTask;
+    for (auto *task : taskBase->ngapShards)
+        delete task;
+    for (auto *task : taskBase->rrcShards)
+        delete task;
     delete taskBase->gtpTask;
     delete taskBase->rlsTask;
 
+    delete taskBase->rlsUeTable;
     delete taskBase->logBase;
 
     delete taskBase;
@@ -62,8 +78,10 @@ void GNodeB::start()
 {
     taskBase->appTask->start();
     taskBase->sctpTask->start();
-    taskBase->ngapTask->start();
-    taskBase->rrcTask->start();
+    for (auto *task : taskBase->ngapShards)
+        task->start();
+    for (auto *task : taskBase->rrcShards)
+        task->start();
     taskBase->rlsTask->start();
     taskBase->gtpTask->start();
 }
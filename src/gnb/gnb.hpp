@@ -25,7 +25,8 @@ class GNodeB
     TaskBase *taskBase;
 
   public:
-    GNodeB(GnbConfig *config, app::INodeListener *nodeListener, NtsTask *cliCallbackTask);
+    GNodeB(GnbConfig *config, app::INodeListener *nodeListener, NtsTask *cliCallbackTask, GtpTransport *gtpTransport,
+           RlsTransport *rlsTransport);
     virtual ~GNodeB();
 
   public:
@@ -59,6 +59,7 @@ static bool EncodeExtensionHeader(const GtpExtHeader &header, OctetString &strea
 
 bool EncodeGtpMessage(const GtpMessage &gtp, OctetString &stream)
 {
+    stream.reserveEncodeBuffer();
     int initialLength = stream.length();
 
     bool pn = gtp.nPduNum.has_value();
@@ -199,25 +200,31 @@ std::unique_ptr<GtpMessage> DecodeGtpMessage(const OctetView &stream)
             while (nextExtHeaderType != 0)
             {
                 int len = stream.readI(); // NOTE: len is actually 4 times length
+                if (len == 0)
+                    return nullptr;
+
+                // The contents are decoded from a separate view, so that the next extension header is found even if
+                // the contents are not entirely consumed
+                OctetView contents = stream.readView(4 * len - 2);
 
                 std::unique_ptr<GtpExtHeader> header = nullptr;
 
                 switch (nextExtHeaderType)
                 {
                 case 0b01000000:
-                    header = DecodeUdpPortExtHeader(len, stream);
+                    header = DecodeUdpPortExtHeader(len, contents);
                     break;
                 case 0b10000010:
-                    header = DecodeLongPdcpPduNumberExtHeader(len, stream);
+                    header = DecodeLongPdcpPduNumberExtHeader(len, contents);
                     break;
                 case 0b10000100:
-                    header = DecodeNrRanContainerExtHeader(len, stream);
+                    header = DecodeNrRanContainerExtHeader(len, contents);
                     break;
                 case 0b10000101:
-                    header = DecodePduSessionContainerExtHeader(len, stream);
+                    header = DecodePduSessionContainerExtHeader(len, contents);
                     break;
                 case 0b11000000:
-                    header = DecodePdcpPduNumberExtHeader(len, stream);
+                    header = DecodePdcpPduNumberExtHeader(len, contents);
                     break;
                 case 0b10000001: // Not used in gNB
                 case 0b10000011: // Not used in gNB
@@ -235,10 +242,12 @@ std::unique_ptr<GtpMessage> DecodeGtpMessage(const OctetView &stream)
         }
     }
 
-    size_t read = stream.currentIndex() - fistIndex;
-    size_t rem = gtpLen - (read - 8);
-    res->payload = stream.readOctetString(rem);
+    int read = static_cast<int>(stream.currentIndex() - fistIndex);
+    res->payload = stream.readOctetString(gtpLen - (read - 8));
 
+    // Truncated or inconsistent packets are dropped
+    if (stream.hasError())
+        return nullptr;
     return res;
 }
 
@@ -297,7 +306,7 @@ std::unique_ptr<PduSessionInformation> PduSessionInformation::Decode(const Octet
         res->qmp = bits::BitAt<3>(octet);
 
         octet = stream.read();
-        res->qfi = bits::BitRange8<5, 7>(octet);
+        res->qfi = bits::BitRange8<0, 5>(octet);
 
         if (res->qmp)
         {
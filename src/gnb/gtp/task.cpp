@@ -8,49 +8,63 @@
 
 #include "task.hpp"
 
+#include <algorithm>
+#include <unordered_set>
+
 #include <gnb/gtp/proto.hpp>
+#include <gnb/gtp/transport.hpp>
+#include <gnb/ngap/task.hpp>
 #include <gnb/rls/task.hpp>
+#include <gnb/rls/transport.hpp>
+#include <gnb/rls/ue_table.hpp>
+#include <utils/common.hpp>
 #include <utils/constants.hpp>
-#include <utils/libc_error.hpp>
 
 #include <asn/ngap/ASN_NGAP_QosFlowSetupRequestItem.h>
 
+static constexpr const int TIMER_ID_ECHO = 1;
+static constexpr const int TIMER_PERIOD_ECHO = 5000;
+static constexpr const int TIMER_ID_STATUS = 2;
+static constexpr const int TIMER_PERIOD_STATUS = 1000;
+
+// The path is considered down after this many consecutive echo requests are left unanswered, see 3GPP 29.281 7.2.1
+static constexpr const int MAX_MISSED_ECHOES = 3;
+
 namespace nr::gnb
 {
 
 GtpTask::GtpTask(TaskBase *base)
-    : m_base{base}, m_udpServer{}, m_ueContexts{}, m_rateLimiter(std::make_unique<RateLimiter>()), m_pduSessions{},
-      m_sessionTree{}
+    : m_base{base}, m_ueContexts{}, m_rateLimiter(std::make_unique<RateLimiter>()), m_pduSessions{},
+      m_sessionTree{}, m_paths{}, m_qosMonitors{}, m_uplinkBatch{}, m_downlinkBatch{}
 {
     m_logger = m_base->logBase->makeUniqueLogger("gtp");
 }
 
 void GtpTask::onStart()
 {
-    try
-    {
-        m_udpServer = new udp::UdpServerTask(m_base->config->gtpIp, cons::GtpPort, this);
-        m_udpServer->start();
-    }
-    catch (const LibError &e)
-    {
-        m_logger->err("GTP/UDP task could not be created. %s", e.what());
-    }
+    m_base->gtpTransport->addTask(this);
+
+    setTimer(TIMER_ID_ECHO, TIMER_PERIOD_ECHO);
+    setTimer(TIMER_ID_STATUS, TIMER_PERIOD_STATUS);
 }
 
 void GtpTask::onQuit()
 {
-    m_udpServer->quit();
-    delete m_udpServer;
+    m_base->gtpTransport->removeTask(this);
 
     m_ueContexts.clear();
+    m_paths.clear();
 }
 
 void GtpTask::onLoop()
 {
-    auto msg = take();
+    // Outgoing datagrams are collected into batches as long as more messages are waiting in the queue
+    auto msg = m_uplinkBatch.isEmpty() && m_downlinkBatch.isEmpty() ? take() : poll();
     if (!msg)
+    {
+        flushBatches();
         return;
+    }
 
     switch (msg->msgType)
     {
@@ -82,7 +96,7 @@ void GtpTask::onLoop()
         switch (w.present)
         {
         case NmGnbRlsToGtp::DATA_PDU_DELIVERY: {
-            handleUplinkData(w.ueId, w.psi, std::move(w.pdu));
+            handleUplinkData(w.ueId, w.psi, std::move(w.pdu), w.receiveTime);
             break;
         }
         }
@@ -91,12 +105,45 @@ void GtpTask::onLoop()
     case NtsMessageType::UDP_SERVER_RECEIVE:
         handleUdpReceive(dynamic_cast<udp::NwUdpServerReceive &>(*msg));
         break;
+    case NtsMessageType::TIMER_EXPIRED: {
+        auto &w = dynamic_cast<NmTimerExpired &>(*msg);
+        if (w.timerId == TIMER_ID_ECHO)
+        {
+            setTimer(TIMER_ID_ECHO, TIMER_PERIOD_ECHO);
+            onEchoTimerExpired();
+        }
+        else if (w.timerId == TIMER_ID_STATUS)
+        {
+            setTimer(TIMER_ID_STATUS, TIMER_PERIOD_STATUS);
+            publishStatus();
+        }
+        break;
+    }
     default:
         m_logger->unhandledNts(*msg);
         break;
     }
 }
 
+void GtpTask::publishStatus()
+{
+    GtpStatus status{};
+    for (auto &path : m_paths)
+        status.paths.push(ToJson(*path.second));
+    for (auto &session : m_qosMonitors)
+        for (auto &flow : session.second)
+            status.qosMonitoring.push(ToJson(flow.second));
+
+    if (!(*m_base->gtpStatus.get() == status))
+        m_base->gtpStatus.set(std::move(status));
+}
+
+void GtpTask::flushBatches()
+{
+    m_base->gtpTransport->flush(m_uplinkBatch);
+    m_base->rlsTransport->flush(m_downlinkBatch);
+}
+
 void GtpTask::handleUeContextUpdate(const GtpUeContextUpdate &msg)
 {
     if (!m_ueContexts.count(msg.ueId))
@@ -120,6 +167,7 @@ void GtpTask::handleSessionCreate(PduSessionResource *session)
     m_pduSessions[sessionInd] = std::unique_ptr<PduSessionResource>(session);
 
     m_sessionTree.insert(sessionInd, session->downTunnel.teid);
+    m_base->gtpTransport->bindTeid(session->downTunnel.teid, this);
 
     updateAmbrForUe(session->ueId);
     updateAmbrForSession(sessionInd);
@@ -134,6 +182,7 @@ void GtpTask::handleSessionRelease(int ueId, int psi)
     }
 
     uint64_t sessionInd = MakeSessionResInd(ueId, psi);
+    m_qosMonitors.erase(sessionInd);
 
     // Remove all session information from rate limiter
     m_rateLimiter->updateSessionUplinkLimit(sessionInd, 0);
@@ -147,6 +196,7 @@ void GtpTask::handleSessionRelease(int ueId, int psi)
 
         // And remove from the tree
         m_sessionTree.remove(sessionInd, teid);
+        m_base->gtpTransport->unbindTeid(teid);
     }
 }
 
@@ -168,17 +218,27 @@ void GtpTask::handleUeContextDelete(int ueId)
 
         // And remove from the tree
         m_sessionTree.remove(session, teid);
+        m_base->gtpTransport->unbindTeid(teid);
     }
 
     // Remove all user information from rate limiter
     m_rateLimiter->updateUeUplinkLimit(ueId, 0);
     m_rateLimiter->updateUeDownlinkLimit(ueId, 0);
 
+    // Remove QoS monitoring state of the UE
+    for (auto it = m_qosMonitors.begin(); it != m_qosMonitors.end();)
+    {
+        if (GetUeId(it->first) == ueId)
+            it = m_qosMonitors.erase(it);
+        else
+            ++it;
+    }
+
     // Remove UE context
     m_ueContexts.erase(ueId);
 }
 
-void GtpTask::handleUplinkData(int ueId, int psi, OctetString &&pdu)
+void GtpTask::handleUplinkData(int ueId, int psi, OctetString &&pdu, int64_t receiveTime)
 {
     const uint8_t *data = pdu.data();
 
@@ -204,8 +264,9 @@ void GtpTask::handleUplinkData(int ueId, int psi, OctetString &&pdu)
         gtp.teid = pduSession->upTunnel.teid;
 
         auto ul = std::make_unique<gtp::UlPduSessionInformation>();
-        // TODO: currently using first QSI
+        // The uplink packets are not mapped to the QoS flows, so the first flow is used unless a report is pending
         ul->qfi = static_cast<int>(pduSession->qosFlows->list.array[0]->qosFlowIdentifier);
+        stampQosMonitoring(sessionInd, *ul, receiveTime);
 
         auto cont = std::make_unique<gtp::PduSessionContainerExtHeader>();
         cont->pduSessionInformation = std::move(ul);
@@ -215,14 +276,38 @@ void GtpTask::handleUplinkData(int ueId, int psi, OctetString &&pdu)
         if (!gtp::EncodeGtpMessage(gtp, gtpPdu))
             m_logger->err("Uplink data failure, GTP encoding failed");
         else
-            m_udpServer->send(InetAddress(pduSession->upTunnel.address, cons::GtpPort), gtpPdu);
+            m_base->gtpTransport->send(InetAddress(pduSession->upTunnel.address, cons::GtpPort), gtpPdu,
+                                       m_uplinkBatch);
     }
 }
 
+bool GtpTask::sendDownlinkDirect(int ueId, int psi, OctetString &data)
+{
+    // Data PDUs need no state in the RLS tasks, hence they are sent to the UE from here instead of passing through them
+    uint64_t cellSti{};
+    RlsUeTable::Link link{};
+    if (!m_base->rlsUeTable->find(ueId, cellSti, link))
+        return false;
+
+    rls::RlsPduTransmission msg{cellSti};
+    msg.pduType = rls::EPduType::DATA;
+    msg.pdu = std::move(data);
+    msg.payload = static_cast<uint32_t>(psi);
+    msg.pduId = 0;
+
+    m_base->rlsTransport->send(link.address, msg, link.sti, m_downlinkBatch);
+    return true;
+}
+
 void GtpTask::handleUdpReceive(const udp::NwUdpServerReceive &msg)
 {
     OctetView buffer{msg.packet};
     auto gtp = gtp::DecodeGtpMessage(buffer);
+    if (gtp == nullptr)
+    {
+        m_logger->err("Unable to decode GTP-U message");
+        return;
+    }
 
     switch (gtp->msgType)
     {
@@ -236,11 +321,24 @@ void GtpTask::handleUdpReceive(const udp::NwUdpServerReceive &msg)
 
         if (m_rateLimiter->allowDownlinkPacket(sessionInd, gtp->payload.length()))
         {
-            auto w = std::make_unique<NmGnbGtpToRls>(NmGnbGtpToRls::DATA_PDU_DELIVERY);
-            w->ueId = GetUeId(sessionInd);
-            w->psi = GetPsi(sessionInd);
-            w->pdu = std::move(gtp->payload);
-            m_base->rlsTask->push(std::move(w));
+            auto *monitor = receiveQosMonitoring(sessionInd, *gtp);
+
+            if (!m_base->config->downlinkCutThrough ||
+                !sendDownlinkDirect(GetUeId(sessionInd), GetPsi(sessionInd), gtp->payload))
+            {
+                auto w = std::make_unique<NmGnbGtpToRls>(NmGnbGtpToRls::DATA_PDU_DELIVERY);
+                w->ueId = GetUeId(sessionInd);
+                w->psi = GetPsi(sessionInd);
+                w->pdu = std::move(gtp->payload);
+                m_base->rlsTask->push(std::move(w));
+            }
+
+            if (monitor != nullptr)
+            {
+                int64_t delay = utils::CurrentTimeMicros() - monitor->dlReceiveTime;
+                monitor->dlRanDelay = delay;
+                monitor->ranDownlink.add(delay);
+            }
         }
         return;
     }
@@ -252,11 +350,15 @@ void GtpTask::handleUdpReceive(const udp::NwUdpServerReceive &msg)
 
         OctetString gtpPdu;
         if (gtp::EncodeGtpMessage(gtpResponse, gtpPdu))
-            m_udpServer->send(msg.fromAddress, gtpPdu);
+            m_base->gtpTransport->send(msg.fromAddress, gtpPdu);
         else
             m_logger->err("Uplink data failure, GTP encoding failed");
         return;
     }
+    case gtp::GtpMessage::MT_ECHO_RESPONSE: {
+        handleEchoResponse(*gtp);
+        return;
+    }
     default: {
         m_logger->err("Unhandled GTP-U message type: %d", gtp->msgType);
         return;
@@ -264,6 +366,174 @@ void GtpTask::handleUdpReceive(const udp::NwUdpServerReceive &msg)
     }
 }
 
+static gtp::DlPduSessionInformation *FindDlSessionInformation(gtp::GtpMessage &gtp)
+{
+    for (auto &header : gtp.extHeaders)
+    {
+        if (header->type != gtp::ExtHeaderType::PduSessionContainerExtHeader)
+            continue;
+
+        auto &info = dynamic_cast<gtp::PduSessionContainerExtHeader &>(*header).pduSessionInformation;
+        if (info != nullptr && info->pduType == gtp::PduSessionInformation::PDU_TYPE_DL)
+            return dynamic_cast<gtp::DlPduSessionInformation *>(info.get());
+    }
+    return nullptr;
+}
+
+QosFlowMonitor *GtpTask::receiveQosMonitoring(uint64_t sessionInd, gtp::GtpMessage &gtp)
+{
+    auto *info = FindDlSessionInformation(gtp);
+    if (info == nullptr || !info->qmp || !info->dlSendingTs.has_value())
+        return nullptr;
+
+    int64_t now = utils::CurrentTimeMicros();
+
+    auto &flows = m_qosMonitors[sessionInd];
+    auto &monitor = flows.try_emplace(info->qfi, GetUeId(sessionInd), GetPsi(sessionInd), info->qfi).first->second;
+    monitor.dlSendingTs = info->dlSendingTs;
+    monitor.dlReceiveTime = now;
+    monitor.dlRanDelay = std::nullopt;
+
+    // Meaningful only if the clocks of the UPF and the gNB are synchronised
+    monitor.n3Downlink.add(now - NtpTimeToMicros(*info->dlSendingTs));
+    return &monitor;
+}
+
+void GtpTask::stampQosMonitoring(uint64_t sessionInd, gtp::UlPduSessionInformation &ul, int64_t receiveTime)
+{
+    auto it = m_qosMonitors.find(sessionInd);
+    if (it == m_qosMonitors.end())
+        return;
+
+    // The report is carried by the next uplink packet of the session in the QoS flow of the downlink packet
+    auto flow = std::find_if(it->second.begin(), it->second.end(),
+                             [](auto &item) { return item.second.dlSendingTs.has_value(); });
+    if (flow == it->second.end())
+        return;
+
+    auto &monitor = flow->second;
+    int64_t now = utils::CurrentTimeMicros();
+
+    ul.qfi = monitor.qfi;
+    ul.qmp = true;
+    ul.dlSendingTsRepeated = monitor.dlSendingTs;
+    ul.dlReceivedTs = MicrosToNtpTime(monitor.dlReceiveTime);
+    ul.ulSendingTs = MicrosToNtpTime(now);
+
+    // Delay results are in units of 0.1 ms, see 38.415 5.5.3.14
+    if (monitor.dlRanDelay.has_value())
+        ul.dlDelayResult = static_cast<uint32_t>(*monitor.dlRanDelay / 100);
+    if (receiveTime > 0)
+    {
+        ul.ulDelayResult = static_cast<uint32_t>((now - receiveTime) / 100);
+        monitor.ranUplink.add(now - receiveTime);
+    }
+
+    // The timestamps of a downlink packet are reported only once
+    monitor.dlSendingTs = std::nullopt;
+}
+
+void GtpTask::handleEchoResponse(const gtp::GtpMessage &msg)
+{
+    if (!msg.seq.has_value())
+        return;
+
+    for (auto &item : m_paths)
+    {
+        auto &path = *item.second;
+        if (path.pendingSeq != msg.seq)
+            continue;
+
+        path.onEchoResponse(utils::CurrentTimeMicros() - path.pendingSince);
+
+        if (path.failed)
+        {
+            path.failed = false;
+            m_logger->info("GTP-U path to [%s] is restored", path.name.c_str());
+        }
+        return;
+    }
+}
+
+void GtpTask::onEchoTimerExpired()
+{
+    // Paths are monitored as long as there is a PDU session using them
+    std::unordered_set<std::string> addresses{};
+    for (auto &session : m_pduSessions)
+    {
+        auto &tunnel = session.second->upTunnel;
+        auto name = utils::OctetStringToIp(tunnel.address);
+        if (m_paths.count(name) == 0)
+            m_paths[name] = std::make_unique<GtpPath>(name, InetAddress(tunnel.address, cons::GtpPort));
+        addresses.insert(name);
+    }
+
+    for (auto it = m_paths.begin(); it != m_paths.end();)
+    {
+        auto &path = *it->second;
+
+        // Responses arriving after the next request are no longer taken into account
+        if (path.pendingSeq.has_value())
+        {
+            m_base->gtpTransport->unbindEchoRequest(*path.pendingSeq);
+            path.onEchoLost();
+
+            if (!path.failed && path.missedEchoes >= MAX_MISSED_ECHOES)
+                declarePathFailure(path);
+        }
+
+        if (addresses.count(it->first) == 0)
+        {
+            it = m_paths.erase(it);
+            continue;
+        }
+
+        sendEchoRequest(path);
+        ++it;
+    }
+}
+
+void GtpTask::sendEchoRequest(GtpPath &path)
+{
+    gtp::GtpMessage gtp{};
+    gtp.msgType = gtp::GtpMessage::MT_ECHO_REQUEST;
+    gtp.seq = m_base->gtpTransport->bindEchoRequest(this);
+
+    OctetString gtpPdu;
+    if (!gtp::EncodeGtpMessage(gtp, gtpPdu))
+    {
+        m_base->gtpTransport->unbindEchoRequest(*gtp.seq);
+        m_logger->err("Echo request failure, GTP encoding failed");
+        return;
+    }
+
+    path.pendingSeq = gtp.seq;
+    path.pendingSince = utils::CurrentTimeMicros();
+    path.echoesSent++;
+
+    m_base->gtpTransport->send(path.address, gtpPdu);
+}
+
+void GtpTask::declarePathFailure(GtpPath &path)
+{
+    path.failed = true;
+    m_logger->err("GTP-U path to [%s] has failed, no echo response for %d requests", path.name.c_str(),
+                  path.missedEchoes);
+
+    // The user plane of the UEs using this path is lost, hence the AMF is requested to release them
+    std::unordered_set<int> ueIds{};
+    for (auto &session : m_pduSessions)
+        if (utils::OctetStringToIp(session.second->upTunnel.address) == path.name)
+            ueIds.insert(session.second->ueId);
+
+    for (int ueId : ueIds)
+    {
+        auto w = std::make_unique<NmGnbGtpToNgap>(NmGnbGtpToNgap::PATH_FAILURE);
+        w->ueId = ueId;
+        m_base->ngapTaskOf(ueId)->push(std::move(w));
+    }
+}
+
 void GtpTask::updateAmbrForUe(int ueId)
 {
     if (!m_ueContexts.count(ueId))
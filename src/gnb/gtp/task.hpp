@@ -10,12 +10,15 @@
 
 #include "utils.hpp"
 
+#include <map>
 #include <memory>
 #include <thread>
 #include <unordered_map>
 #include <vector>
 
+#include <gnb/gtp/proto.hpp>
 #include <gnb/nts.hpp>
+#include <lib/udp/batch.hpp>
 #include <lib/udp/server_task.hpp>
 #include <utils/logger.hpp>
 #include <utils/nts.hpp>
@@ -29,13 +32,14 @@ class GtpTask : public NtsTask
     TaskBase *m_base;
     std::unique_ptr<Logger> m_logger;
 
-    udp::UdpServerTask *m_udpServer;
     std::unordered_map<int, std::unique_ptr<GtpUeContext>> m_ueContexts;
     std::unique_ptr<IRateLimiter> m_rateLimiter;
     std::unordered_map<uint64_t, std::unique_ptr<PduSessionResource>> m_pduSessions;
     PduSessionTree m_sessionTree;
-
-    friend class GnbCmdHandler;
+    std::unordered_map<std::string, std::unique_ptr<GtpPath>> m_paths;
+    std::unordered_map<uint64_t, std::map<int, QosFlowMonitor>> m_qosMonitors;
+    udp::DatagramBatch m_uplinkBatch;
+    udp::DatagramBatch m_downlinkBatch;
 
   public:
     explicit GtpTask(TaskBase *base);
@@ -47,12 +51,21 @@ class GtpTask : public NtsTask
     void onQuit() override;
 
   private:
+    void publishStatus();
+    void flushBatches();
     void handleUdpReceive(const udp::NwUdpServerReceive &msg);
     void handleUeContextUpdate(const GtpUeContextUpdate &msg);
     void handleSessionCreate(PduSessionResource *session);
     void handleSessionRelease(int ueId, int psi);
     void handleUeContextDelete(int ueId);
-    void handleUplinkData(int ueId, int psi, OctetString &&data);
+    void handleUplinkData(int ueId, int psi, OctetString &&data, int64_t receiveTime);
+    bool sendDownlinkDirect(int ueId, int psi, OctetString &data);
+    QosFlowMonitor *receiveQosMonitoring(uint64_t sessionInd, gtp::GtpMessage &gtp);
+    void stampQosMonitoring(uint64_t sessionInd, gtp::UlPduSessionInformation &ul, int64_t receiveTime);
+    void handleEchoResponse(const gtp::GtpMessage &msg);
+    void onEchoTimerExpired();
+    void sendEchoRequest(GtpPath &path);
+    void declarePathFailure(GtpPath &path);
 
     void updateAmbrForUe(int ueId);
     void updateAmbrForSession(uint64_t pduSession);
@@ -0,0 +1,180 @@
+//
+// This file is a part of UERANSIM project.
+// Copyright (c) 2023 ALİ GÜNGÖR.
+//
+// https://github.com/aligungr/UERANSIM/
+// See README, LICENSE, and CONTRIBUTING files for licensing details.
+//
+
+#include "transport.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#include <gnb/gtp/proto.hpp>
+#include <lib/udp/server_task.hpp>
+
+static constexpr const int BUFFER_SIZE = 65536;
+static constexpr const int RECEIVE_TIMEOUT = 500;
+
+// Flags, message type, length and TEID
+static constexpr const int MIN_HEADER_LENGTH = 8;
+// Followed by the sequence number, N-PDU number and next extension header type
+static constexpr const int OPTIONAL_HEADER_LENGTH = 12;
+
+namespace nr::gnb
+{
+
+GtpTransport::GtpTransport(const std::string &address, uint16_t port)
+    : m_server{}, m_teidCounter{}, m_mutex{}, m_tasks{}, m_teidMap{}, m_echoSeqCounter{}, m_echoMap{}
+{
+    m_server = new udp::UdpServer(address, port);
+    m_server->EnableReceiveOffload();
+}
+
+void GtpTransport::onStart()
+{
+}
+
+void GtpTransport::onLoop()
+{
+    uint8_t buffer[BUFFER_SIZE];
+    InetAddress peerAddress{};
+    size_t segmentSize = 0;
+
+    int size = m_server->Receive(buffer, BUFFER_SIZE, RECEIVE_TIMEOUT, peerAddress, segmentSize);
+    if (size <= 0)
+        return;
+
+    if (segmentSize == 0)
+        segmentSize = static_cast<size_t>(size);
+
+    for (size_t offset = 0; offset < static_cast<size_t>(size); offset += segmentSize)
+        dispatch(buffer + offset, std::min(segmentSize, static_cast<size_t>(size) - offset), peerAddress);
+}
+
+void GtpTransport::dispatch(const uint8_t *buffer, size_t size, const InetAddress &peerAddress)
+{
+    if (size < static_cast<size_t>(MIN_HEADER_LENGTH))
+        return;
+
+    NtsTask *target = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        if (buffer[1] == gtp::GtpMessage::MT_G_PDU)
+        {
+            uint32_t teid = (static_cast<uint32_t>(buffer[4]) << 24) | (static_cast<uint32_t>(buffer[5]) << 16) |
+                            (static_cast<uint32_t>(buffer[6]) << 8) | static_cast<uint32_t>(buffer[7]);
+            auto it = m_teidMap.find(teid);
+            if (it != m_teidMap.end())
+                target = it->second;
+        }
+        else if (buffer[1] == gtp::GtpMessage::MT_ECHO_RESPONSE && (buffer[0] & 0x02) != 0 &&
+                 size >= static_cast<size_t>(OPTIONAL_HEADER_LENGTH))
+        {
+            uint16_t seq = static_cast<uint16_t>((buffer[8] << 8) | buffer[9]);
+            auto it = m_echoMap.find(seq);
+            if (it != m_echoMap.end())
+            {
+                target = it->second;
+                m_echoMap.erase(it);
+            }
+        }
+
+        // Path management messages and unknown TEIDs are handled by the first gNB
+        if (target == nullptr && !m_tasks.empty())
+            target = m_tasks.front();
+    }
+
+    if (target == nullptr)
+        return;
+
+    target->push(std::make_unique<udp::NwUdpServerReceive>(
+        OctetString::FromArray(buffer, static_cast<size_t>(size)), peerAddress));
+}
+
+void GtpTransport::onQuit()
+{
+    delete m_server;
+}
+
+void GtpTransport::addTask(NtsTask *gtpTask)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_tasks.push_back(gtpTask);
+}
+
+void GtpTransport::removeTask(NtsTask *gtpTask)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_tasks.erase(std::remove(m_tasks.begin(), m_tasks.end(), gtpTask), m_tasks.end());
+
+    for (auto it = m_teidMap.begin(); it != m_teidMap.end();)
+    {
+        if (it->second == gtpTask)
+            it = m_teidMap.erase(it);
+        else
+            ++it;
+    }
+
+    for (auto it = m_echoMap.begin(); it != m_echoMap.end();)
+    {
+        if (it->second == gtpTask)
+            it = m_echoMap.erase(it);
+        else
+            ++it;
+    }
+}
+
+uint32_t GtpTransport::allocateTeid()
+{
+    return ++m_teidCounter;
+}
+
+void GtpTransport::bindTeid(uint32_t teid, NtsTask *gtpTask)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_teidMap[teid] = gtpTask;
+}
+
+void GtpTransport::unbindTeid(uint32_t teid)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_teidMap.erase(teid);
+}
+
+uint16_t GtpTransport::bindEchoRequest(NtsTask *gtpTask)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    uint16_t seq = ++m_echoSeqCounter;
+    while (m_echoMap.count(seq))
+        seq = ++m_echoSeqCounter;
+
+    m_echoMap[seq] = gtpTask;
+    return seq;
+}
+
+void GtpTransport::unbindEchoRequest(uint16_t seq)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_echoMap.erase(seq);
+}
+
+void GtpTransport::send(const InetAddress &to, const OctetString &packet)
+{
+    m_server->Send(to, packet.data(), static_cast<size_t>(packet.length()));
+}
+
+void GtpTransport::send(const InetAddress &to, const OctetString &packet, udp::DatagramBatch &batch)
+{
+    m_server->Send(to, packet.data(), static_cast<size_t>(packet.length()), batch);
+}
+
+void GtpTransport::flush(udp::DatagramBatch &batch)
+{
+    m_server->Send(batch);
+}
+
+} // namespace nr::gnb
@@ -0,0 +1,68 @@
+//
+// This file is a part of UERANSIM project.
+// Copyright (c) 2023 ALİ GÜNGÖR.
+//
+// https://github.com/aligungr/UERANSIM/
+// See README, LICENSE, and CONTRIBUTING files for licensing details.
+//
+
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <lib/udp/batch.hpp>
+#include <lib/udp/server.hpp>
+#include <utils/nts.hpp>
+#include <utils/octet_string.hpp>
+
+namespace nr::gnb
+{
+
+/*
+ * GTP-U socket shared by all gNBs of the process. Downlink G-PDUs are dispatched to the GTP task owning the TEID, and
+ * the remaining messages are handled by the GTP task that was added first. Downlink TEIDs are allocated here so that
+ * they are unique among the gNBs. Likewise, echo responses are dispatched to the GTP task that sent the request.
+ * Datagrams coalesced by the receive offload of the kernel are split again before being dispatched.
+ */
+class GtpTransport : public NtsTask
+{
+  private:
+    udp::UdpServer *m_server;
+    std::atomic<uint32_t> m_teidCounter;
+
+    std::mutex m_mutex;
+    std::vector<NtsTask *> m_tasks;
+    std::unordered_map<uint32_t, NtsTask *> m_teidMap;
+    uint16_t m_echoSeqCounter;
+    std::unordered_map<uint16_t, NtsTask *> m_echoMap;
+
+  public:
+    GtpTransport(const std::string &address, uint16_t port);
+    ~GtpTransport() override = default;
+
+  protected:
+    void onStart() override;
+    void onLoop() override;
+    void onQuit() override;
+
+  public:
+    /* Thread safe */
+    void addTask(NtsTask *gtpTask);
+    void removeTask(NtsTask *gtpTask);
+    uint32_t allocateTeid();
+    void bindTeid(uint32_t teid, NtsTask *gtpTask);
+    void unbindTeid(uint32_t teid);
+    uint16_t bindEchoRequest(NtsTask *gtpTask);
+    void unbindEchoRequest(uint16_t seq);
+    void send(const InetAddress &to, const OctetString &packet);
+    void send(const InetAddress &to, const OctetString &packet, udp::DatagramBatch &batch);
+    void flush(udp::DatagramBatch &batch);
+
+  private:
+    void dispatch(const uint8_t *buffer, size_t size, const InetAddress &peerAddress);
+};
+
+} // namespace nr::gnb
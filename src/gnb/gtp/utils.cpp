@@ -8,6 +8,9 @@
 
 #include "utils.hpp"
 
+#include <algorithm>
+#include <cmath>
+
 #include <utils/common.hpp>
 
 namespace nr::gnb
@@ -68,6 +71,128 @@ void PduSessionTree::enumerateByUe(int ue, std::vector<uint64_t> &output)
         output.push_back(item.second);
 }
 
+void GtpPath::onEchoResponse(int64_t rtt)
+{
+    if (lastRtt >= 0)
+    {
+        double delta = std::abs(static_cast<double>(rtt - lastRtt));
+        jitter += (delta - jitter) / 16.0;
+        smoothedRtt += (static_cast<double>(rtt) - smoothedRtt) / 8.0;
+    }
+    else
+    {
+        smoothedRtt = static_cast<double>(rtt);
+    }
+
+    lastRtt = rtt;
+    minRtt = minRtt < 0 ? rtt : std::min(minRtt, rtt);
+    maxRtt = std::max(maxRtt, rtt);
+
+    echoesReceived++;
+    missedEchoes = 0;
+    pendingSeq = std::nullopt;
+}
+
+void GtpPath::onEchoLost()
+{
+    missedEchoes++;
+    pendingSeq = std::nullopt;
+}
+
+Json ToJson(const GtpPath &v)
+{
+    uint64_t lost = v.echoesSent - v.echoesReceived - (v.pendingSeq.has_value() ? 1 : 0);
+
+    return Json::Obj({
+        {"address", v.name},
+        {"state", std::string{v.failed ? "failed" : (v.echoesReceived == 0 ? "unknown" : "up")}},
+        {"echo-sent", static_cast<int64_t>(v.echoesSent)},
+        {"echo-received", static_cast<int64_t>(v.echoesReceived)},
+        {"echo-lost", static_cast<int64_t>(lost)},
+        {"rtt-last-us", v.lastRtt},
+        {"rtt-min-us", v.minRtt},
+        {"rtt-max-us", v.maxRtt},
+        {"rtt-avg-us", static_cast<int64_t>(v.smoothedRtt + 0.5)},
+        {"jitter-us", static_cast<int64_t>(v.jitter + 0.5)},
+    });
+}
+
+// Seconds between the NTP epoch (1900) and the Unix epoch (1970)
+static constexpr const int64_t NTP_UNIX_OFFSET = 2208988800LL;
+
+// Upper bounds of the histogram buckets in microseconds, the last bucket is unbounded
+static constexpr const std::array<int64_t, LatencyHistogram::BUCKET_COUNT - 1> BUCKET_BOUNDS = {
+    100, 250, 500, 1000, 2500, 5000, 10000, 25000, 50000, 100000, 250000,
+};
+
+int64_t MicrosToNtpTime(int64_t micros)
+{
+    int64_t seconds = (micros / 1000000 + NTP_UNIX_OFFSET) & 0xFFFFFFFFLL;
+    int64_t fraction = ((micros % 1000000) << 32) / 1000000;
+    return static_cast<int64_t>((static_cast<uint64_t>(seconds) << 32) | static_cast<uint64_t>(fraction));
+}
+
+int64_t NtpTimeToMicros(int64_t ntpTime)
+{
+    int64_t seconds = (ntpTime >> 32) & 0xFFFFFFFFLL;
+    int64_t fraction = ntpTime & 0xFFFFFFFFLL;
+
+    // NTP era 1 starts in 2036, see RFC 5905 6
+    if (seconds < 0x80000000LL)
+        seconds += 0x100000000LL;
+
+    return (seconds - NTP_UNIX_OFFSET) * 1000000 + ((fraction * 1000000) >> 32);
+}
+
+void LatencyHistogram::add(int64_t delay)
+{
+    if (delay < 0)
+        return;
+
+    size_t bucket = 0;
+    while (bucket < BUCKET_BOUNDS.size() && delay > BUCKET_BOUNDS[bucket])
+        bucket++;
+
+    m_buckets[bucket]++;
+    m_count++;
+    m_sum += delay;
+    m_min = m_min < 0 ? delay : std::min(m_min, delay);
+    m_max = std::max(m_max, delay);
+}
+
+Json ToJson(const LatencyHistogram &v)
+{
+    Json buckets = Json::Obj({});
+    for (size_t i = 0; i < v.m_buckets.size(); i++)
+    {
+        if (v.m_buckets[i] == 0)
+            continue;
+        std::string key = i < BUCKET_BOUNDS.size() ? "<=" + std::to_string(BUCKET_BOUNDS[i]) + "us"
+                                                   : ">" + std::to_string(BUCKET_BOUNDS.back()) + "us";
+        buckets.put(key, static_cast<int64_t>(v.m_buckets[i]));
+    }
+
+    return Json::Obj({
+        {"count", static_cast<int64_t>(v.m_count)},
+        {"min-us", v.m_min},
+        {"avg-us", v.m_count == 0 ? -1 : v.m_sum / static_cast<int64_t>(v.m_count)},
+        {"max-us", v.m_max},
+        {"buckets", buckets},
+    });
+}
+
+Json ToJson(const QosFlowMonitor &v)
+{
+    return Json::Obj({
+        {"ue-id", v.ueId},
+        {"psi", v.psi},
+        {"qfi", v.qfi},
+        {"n3-downlink", ToJson(v.n3Downlink)},
+        {"ran-downlink", ToJson(v.ranDownlink)},
+        {"ran-uplink", ToJson(v.ranUplink)},
+    });
+}
+
 TokenBucket::TokenBucket(int64_t byteCapacity) : byteCapacity(byteCapacity)
 {
     if (byteCapacity > 0)
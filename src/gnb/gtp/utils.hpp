@@ -8,11 +8,15 @@
 
 #pragma once
 
+#include <array>
 #include <memory>
+#include <optional>
 #include <unordered_map>
 #include <vector>
 
 #include <gnb/types.hpp>
+#include <utils/json.hpp>
+#include <utils/network.hpp>
 
 namespace nr::gnb
 {
@@ -46,6 +50,88 @@ class PduSessionTree
     void enumerateByUe(int ue, std::vector<uint64_t> &output);
 };
 
+/*
+ * GTP-U path towards a UPF, monitored with echo requests. Times are in microseconds, since local round trips are well
+ * below a millisecond. The jitter is the smoothed mean deviation of consecutive round trip times as in RFC 3550.
+ */
+struct GtpPath
+{
+    std::string name;
+    InetAddress address;
+
+    std::optional<uint16_t> pendingSeq{};
+    int64_t pendingSince{};
+    int missedEchoes{};
+    bool failed{};
+
+    uint64_t echoesSent{};
+    uint64_t echoesReceived{};
+    int64_t lastRtt{-1};
+    int64_t minRtt{-1};
+    int64_t maxRtt{-1};
+    double smoothedRtt{};
+    double jitter{};
+
+    GtpPath(std::string name, const InetAddress &address) : name(std::move(name)), address(address)
+    {
+    }
+
+    void onEchoResponse(int64_t rtt);
+    void onEchoLost();
+};
+
+Json ToJson(const GtpPath &v);
+
+/* NTP timestamps as used in the QoS monitoring fields of 3GPP 38.415, converted from and to microseconds since epoch */
+int64_t MicrosToNtpTime(int64_t micros);
+int64_t NtpTimeToMicros(int64_t ntpTime);
+
+/* Histogram of delays in microseconds with fixed, roughly logarithmic bucket bounds */
+class LatencyHistogram
+{
+  public:
+    static constexpr const int BUCKET_COUNT = 12;
+
+  private:
+    std::array<uint64_t, BUCKET_COUNT> m_buckets{};
+    uint64_t m_count{};
+    int64_t m_sum{};
+    int64_t m_min{-1};
+    int64_t m_max{-1};
+
+  public:
+    void add(int64_t delay);
+
+    friend Json ToJson(const LatencyHistogram &v);
+};
+
+Json ToJson(const LatencyHistogram &v);
+
+/*
+ * QoS monitoring state of a QoS flow. The timestamps of the last downlink QoS monitoring packet are repeated in the
+ * next uplink packet of the flow, together with the delays measured in the gNB, see 3GPP 38.415 5.5.3.
+ */
+struct QosFlowMonitor
+{
+    int ueId;
+    int psi;
+    int qfi;
+
+    std::optional<int64_t> dlSendingTs{};
+    int64_t dlReceiveTime{};
+    std::optional<int64_t> dlRanDelay{};
+
+    LatencyHistogram n3Downlink{};
+    LatencyHistogram ranDownlink{};
+    LatencyHistogram ranUplink{};
+
+    QosFlowMonitor(int ueId, int psi, int qfi) : ueId(ueId), psi(psi), qfi(qfi)
+    {
+    }
+};
+
+Json ToJson(const QosFlowMonitor &v);
+
 class TokenBucket
 {
     static constexpr const int64_t REFILL_PERIOD = 1000L;
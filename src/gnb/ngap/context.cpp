@@ -239,7 +239,7 @@ void NgapTask::receiveContextRelease(int amfId, ASN_NGAP_UEContextReleaseCommand
     // Notify RRC task
     auto w1 = std::make_unique<NmGnbNgapToRrc>(NmGnbNgapToRrc::AN_RELEASE);
     w1->ueId = ue->ctxId;
-    m_base->rrcTask->push(std::move(w1));
+    m_base->rrcTaskOf(ue->ctxId)->push(std::move(w1));
 
     // Notify GTP task
     auto w2 = std::make_unique<NmGnbNgapToGtp>(NmGnbNgapToGtp::UE_CONTEXT_RELEASE);
@@ -0,0 +1,83 @@
+//
+// This file is a part of UERANSIM project.
+// Copyright (c) 2023 ALİ GÜNGÖR.
+//
+// https://github.com/aligungr/UERANSIM/
+// See README, LICENSE, and CONTRIBUTING files for licensing details.
+//
+
+#include "decode_task.hpp"
+#include "encode.hpp"
+#include "task.hpp"
+#include "utils.hpp"
+
+#include <lib/asn/ngap.hpp>
+
+#include <asn/ngap/ASN_NGAP_NGAP-PDU.h>
+#include <asn/ngap/ASN_NGAP_ProtocolIE-Field.h>
+#include <asn/ngap/ASN_NGAP_RAN-UE-NGAP-ID.h>
+#include <asn/ngap/ASN_NGAP_UE-NGAP-IDs.h>
+
+namespace nr::gnb
+{
+
+void DecodeNgapMessage(const UniqueBuffer &buffer, bool withXer, NmGnbNgapDecode &result)
+{
+    auto *pdu = ngap_encode::Decode<ASN_NGAP_NGAP_PDU>(asn_DEF_ASN_NGAP_NGAP_PDU, buffer.data(), buffer.size());
+    if (pdu == nullptr)
+        return;
+
+    result.pdu = asn::WrapUnique(pdu, asn_DEF_ASN_NGAP_NGAP_PDU);
+
+    if (withXer)
+        result.xer = ngap_encode::EncodeXer(asn_DEF_ASN_NGAP_NGAP_PDU, pdu);
+
+    auto *ptr =
+        asn::ngap::FindProtocolIeInPdu(*pdu, asn_DEF_ASN_NGAP_UE_NGAP_IDs, ASN_NGAP_ProtocolIE_ID_id_UE_NGAP_IDs);
+    if (ptr != nullptr)
+    {
+        result.ueNgapIds = ngap_utils::FindNgapIdPairFromAsnNgapIds(*reinterpret_cast<ASN_NGAP_UE_NGAP_IDs *>(ptr));
+        return;
+    }
+
+    ptr = asn::ngap::FindProtocolIeInPdu(*pdu, asn_DEF_ASN_NGAP_RAN_UE_NGAP_ID,
+                                         ASN_NGAP_ProtocolIE_ID_id_RAN_UE_NGAP_ID);
+    if (ptr != nullptr)
+        result.ranUeNgapId = static_cast<int64_t>(*reinterpret_cast<ASN_NGAP_RAN_UE_NGAP_ID_t *>(ptr));
+}
+
+NgapDecodeTask::NgapDecodeTask(TaskBase *base) : m_base{base}
+{
+}
+
+void NgapDecodeTask::onStart()
+{
+}
+
+void NgapDecodeTask::onLoop()
+{
+    auto msg = take();
+    if (!msg)
+        return;
+
+    if (msg->msgType != NtsMessageType::GNB_NGAP_DECODE)
+        return;
+
+    auto &w = dynamic_cast<NmGnbNgapDecode &>(*msg);
+    if (w.present != NmGnbNgapDecode::REQUEST)
+        return;
+
+    auto res = std::make_unique<NmGnbNgapDecode>(NmGnbNgapDecode::RESULT);
+    res->seq = w.seq;
+    res->amfId = w.amfId;
+    res->stream = w.stream;
+    DecodeNgapMessage(w.buffer, m_base->nodeListener != nullptr, *res);
+
+    m_base->ngapTask->push(std::move(res));
+}
+
+void NgapDecodeTask::onQuit()
+{
+}
+
+} // namespace nr::gnb
@@ -0,0 +1,40 @@
+//
+// This file is a part of UERANSIM project.
+// Copyright (c) 2023 ALİ GÜNGÖR.
+//
+// https://github.com/aligungr/UERANSIM/
+// See README, LICENSE, and CONTRIBUTING files for licensing details.
+//
+
+#pragma once
+
+#include <gnb/nts.hpp>
+#include <gnb/types.hpp>
+#include <utils/nts.hpp>
+
+namespace nr::gnb
+{
+
+/* Decodes a received NGAP message into the given result, and extracts the UE NGAP IDs. Thread safe. */
+void DecodeNgapMessage(const UniqueBuffer &buffer, bool withXer, NmGnbNgapDecode &result);
+
+/*
+ * Decodes the NGAP messages received from the AMF off the NGAP task. The results are pushed back to the NGAP task,
+ * which handles them in the order of reception.
+ */
+class NgapDecodeTask : public NtsTask
+{
+  private:
+    TaskBase *m_base;
+
+  public:
+    explicit NgapDecodeTask(TaskBase *base);
+    ~NgapDecodeTask() override = default;
+
+  protected:
+    void onStart() override;
+    void onLoop() override;
+    void onQuit() override;
+};
+
+} // namespace nr::gnb
@@ -33,11 +33,54 @@ void NgapTask::createAmfContext(const GnbAmfConfig &conf)
     m_amfCtx[ctx->ctxId] = ctx;
 }
 
+void NgapTask::updateAmfContext(NgapAmfContext &&ctx)
+{
+    auto *amf = m_amfCtx[ctx.ctxId];
+    if (amf == nullptr)
+    {
+        amf = new NgapAmfContext();
+        m_amfCtx[ctx.ctxId] = amf;
+    }
+
+    // Uplink streams are assigned by each shard on its own
+    int nextStream = amf->nextStream;
+    *amf = std::move(ctx);
+    amf->nextStream = nextStream;
+}
+
+void NgapTask::publishAmfContext(int amfId)
+{
+    if (m_base->ngapShards.size() <= 1)
+        return;
+
+    auto it = m_amfCtx.find(amfId);
+
+    for (size_t i = 1; i < m_base->ngapShards.size(); i++)
+    {
+        if (it == m_amfCtx.end() || it->second == nullptr)
+        {
+            auto w = std::make_unique<NmGnbNgapToNgap>(NmGnbNgapToNgap::AMF_REMOVE);
+            w->amfId = amfId;
+            m_base->ngapShards[i]->push(std::move(w));
+            continue;
+        }
+
+        // Served GUAMIs and PLMN supports are only kept by the first shard, the UE procedures do not use them
+        auto w = std::make_unique<NmGnbNgapToNgap>(NmGnbNgapToNgap::AMF_UPDATE);
+        w->amf = *it->second;
+        w->amf.servedGuamiList.clear();
+        w->amf.plmnSupportList.clear();
+        m_base->ngapShards[i]->push(std::move(w));
+    }
+}
+
 void NgapTask::createUeContext(int ueId)
 {
     auto *ctx = new NgapUeContext(ueId);
     ctx->amfUeNgapId = -1;
-    ctx->ranUeNgapId = ++m_ueNgapIdCounter;
+
+    // The RAN UE NGAP ID tells the shard of the UE, so that the messages from the AMF can be routed to it
+    ctx->ranUeNgapId = ++m_ueNgapIdCounter * static_cast<int64_t>(m_base->ngapShards.size()) + m_shard;
 
     m_ueCtx[ctx->ctxId] = ctx;
 
@@ -139,6 +182,20 @@ void NgapTask::deleteUeContext(int ueId)
     auto *ue = m_ueCtx[ueId];
     if (ue)
     {
+        if (ue->amfUeNgapId != -1 && m_base->ngapShards.size() > 1)
+        {
+            if (m_shard == 0)
+                forgetAmfUeShard(ue->associatedAmfId, ue->amfUeNgapId, m_shard);
+            else
+            {
+                auto w = std::make_unique<NmGnbNgapToNgap>(NmGnbNgapToNgap::UE_RELEASED);
+                w->amfId = ue->associatedAmfId;
+                w->amfUeNgapId = ue->amfUeNgapId;
+                w->shard = m_shard;
+                m_base->ngapShards[0]->push(std::move(w));
+            }
+        }
+
         delete ue;
         m_ueCtx.erase(ueId);
     }
@@ -148,10 +205,11 @@ void NgapTask::deleteAmfContext(int amfId)
 {
     auto *amf = m_amfCtx[amfId];
     if (amf)
-    {
         delete amf;
-        m_amfCtx.erase(amfId);
-    }
+    m_amfCtx.erase(amfId);
+
+    // The UE NGAP IDs assigned by the removed AMF are no longer routed
+    forgetAmfUeShards(amfId);
 }
 
 } // namespace nr::gnb
\ No newline at end of file
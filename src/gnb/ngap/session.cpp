@@ -14,6 +14,7 @@
 #include <stdexcept>
 
 #include <gnb/gtp/task.hpp>
+#include <gnb/gtp/transport.hpp>
 
 #include <asn/ngap/ASN_NGAP_AssociatedQosFlowItem.h>
 #include <asn/ngap/ASN_NGAP_AssociatedQosFlowList.h>
@@ -236,7 +237,7 @@ std::optional<NgapCause> NgapTask::setupPduSessionResource(NgapUeContext *ue, Pd
     std::string gtpIp = m_base->config->gtpAdvertiseIp.value_or(m_base->config->gtpIp);
 
     resource->downTunnel.address = utils::IpToOctetString(gtpIp);
-    resource->downTunnel.teid = ++m_downlinkTeidCounter;
+    resource->downTunnel.teid = m_base->gtpTransport->allocateTeid();
 
     auto w = std::make_unique<NmGnbNgapToGtp>(NmGnbNgapToGtp::SESSION_CREATE);
     w->resource = resource;
@@ -313,4 +314,10 @@ void NgapTask::receiveSessionResourceReleaseCommand(int amfId, ASN_NGAP_PDUSessi
     m_logger->info("PDU session resource(s) released for UE[%d] count[%d]", ue->ctxId, static_cast<int>(psIds.size()));
 }
 
+void NgapTask::handleUserPlanePathFailure(int ueId)
+{
+    // The PDU sessions cannot be continued without the N3 path, the UE context is released as a whole
+    sendContextRelease(ueId, NgapCause::Transport_transport_resource_unavailable);
+}
+
 } // namespace nr::gnb
\ No newline at end of file
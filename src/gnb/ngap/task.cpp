@@ -7,22 +7,41 @@
 //
 
 #include "task.hpp"
+#include "decode_task.hpp"
 
 #include <sstream>
 
 #include <gnb/app/task.hpp>
 #include <gnb/sctp/task.hpp>
 
+static constexpr const int TIMER_ID_STATUS = 1;
+static constexpr const int TIMER_PERIOD_STATUS = 1000;
+
 namespace nr::gnb
 {
 
-NgapTask::NgapTask(TaskBase *base) : m_base{base}, m_ueNgapIdCounter{}, m_downlinkTeidCounter{}, m_isInitialized{}
+NgapTask::NgapTask(TaskBase *base, int shard)
+    : m_base{base}, m_shard{shard}, m_ueNgapIdCounter{}, m_isInitialized{}, m_decodeTasks{}, m_decodeSeq{},
+      m_handleSeq{}, m_decoded{}, m_amfUeShards{}
 {
-    m_logger = base->logBase->makeUniqueLogger("ngap");
+    m_logger = base->logBase->makeUniqueLogger(shard == 0 ? "ngap" : "ngap-" + std::to_string(shard));
 }
 
 void NgapTask::onStart()
 {
+    setTimer(TIMER_ID_STATUS, TIMER_PERIOD_STATUS);
+
+    // The other shards receive the AMF contexts from the first one
+    if (m_shard != 0)
+        return;
+
+    for (int i = 0; i < m_base->config->ngapDecodeWorkers; i++)
+    {
+        auto *task = new NgapDecodeTask(m_base);
+        task->start();
+        m_decodeTasks.push_back(task);
+    }
+
     for (auto &amfConfig : m_base->config->amfConfigs)
         createAmfContext(amfConfig);
     if (m_amfCtx.empty())
@@ -39,7 +58,11 @@ void NgapTask::onStart()
         msg->ppid = sctp::PayloadProtocolId::NGAP;
         msg->associatedTask = this;
         m_base->sctpTask->push(std::move(msg));
+
+        publishAmfContext(amfCtx.second->ctxId);
     }
+
+    publishStatus();
 }
 
 void NgapTask::onLoop()
@@ -69,25 +92,89 @@ void NgapTask::onLoop()
         }
         break;
     }
+    case NtsMessageType::GNB_GTP_TO_NGAP: {
+        auto &w = dynamic_cast<NmGnbGtpToNgap &>(*msg);
+        switch (w.present)
+        {
+        case NmGnbGtpToNgap::PATH_FAILURE: {
+            handleUserPlanePathFailure(w.ueId);
+            break;
+        }
+        }
+        break;
+    }
     case NtsMessageType::GNB_SCTP: {
         auto &w = dynamic_cast<NmGnbSctp &>(*msg);
         switch (w.present)
         {
-        case NmGnbSctp::ASSOCIATION_SETUP:
-            handleAssociationSetup(w.clientId, w.associationId, w.inStreams, w.outStreams);
+        case NmGnbSctp::ASSOCIATION_SETUP: {
+            auto event = std::make_unique<NmGnbNgapDecode>(NmGnbNgapDecode::ASSOCIATION_SETUP);
+            event->amfId = w.clientId;
+            event->associationId = w.associationId;
+            event->inStreams = w.inStreams;
+            event->outStreams = w.outStreams;
+            handleAssociationEvent(std::move(event));
             break;
+        }
         case NmGnbSctp::RECEIVE_MESSAGE:
-            handleSctpMessage(w.clientId, w.stream, w.buffer);
+            handleSctpMessage(w.clientId, w.stream, std::move(w.buffer));
             break;
-        case NmGnbSctp::ASSOCIATION_SHUTDOWN:
-            handleAssociationShutdown(w.clientId);
+        case NmGnbSctp::ASSOCIATION_SHUTDOWN: {
+            auto event = std::make_unique<NmGnbNgapDecode>(NmGnbNgapDecode::ASSOCIATION_SHUTDOWN);
+            event->amfId = w.clientId;
+            handleAssociationEvent(std::move(event));
             break;
+        }
         default:
             m_logger->unhandledNts(*msg);
             break;
         }
         break;
     }
+    case NtsMessageType::GNB_NGAP_TO_NGAP: {
+        auto &w = dynamic_cast<NmGnbNgapToNgap &>(*msg);
+        switch (w.present)
+        {
+        case NmGnbNgapToNgap::AMF_UPDATE:
+            updateAmfContext(std::move(w.amf));
+            break;
+        case NmGnbNgapToNgap::AMF_REMOVE:
+            deleteAmfContext(w.amfId);
+            break;
+        case NmGnbNgapToNgap::UE_MESSAGE:
+            receiveNgapMessage(*w.decoded);
+            break;
+        case NmGnbNgapToNgap::UE_RELEASED:
+            forgetAmfUeShard(w.amfId, w.amfUeNgapId, w.shard);
+            break;
+        }
+        break;
+    }
+    case NtsMessageType::GNB_APP_TO_NGAP: {
+        auto &w = dynamic_cast<NmGnbAppToNgap &>(*msg);
+        switch (w.present)
+        {
+        case NmGnbAppToNgap::UE_RELEASE_REQUEST:
+            if (m_ueCtx.count(w.ueId))
+                sendContextRelease(w.ueId, NgapCause::RadioNetwork_unspecified);
+            break;
+        }
+        break;
+    }
+    case NtsMessageType::TIMER_EXPIRED: {
+        auto &w = dynamic_cast<NmTimerExpired &>(*msg);
+        if (w.timerId == TIMER_ID_STATUS)
+        {
+            setTimer(TIMER_ID_STATUS, TIMER_PERIOD_STATUS);
+            publishStatus();
+        }
+        break;
+    }
+    case NtsMessageType::GNB_NGAP_DECODE: {
+        std::unique_ptr<NmGnbNgapDecode> w{dynamic_cast<NmGnbNgapDecode *>(msg.release())};
+        handleDecodedMessage(std::move(w));
+        break;
+    }
     default: {
         m_logger->unhandledNts(*msg);
         break;
@@ -95,8 +182,33 @@ void NgapTask::onLoop()
     }
 }
 
+void NgapTask::publishStatus()
+{
+    NgapStatus status{};
+
+    for (auto &amf : m_amfCtx)
+        status.amfs[amf.first] = ToJson(*amf.second);
+
+    status.ues.reserve(m_ueCtx.size());
+    for (auto &ue : m_ueCtx)
+        status.ues.push_back(NgapUeStatus{ue.first, ue.second->ranUeNgapId, ue.second->amfUeNgapId});
+
+    // Readers are not handed a new version unless something has changed since the last one
+    auto &snapshot = m_base->ngapStatus[m_shard];
+    if (!(*snapshot->get() == status))
+        snapshot->set(std::move(status));
+}
+
 void NgapTask::onQuit()
 {
+    for (auto *task : m_decodeTasks)
+    {
+        task->quit();
+        delete task;
+    }
+    m_decodeTasks.clear();
+    m_decoded.clear();
+
     for (auto &i : m_ueCtx)
         delete i.second;
     for (auto &i : m_amfCtx)
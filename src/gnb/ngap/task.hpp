@@ -8,8 +8,10 @@
 
 #pragma once
 
+#include <map>
 #include <optional>
 #include <unordered_map>
+#include <vector>
 
 #include <gnb/nts.hpp>
 #include <gnb/types.hpp>
@@ -43,23 +45,31 @@ class SctpTask;
 class GnbRrcTask;
 class GtpTask;
 class GnbAppTask;
+class NgapDecodeTask;
 
 class NgapTask : public NtsTask
 {
   private:
     TaskBase *m_base;
+    int m_shard;
     std::unique_ptr<Logger> m_logger;
 
     std::unordered_map<int, NgapAmfContext *> m_amfCtx;
     std::unordered_map<int, NgapUeContext *> m_ueCtx;
     int64_t m_ueNgapIdCounter;
-    uint32_t m_downlinkTeidCounter;
     bool m_isInitialized;
 
-    friend class GnbCmdHandler;
+    std::vector<NgapDecodeTask *> m_decodeTasks;
+    uint64_t m_decodeSeq;
+    uint64_t m_handleSeq;
+    std::map<uint64_t, std::unique_ptr<NmGnbNgapDecode>> m_decoded;
+
+    /* Shards of the UEs that are known by the AMF UE NGAP ID, keyed by the AMF and the ID. Maintained by the first
+     * shard, and an entry lives as long as the UE context in the owning shard. */
+    std::unordered_map<int64_t, int> m_amfUeShards;
 
   public:
-    explicit NgapTask(TaskBase *base);
+    explicit NgapTask(TaskBase *base, int shard);
     ~NgapTask() override = default;
 
   protected:
@@ -68,8 +78,12 @@ class NgapTask : public NtsTask
     void onQuit() override;
 
   private:
+    void publishStatus();
+
     /* Utility functions */
     void createAmfContext(const GnbAmfConfig &config);
+    void updateAmfContext(NgapAmfContext &&ctx);
+    void publishAmfContext(int amfId);
     NgapAmfContext *findAmfContext(int ctxId);
     void createUeContext(int ueId);
     NgapUeContext *findUeContext(int ctxId);
@@ -94,8 +108,15 @@ class NgapTask : public NtsTask
     /* Message transport */
     void sendNgapNonUe(int amfId, ASN_NGAP_NGAP_PDU *pdu);
     void sendNgapUeAssociated(int ueId, ASN_NGAP_NGAP_PDU *pdu);
-    void handleSctpMessage(int amfId, uint16_t stream, const UniqueBuffer &buffer);
-    bool handleSctpStreamId(int amfId, int stream, const ASN_NGAP_NGAP_PDU &pdu);
+    void handleSctpMessage(int amfId, uint16_t stream, UniqueBuffer &&buffer);
+    void handleAssociationEvent(std::unique_ptr<NmGnbNgapDecode> &&msg);
+    void handleDecodedMessage(std::unique_ptr<NmGnbNgapDecode> &&msg);
+    void handleNgapMessage(NmGnbNgapDecode &msg);
+    void receiveNgapMessage(NmGnbNgapDecode &msg);
+    int findShard(const NmGnbNgapDecode &msg);
+    void forgetAmfUeShard(int amfId, int64_t amfUeNgapId, int shard);
+    void forgetAmfUeShards(int amfId);
+    bool handleSctpStreamId(int amfId, int stream, const NmGnbNgapDecode &msg);
 
     /* NAS transport */
     void handleInitialNasTransport(int ueId, const OctetString &nasPdu, int64_t rrcEstablishmentCause,
@@ -110,6 +131,7 @@ class NgapTask : public NtsTask
     void receiveSessionResourceSetupRequest(int amfId, ASN_NGAP_PDUSessionResourceSetupRequest *msg);
     void receiveSessionResourceReleaseCommand(int amfId, ASN_NGAP_PDUSessionResourceReleaseCommand *msg);
     std::optional<NgapCause> setupPduSessionResource(NgapUeContext *ue, PduSessionResource *resource);
+    void handleUserPlanePathFailure(int ueId);
 
     /* UE context management */
     void receiveInitialContextSetup(int amfId, ASN_NGAP_InitialContextSetupRequest *msg);
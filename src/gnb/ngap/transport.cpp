@@ -6,10 +6,13 @@
 // See README, LICENSE, and CONTRIBUTING files for licensing details.
 //
 
+#include "decode_task.hpp"
 #include "encode.hpp"
 #include "task.hpp"
 #include "utils.hpp"
 
+#include <algorithm>
+
 #include <gnb/app/task.hpp>
 #include <gnb/nts.hpp>
 #include <gnb/sctp/task.hpp>
@@ -81,6 +84,15 @@ static e_ASN_NGAP_Criticality FindCriticalityOfUserIe(ASN_NGAP_NGAP_PDU *pdu, AS
     return ASN_NGAP_Criticality_ignore;
 }
 
+// AMF UE NGAP IDs are 40-bit, the AMF context ID is placed above them
+static constexpr const int AMF_UE_NGAP_ID_BITS = 40;
+
+static int64_t AmfUeShardKey(int amfId, int64_t amfUeNgapId)
+{
+    int64_t idMask = (int64_t{1} << AMF_UE_NGAP_ID_BITS) - 1;
+    return (static_cast<int64_t>(amfId) << AMF_UE_NGAP_ID_BITS) | (amfUeNgapId & idMask);
+}
+
 namespace nr::gnb
 {
 
@@ -220,36 +232,167 @@ void NgapTask::sendNgapUeAssociated(int ueId, ASN_NGAP_NGAP_PDU *pdu)
     asn::Free(asn_DEF_ASN_NGAP_NGAP_PDU, pdu);
 }
 
-void NgapTask::handleSctpMessage(int amfId, uint16_t stream, const UniqueBuffer &buffer)
+void NgapTask::handleSctpMessage(int amfId, uint16_t stream, UniqueBuffer &&buffer)
+{
+    if (m_decodeTasks.empty())
+    {
+        NmGnbNgapDecode msg{NmGnbNgapDecode::RESULT};
+        msg.amfId = amfId;
+        msg.stream = stream;
+        DecodeNgapMessage(buffer, m_base->nodeListener != nullptr, msg);
+        handleNgapMessage(msg);
+        return;
+    }
+
+    // Messages are distributed to the decode tasks in turn, and numbered so that they are handled in order
+    auto w = std::make_unique<NmGnbNgapDecode>(NmGnbNgapDecode::REQUEST);
+    w->seq = m_decodeSeq++;
+    w->amfId = amfId;
+    w->stream = stream;
+    w->buffer = std::move(buffer);
+    m_decodeTasks[w->seq % m_decodeTasks.size()]->push(std::move(w));
+}
+
+void NgapTask::handleAssociationEvent(std::unique_ptr<NmGnbNgapDecode> &&msg)
+{
+    if (m_decodeTasks.empty())
+    {
+        handleNgapMessage(*msg);
+        return;
+    }
+
+    // Association events take their turn after the messages that are still being decoded
+    msg->seq = m_decodeSeq++;
+    handleDecodedMessage(std::move(msg));
+}
+
+void NgapTask::handleDecodedMessage(std::unique_ptr<NmGnbNgapDecode> &&msg)
+{
+    if (msg->seq != m_handleSeq)
+    {
+        m_decoded[msg->seq] = std::move(msg);
+        return;
+    }
+
+    handleNgapMessage(*msg);
+    m_handleSeq++;
+
+    for (auto it = m_decoded.begin(); it != m_decoded.end() && it->first == m_handleSeq; it = m_decoded.erase(it))
+    {
+        handleNgapMessage(*it->second);
+        m_handleSeq++;
+    }
+}
+
+void NgapTask::handleNgapMessage(NmGnbNgapDecode &msg)
+{
+    if (msg.present == NmGnbNgapDecode::ASSOCIATION_SETUP)
+    {
+        handleAssociationSetup(msg.amfId, msg.associationId, msg.inStreams, msg.outStreams);
+        publishAmfContext(msg.amfId);
+        return;
+    }
+    if (msg.present == NmGnbNgapDecode::ASSOCIATION_SHUTDOWN)
+    {
+        handleAssociationShutdown(msg.amfId);
+        publishAmfContext(msg.amfId);
+        return;
+    }
+
+    if (m_base->ngapShards.size() <= 1)
+    {
+        receiveNgapMessage(msg);
+        return;
+    }
+
+    int shard = findShard(msg);
+    if (shard > 0)
+    {
+        auto w = std::make_unique<NmGnbNgapToNgap>(NmGnbNgapToNgap::UE_MESSAGE);
+        w->decoded = std::make_unique<NmGnbNgapDecode>(std::move(msg));
+        m_base->ngapShards[shard]->push(std::move(w));
+        return;
+    }
+
+    receiveNgapMessage(msg);
+
+    // Non-UE-associated procedures may change the AMF context
+    if (shard < 0)
+        publishAmfContext(msg.amfId);
+}
+
+int NgapTask::findShard(const NmGnbNgapDecode &msg)
 {
+    std::optional<int64_t> ranUeNgapId = msg.ranUeNgapId;
+    std::optional<int64_t> amfUeNgapId{};
+    if (msg.ueNgapIds.has_value())
+    {
+        ranUeNgapId = msg.ueNgapIds->ranUeNgapId;
+        amfUeNgapId = msg.ueNgapIds->amfUeNgapId;
+    }
+
+    auto shardCount = static_cast<int64_t>(m_base->ngapShards.size());
+    int shard = -1;
+
+    if (ranUeNgapId.has_value())
+    {
+        shard = static_cast<int>(std::max<int64_t>(*ranUeNgapId, 0) % shardCount);
+        if (amfUeNgapId.has_value())
+            m_amfUeShards[AmfUeShardKey(msg.amfId, *amfUeNgapId)] = shard;
+    }
+    else if (amfUeNgapId.has_value())
+    {
+        // Only the AMF UE NGAP ID is present, the UE is unknown to the AMF unless it is seen with both IDs before
+        auto it = m_amfUeShards.find(AmfUeShardKey(msg.amfId, *amfUeNgapId));
+        shard = it != m_amfUeShards.end() ? it->second : m_shard;
+    }
+
+    return shard;
+}
+
+void NgapTask::forgetAmfUeShard(int amfId, int64_t amfUeNgapId, int shard)
+{
+    // The ID may already be assigned to a UE of another shard, whose entry is kept
+    auto it = m_amfUeShards.find(AmfUeShardKey(amfId, amfUeNgapId));
+    if (it != m_amfUeShards.end() && it->second == shard)
+        m_amfUeShards.erase(it);
+}
+
+void NgapTask::forgetAmfUeShards(int amfId)
+{
+    for (auto it = m_amfUeShards.begin(); it != m_amfUeShards.end();)
+    {
+        if ((it->first >> AMF_UE_NGAP_ID_BITS) == amfId)
+            it = m_amfUeShards.erase(it);
+        else
+            ++it;
+    }
+}
+
+void NgapTask::receiveNgapMessage(NmGnbNgapDecode &msg)
+{
+    int amfId = msg.amfId;
+
     auto *amf = findAmfContext(amfId);
     if (amf == nullptr)
         return;
 
-    auto *pdu = ngap_encode::Decode<ASN_NGAP_NGAP_PDU>(asn_DEF_ASN_NGAP_NGAP_PDU, buffer.data(), buffer.size());
+    auto *pdu = msg.pdu.get();
     if (pdu == nullptr)
     {
         m_logger->err("APER decoding failed for SCTP message");
-        asn::Free(asn_DEF_ASN_NGAP_NGAP_PDU, pdu);
         sendErrorIndication(amfId, NgapCause::Protocol_transfer_syntax_error);
         return;
     }
 
-    if (m_base->nodeListener)
+    if (m_base->nodeListener && msg.xer.length() > 0)
     {
-        std::string xer = ngap_encode::EncodeXer(asn_DEF_ASN_NGAP_NGAP_PDU, pdu);
-        if (xer.length() > 0)
-        {
-            m_base->nodeListener->onReceive(app::NodeType::GNB, m_base->config->name, app::NodeType::AMF, amf->amfName,
-                                            app::ConnectionType::NGAP, xer);
-        }
+        m_base->nodeListener->onReceive(app::NodeType::GNB, m_base->config->name, app::NodeType::AMF, amf->amfName,
+                                        app::ConnectionType::NGAP, msg.xer);
     }
 
-    if (!handleSctpStreamId(amf->ctxId, stream, *pdu))
-    {
-        asn::Free(asn_DEF_ASN_NGAP_NGAP_PDU, pdu);
+    if (!handleSctpStreamId(amf->ctxId, msg.stream, msg))
         return;
-    }
 
     if (pdu->present == ASN_NGAP_NGAP_PDU_PR_initiatingMessage)
     {
@@ -327,18 +470,14 @@ void NgapTask::handleSctpMessage(int amfId, uint16_t stream, const UniqueBuffer
     {
         m_logger->warn("Empty NGAP PDU ignored");
     }
-
-    asn::Free(asn_DEF_ASN_NGAP_NGAP_PDU, pdu);
 }
 
-bool NgapTask::handleSctpStreamId(int amfId, int stream, const ASN_NGAP_NGAP_PDU &pdu)
+bool NgapTask::handleSctpStreamId(int amfId, int stream, const NmGnbNgapDecode &msg)
 {
     if (m_base->config->ignoreStreamIds)
         return true;
 
-    auto *ptr =
-        asn::ngap::FindProtocolIeInPdu(pdu, asn_DEF_ASN_NGAP_UE_NGAP_IDs, ASN_NGAP_ProtocolIE_ID_id_UE_NGAP_IDs);
-    if (ptr != nullptr)
+    if (msg.ueNgapIds.has_value())
     {
         if (stream == 0)
         {
@@ -347,8 +486,7 @@ bool NgapTask::handleSctpStreamId(int amfId, int stream, const ASN_NGAP_NGAP_PDU
             return false;
         }
 
-        auto &ids = *reinterpret_cast<ASN_NGAP_UE_NGAP_IDs *>(ptr);
-        auto *ue = findUeByNgapIdPair(amfId, ngap_utils::FindNgapIdPairFromAsnNgapIds(ids));
+        auto *ue = findUeByNgapIdPair(amfId, *msg.ueNgapIds);
         if (ue == nullptr)
             return false;
 
@@ -364,9 +502,7 @@ bool NgapTask::handleSctpStreamId(int amfId, int stream, const ASN_NGAP_NGAP_PDU
     }
     else
     {
-        ptr = asn::ngap::FindProtocolIeInPdu(pdu, asn_DEF_ASN_NGAP_RAN_UE_NGAP_ID,
-                                             ASN_NGAP_ProtocolIE_ID_id_RAN_UE_NGAP_ID);
-        if (ptr != nullptr)
+        if (msg.ranUeNgapId.has_value())
         {
             if (stream == 0)
             {
@@ -375,8 +511,7 @@ bool NgapTask::handleSctpStreamId(int amfId, int stream, const ASN_NGAP_NGAP_PDU
                 return false;
             }
 
-            auto id = static_cast<int64_t>(*reinterpret_cast<ASN_NGAP_RAN_UE_NGAP_ID_t *>(ptr));
-            auto *ue = findUeByRanId(id);
+            auto *ue = findUeByRanId(*msg.ranUeNgapId);
             if (ue == nullptr)
                 return false;
 
@@ -25,6 +25,7 @@
 
 extern "C"
 {
+    struct ASN_NGAP_NGAP_PDU;
     struct ASN_NGAP_FiveG_S_TMSI;
     struct ASN_NGAP_TAIListForPaging;
 }
@@ -64,6 +65,7 @@ struct NmGnbRlsToGtp : NtsMessage
     int ueId{};
     int psi{};
     OctetString pdu;
+    int64_t receiveTime{};
 
     explicit NmGnbRlsToGtp(PR present) : NtsMessage(NtsMessageType::GNB_RLS_TO_GTP), present(present)
     {
@@ -112,11 +114,15 @@ struct NmGnbRlsToRls : NtsMessage
 
     // RECEIVE_RLS_MESSAGE
     std::unique_ptr<rls::RlsMessage> msg{};
+    InetAddress address{};
 
     // DOWNLINK_DATA
     // UPLINK_DATA
     int psi{};
 
+    // UPLINK_DATA
+    int64_t receiveTime{};
+
     // DOWNLINK_DATA
     // DOWNLINK_RRC
     // UPLINK_DATA
@@ -130,6 +136,9 @@ struct NmGnbRlsToRls : NtsMessage
     // UPLINK_RRC
     rrc::RrcChannel rrcChannel{};
 
+    // DOWNLINK_RRC
+    uint32_t pagingTag{};
+
     // RADIO_LINK_FAILURE
     rls::ERlfCause rlfCause{};
 
@@ -152,6 +161,7 @@ struct NmGnbRrcToRls : NtsMessage
     int ueId{};
     rrc::RrcChannel channel{};
     OctetString pdu{};
+    uint32_t pagingTag{}; // Non-zero for PCCH, see rrc::PagingOccasion
 
     explicit NmGnbRrcToRls(PR present) : NtsMessage(NtsMessageType::GNB_RRC_TO_RLS), present(present)
     {
@@ -239,6 +249,21 @@ struct NmGnbNgapToGtp : NtsMessage
     }
 };
 
+struct NmGnbGtpToNgap : NtsMessage
+{
+    enum PR
+    {
+        PATH_FAILURE,
+    } present;
+
+    // PATH_FAILURE
+    int ueId{};
+
+    explicit NmGnbGtpToNgap(PR present) : NtsMessage(NtsMessageType::GNB_GTP_TO_NGAP), present(present)
+    {
+    }
+};
+
 struct NmGnbSctp : NtsMessage
 {
     enum PR
@@ -284,6 +309,90 @@ struct NmGnbSctp : NtsMessage
     }
 };
 
+struct NmGnbNgapDecode : NtsMessage
+{
+    enum PR
+    {
+        REQUEST,
+        RESULT,
+        ASSOCIATION_SETUP,
+        ASSOCIATION_SHUTDOWN,
+    } present;
+
+    // REQUEST
+    // RESULT
+    // ASSOCIATION_SETUP
+    // ASSOCIATION_SHUTDOWN
+    uint64_t seq{};
+    int amfId{};
+
+    // REQUEST
+    // RESULT
+    uint16_t stream{};
+
+    // ASSOCIATION_SETUP
+    int associationId{};
+    int inStreams{};
+    int outStreams{};
+
+    // REQUEST
+    UniqueBuffer buffer{};
+
+    // RESULT
+    asn::Unique<ASN_NGAP_NGAP_PDU> pdu{};
+    std::string xer{};
+    std::optional<NgapIdPair> ueNgapIds{};
+    std::optional<int64_t> ranUeNgapId{};
+
+    explicit NmGnbNgapDecode(PR present) : NtsMessage(NtsMessageType::GNB_NGAP_DECODE), present(present)
+    {
+    }
+};
+
+struct NmGnbNgapToNgap : NtsMessage
+{
+    enum PR
+    {
+        AMF_UPDATE,
+        AMF_REMOVE,
+        UE_MESSAGE,
+        UE_RELEASED,
+    } present;
+
+    // AMF_UPDATE
+    NgapAmfContext amf{};
+
+    // AMF_REMOVE
+    // UE_RELEASED
+    int amfId{};
+
+    // UE_RELEASED
+    int64_t amfUeNgapId{};
+    int shard{};
+
+    // UE_MESSAGE
+    std::unique_ptr<NmGnbNgapDecode> decoded{};
+
+    explicit NmGnbNgapToNgap(PR present) : NtsMessage(NtsMessageType::GNB_NGAP_TO_NGAP), present(present)
+    {
+    }
+};
+
+struct NmGnbAppToNgap : NtsMessage
+{
+    enum PR
+    {
+        UE_RELEASE_REQUEST,
+    } present;
+
+    // UE_RELEASE_REQUEST
+    int ueId{};
+
+    explicit NmGnbAppToNgap(PR present) : NtsMessage(NtsMessageType::GNB_APP_TO_NGAP), present(present)
+    {
+    }
+};
+
 struct NmGnbStatusUpdate : NtsMessage
 {
     static constexpr const int NGAP_IS_UP = 1;
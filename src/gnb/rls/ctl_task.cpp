@@ -11,20 +11,20 @@
 #include <stdexcept>
 #include <utils/common.hpp>
 
-static constexpr const size_t MAX_PDU_COUNT = 4096;
 static constexpr const int MAX_PDU_TTL = 3000;
+static constexpr const int RETRANSMISSION_INTERVAL = 500;
 
-static constexpr const int TIMER_ID_ACK_CONTROL = 1;
+static constexpr const int TIMER_ID_RETRANSMISSION = 1;
 static constexpr const int TIMER_ID_ACK_SEND = 2;
 
-static constexpr const int TIMER_PERIOD_ACK_CONTROL = 1500;
-static constexpr const int TIMER_PERIOD_ACK_SEND = 2250;
+static constexpr const int TIMER_PERIOD_ACK_SEND = 40;
 
 namespace nr::gnb
 {
 
 RlsControlTask::RlsControlTask(TaskBase *base, uint64_t sti)
-    : m_sti{sti}, m_mainTask{}, m_udpTask{}, m_pduMap{}, m_pendingAck{}
+    : m_sti{sti}, m_mainTask{}, m_udpTask{}, m_sendWindows{}, m_receiveWindows{}, m_wheel{}, m_pendingAck{},
+      m_retransmissionTimerSet{}, m_ackTimerSet{}, m_dataBatch{}
 {
     m_logger = base->logBase->makeUniqueLogger("rls-ctl");
 }
@@ -37,15 +37,17 @@ void RlsControlTask::initialize(NtsTask *mainTask, RlsUdpTask *udpTask)
 
 void RlsControlTask::onStart()
 {
-    setTimer(TIMER_ID_ACK_CONTROL, TIMER_PERIOD_ACK_CONTROL);
-    setTimer(TIMER_ID_ACK_SEND, TIMER_PERIOD_ACK_SEND);
 }
 
 void RlsControlTask::onLoop()
 {
-    auto msg = take();
+    // Downlink data PDUs are collected into a batch as long as more messages are waiting in the queue
+    auto msg = m_dataBatch.isEmpty() ? take() : poll();
     if (!msg)
+    {
+        m_udpTask->flush(m_dataBatch);
         return;
+    }
 
     switch (msg->msgType)
     {
@@ -66,7 +68,7 @@ void RlsControlTask::onLoop()
             handleDownlinkDataDelivery(w.ueId, w.psi, std::move(w.data));
             break;
         case NmGnbRlsToRls::DOWNLINK_RRC:
-            handleDownlinkRrcDelivery(w.ueId, w.pduId, w.rrcChannel, std::move(w.data));
+            handleDownlinkRrcDelivery(w.ueId, w.pduId, w.rrcChannel, w.pagingTag, std::move(w.data));
             break;
         default:
             m_logger->unhandledNts(*msg);
@@ -76,14 +78,14 @@ void RlsControlTask::onLoop()
     }
     case NtsMessageType::TIMER_EXPIRED: {
         auto &w = dynamic_cast<NmTimerExpired &>(*msg);
-        if (w.timerId == TIMER_ID_ACK_CONTROL)
+        if (w.timerId == TIMER_ID_RETRANSMISSION)
         {
-            setTimer(TIMER_ID_ACK_CONTROL, TIMER_PERIOD_ACK_CONTROL);
-            onAckControlTimerExpired();
+            m_retransmissionTimerSet = false;
+            onRetransmissionTimerExpired();
         }
         else if (w.timerId == TIMER_ID_ACK_SEND)
         {
-            setTimer(TIMER_ID_ACK_SEND, TIMER_PERIOD_ACK_SEND);
+            m_ackTimerSet = false;
             onAckSendTimerExpired();
         }
         break;
@@ -107,6 +109,15 @@ void RlsControlTask::handleSignalDetected(int ueId)
 
 void RlsControlTask::handleSignalLost(int ueId)
 {
+    auto it = m_sendWindows.find(ueId);
+    if (it != m_sendWindows.end())
+    {
+        declareTransmissionFailure(it->second.clear());
+        m_sendWindows.erase(it);
+    }
+    m_receiveWindows.erase(ueId);
+    m_pendingAck.erase(ueId);
+
     auto w = std::make_unique<NmGnbRlsToRls>(NmGnbRlsToRls::SIGNAL_LOST);
     w->ueId = ueId;
     m_mainTask->push(std::move(w));
@@ -117,14 +128,25 @@ void RlsControlTask::handleRlsMessage(int ueId, rls::RlsMessage &msg)
     if (msg.msgType == rls::EMessageType::PDU_TRANSMISSION_ACK)
     {
         auto &m = (rls::RlsPduTransmissionAck &)msg;
-        for (auto pduId : m.pduIds)
-            m_pduMap.erase(pduId);
+        auto it = m_sendWindows.find(ueId);
+        if (it != m_sendWindows.end() && it->second.epoch() == m.epoch)
+            it->second.acknowledge(m.cumulative, m.bitmap);
     }
     else if (msg.msgType == rls::EMessageType::PDU_TRANSMISSION)
     {
         auto &m = (rls::RlsPduTransmission &)msg;
         if (m.pduId != 0)
-            m_pendingAck[ueId].push_back(m.pduId);
+        {
+            bool isNew = m_receiveWindows[ueId].receive(m.epoch, m.pduId);
+
+            // Duplicates are acknowledged again too, since the previous acknowledgement may be lost
+            m_pendingAck.insert(ueId);
+            if (!m_ackTimerSet)
+                m_ackTimerSet = setTimer(TIMER_ID_ACK_SEND, TIMER_PERIOD_ACK_SEND);
+
+            if (!isNew)
+                return;
+        }
 
         if (m.pduType == rls::EPduType::DATA)
         {
@@ -132,6 +154,7 @@ void RlsControlTask::handleRlsMessage(int ueId, rls::RlsMessage &msg)
             w->ueId = ueId;
             w->psi = static_cast<int>(m.payload);
             w->data = std::move(m.pdu);
+            w->receiveTime = utils::CurrentTimeMicros();
             m_mainTask->push(std::move(w));
         }
         else if (m.pduType == rls::EPduType::RRC)
@@ -153,7 +176,8 @@ void RlsControlTask::handleRlsMessage(int ueId, rls::RlsMessage &msg)
     }
 }
 
-void RlsControlTask::handleDownlinkRrcDelivery(int ueId, uint32_t pduId, rrc::RrcChannel channel, OctetString &&data)
+void RlsControlTask::handleDownlinkRrcDelivery(int ueId, uint32_t pduId, rrc::RrcChannel channel, uint32_t pagingTag,
+                                               OctetString &&data)
 {
     if (ueId == 0 && pduId != 0)
     {
@@ -161,21 +185,14 @@ void RlsControlTask::handleDownlinkRrcDelivery(int ueId, uint32_t pduId, rrc::Rr
         throw std::runtime_error("");
     }
 
+    uint32_t seq = 0;
+    uint32_t epoch = 0;
     if (pduId != 0)
     {
-        if (m_pduMap.count(pduId))
+        auto &window = m_sendWindows[ueId];
+        if (window.isFull())
         {
-            m_pduMap.clear();
-
-            auto w = std::make_unique<NmGnbRlsToRls>(NmGnbRlsToRls::RADIO_LINK_FAILURE);
-            w->rlfCause = rls::ERlfCause::PDU_ID_EXISTS;
-            m_mainTask->push(std::move(w));
-            return;
-        }
-
-        if (m_pduMap.size() > MAX_PDU_COUNT)
-        {
-            m_pduMap.clear();
+            declareTransmissionFailure(window.clear());
 
             auto w = std::make_unique<NmGnbRlsToRls>(NmGnbRlsToRls::RADIO_LINK_FAILURE);
             w->rlfCause = rls::ERlfCause::PDU_ID_FULL;
@@ -183,18 +200,26 @@ void RlsControlTask::handleDownlinkRrcDelivery(int ueId, uint32_t pduId, rrc::Rr
             return;
         }
 
-        m_pduMap[pduId].endPointId = ueId;
-        m_pduMap[pduId].id = pduId;
-        m_pduMap[pduId].pdu = data.copy();
-        m_pduMap[pduId].rrcChannel = channel;
-        m_pduMap[pduId].sentTime = utils::CurrentTimeMillis();
+        rls::PduInfo info;
+        info.endPointId = ueId;
+        info.id = pduId;
+        info.pdu = data.copy();
+        info.rrcChannel = channel;
+        info.sentTime = utils::CurrentTimeMillis();
+
+        int64_t deadline = info.sentTime + RETRANSMISSION_INTERVAL;
+        seq = window.push(std::move(info), deadline);
+        epoch = window.epoch();
+        scheduleRetransmission(deadline, ueId, seq);
     }
 
     rls::RlsPduTransmission msg{m_sti};
     msg.pduType = rls::EPduType::RRC;
     msg.pdu = std::move(data);
-    msg.payload = static_cast<uint32_t>(channel);
-    msg.pduId = pduId;
+    // The paging tag (if any) is carried in the upper bits, so UEs can filter the PCCH without decoding it
+    msg.payload = static_cast<uint32_t>(channel) | (pagingTag << 8);
+    msg.pduId = seq;
+    msg.epoch = epoch;
 
     m_udpTask->send(ueId, msg);
 }
@@ -207,52 +232,94 @@ void RlsControlTask::handleDownlinkDataDelivery(int ueId, int psi, OctetString &
     msg.payload = static_cast<uint32_t>(psi);
     msg.pduId = 0;
 
-    m_udpTask->send(ueId, msg);
+    m_udpTask->send(ueId, msg, m_dataBatch);
 }
 
-void RlsControlTask::onAckControlTimerExpired()
+void RlsControlTask::scheduleRetransmission(int64_t deadline, int ueId, uint32_t seq)
+{
+    m_wheel.schedule(deadline, ueId, seq);
+    if (!m_retransmissionTimerSet)
+        m_retransmissionTimerSet = setTimer(TIMER_ID_RETRANSMISSION, rls::RetransmissionWheel::TICK);
+}
+
+void RlsControlTask::declareTransmissionFailure(std::vector<rls::PduInfo> &&pduList)
+{
+    if (pduList.empty())
+        return;
+
+    auto w = std::make_unique<NmGnbRlsToRls>(NmGnbRlsToRls::TRANSMISSION_FAILURE);
+    w->pduList = std::move(pduList);
+    m_mainTask->push(std::move(w));
+}
+
+void RlsControlTask::onRetransmissionTimerExpired()
 {
     int64_t current = utils::CurrentTimeMillis();
 
-    std::vector<uint32_t> transmissionFailureIds;
+    std::vector<rls::RetransmissionWheel::Entry> expired;
+    m_wheel.advance(current, expired);
+
     std::vector<rls::PduInfo> transmissionFailures;
 
-    for (auto &pdu : m_pduMap)
+    for (auto &item : expired)
     {
-        auto delta = current - pdu.second.sentTime;
-        if (delta > MAX_PDU_TTL)
+        auto it = m_sendWindows.find(item.endPointId);
+        if (it == m_sendWindows.end())
+            continue;
+
+        // Already acknowledged
+        auto *entry = it->second.find(item.seq);
+        if (entry == nullptr)
+            continue;
+
+        if (entry->deadline > current)
         {
-            transmissionFailureIds.push_back(pdu.first);
-            transmissionFailures.push_back(std::move(pdu.second));
+            m_wheel.schedule(entry->deadline, item.endPointId, item.seq);
+            continue;
+        }
+
+        if (current - entry->info.sentTime >= MAX_PDU_TTL)
+        {
+            transmissionFailures.push_back(it->second.remove(item.seq));
+            continue;
         }
-    }
 
-    for (auto id : transmissionFailureIds)
-        m_pduMap.erase(id);
+        entry->deadline = current + RETRANSMISSION_INTERVAL;
+        m_wheel.schedule(entry->deadline, item.endPointId, item.seq);
 
-    if (!transmissionFailures.empty())
-    {
-        auto w = std::make_unique<NmGnbRlsToRls>(NmGnbRlsToRls::TRANSMISSION_FAILURE);
-        w->pduList = std::move(transmissionFailures);
-        m_mainTask->push(std::move(w));
+        rls::RlsPduTransmission msg{m_sti};
+        msg.pduType = rls::EPduType::RRC;
+        msg.pdu = entry->info.pdu.copy();
+        msg.payload = static_cast<uint32_t>(entry->info.rrcChannel);
+        msg.pduId = item.seq;
+        msg.epoch = it->second.epoch();
+
+        m_udpTask->send(item.endPointId, msg);
     }
+
+    declareTransmissionFailure(std::move(transmissionFailures));
+
+    if (!m_wheel.isEmpty())
+        m_retransmissionTimerSet = setTimer(TIMER_ID_RETRANSMISSION, rls::RetransmissionWheel::TICK);
 }
 
 void RlsControlTask::onAckSendTimerExpired()
 {
-    auto copy = m_pendingAck;
-    m_pendingAck.clear();
-
-    for (auto &item : copy)
+    for (int ueId : m_pendingAck)
     {
-        if (!item.second.empty())
+        auto it = m_receiveWindows.find(ueId);
+        if (it == m_receiveWindows.end())
             continue;
 
         rls::RlsPduTransmissionAck msg{m_sti};
-        msg.pduIds = std::move(item.second);
+        msg.epoch = it->second.epoch();
+        msg.cumulative = it->second.cumulative();
+        msg.bitmap = it->second.bitmap();
 
-        m_udpTask->send(item.first, msg);
+        m_udpTask->send(ueId, msg);
     }
+
+    m_pendingAck.clear();
 }
 
 } // namespace nr::gnb
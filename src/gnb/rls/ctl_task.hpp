@@ -10,6 +10,10 @@
 
 #include "udp_task.hpp"
 
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
 #include <gnb/nts.hpp>
 #include <gnb/types.hpp>
 #include <utils/nts.hpp>
@@ -24,8 +28,13 @@ class RlsControlTask : public NtsTask
     uint64_t m_sti;
     NtsTask *m_mainTask;
     RlsUdpTask *m_udpTask;
-    std::unordered_map<uint32_t, rls::PduInfo> m_pduMap;
-    std::unordered_map<int, std::vector<uint32_t>> m_pendingAck;
+    std::unordered_map<int, rls::SendWindow> m_sendWindows;
+    std::unordered_map<int, rls::ReceiveWindow> m_receiveWindows;
+    rls::RetransmissionWheel m_wheel;
+    std::unordered_set<int> m_pendingAck;
+    bool m_retransmissionTimerSet;
+    bool m_ackTimerSet;
+    udp::DatagramBatch m_dataBatch;
 
   public:
     explicit RlsControlTask(TaskBase *base, uint64_t sti);
@@ -43,9 +52,12 @@ class RlsControlTask : public NtsTask
     void handleSignalDetected(int ueId);
     void handleSignalLost(int ueId);
     void handleRlsMessage(int ueId, rls::RlsMessage &msg);
-    void handleDownlinkRrcDelivery(int ueId, uint32_t pduId, rrc::RrcChannel channel, OctetString &&data);
+    void handleDownlinkRrcDelivery(int ueId, uint32_t pduId, rrc::RrcChannel channel, uint32_t pagingTag,
+                                   OctetString &&data);
     void handleDownlinkDataDelivery(int ueId, int psi, OctetString &&data);
-    void onAckControlTimerExpired();
+    void scheduleRetransmission(int64_t deadline, int ueId, uint32_t seq);
+    void declareTransmissionFailure(std::vector<rls::PduInfo> &&pduList);
+    void onRetransmissionTimerExpired();
     void onAckSendTimerExpired();
 };
 
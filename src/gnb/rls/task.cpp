@@ -61,6 +61,7 @@ void GnbRlsTask::onLoop()
             m->ueId = w.ueId;
             m->psi = w.psi;
             m->pdu = std::move(w.data);
+            m->receiveTime = w.receiveTime;
             m_base->gtpTask->push(std::move(m));
             break;
         }
@@ -69,7 +70,7 @@ void GnbRlsTask::onLoop()
             m->ueId = w.ueId;
             m->rrcChannel = w.rrcChannel;
             m->data = std::move(w.data);
-            m_base->rrcTask->push(std::move(m));
+            m_base->rrcTaskOf(w.ueId)->push(std::move(m));
             break;
         }
         case NmGnbRlsToRls::RADIO_LINK_FAILURE: {
@@ -95,6 +96,7 @@ void GnbRlsTask::onLoop()
             auto m = std::make_unique<NmGnbRlsToRls>(NmGnbRlsToRls::DOWNLINK_RRC);
             m->ueId = w.ueId;
             m->rrcChannel = w.channel;
+            m->pagingTag = w.pagingTag;
             m->pduId = 0;
             m->data = std::move(w.pdu);
             m_ctlTask->push(std::move(m));
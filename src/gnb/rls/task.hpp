@@ -37,8 +37,6 @@ class GnbRlsTask : public NtsTask
 
     uint64_t m_sti;
 
-    friend class GnbCmdHandler;
-
   public:
     explicit GnbRlsTask(TaskBase *base);
     ~GnbRlsTask() override = default;
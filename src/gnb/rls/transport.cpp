@@ -0,0 +1,140 @@
+//
+// This file is a part of UERANSIM project.
+// Copyright (c) 2023 ALİ GÜNGÖR.
+//
+// https://github.com/aligungr/UERANSIM/
+// See README, LICENSE, and CONTRIBUTING files for licensing details.
+//
+
+#include "transport.hpp"
+
+#include <algorithm>
+#include <vector>
+
+#include <gnb/nts.hpp>
+
+static constexpr const int BUFFER_SIZE = 65536;
+static constexpr const int RECEIVE_TIMEOUT = 500;
+
+namespace nr::gnb
+{
+
+RlsTransport::RlsTransport(LogBase *logBase, const std::string &address, uint16_t port)
+    : m_server{}, m_mutex{}, m_cells{}
+{
+    m_logger = logBase->makeUniqueLogger("rls-transport");
+    m_server = new udp::UdpServer(address, port);
+    m_server->EnableReceiveOffload();
+}
+
+void RlsTransport::onStart()
+{
+}
+
+void RlsTransport::onLoop()
+{
+    uint8_t buffer[BUFFER_SIZE];
+    InetAddress peerAddress;
+    size_t segmentSize = 0;
+
+    int size = m_server->Receive(buffer, BUFFER_SIZE, RECEIVE_TIMEOUT, peerAddress, segmentSize);
+    if (size <= 0)
+        return;
+
+    if (segmentSize == 0)
+        segmentSize = static_cast<size_t>(size);
+
+    for (size_t offset = 0; offset < static_cast<size_t>(size); offset += segmentSize)
+        dispatch(buffer + offset, std::min(segmentSize, static_cast<size_t>(size) - offset), peerAddress);
+}
+
+void RlsTransport::dispatch(const uint8_t *buffer, size_t size, const InetAddress &peerAddress)
+{
+    auto msg = rls::DecodeRlsMessage(OctetView{buffer, size});
+    if (msg == nullptr)
+    {
+        m_logger->err("Unable to decode RLS message");
+        return;
+    }
+
+    if (msg->msgType == rls::EMessageType::HEARTBEAT)
+    {
+        auto &heartbeat = (const rls::RlsHeartBeat &)*msg;
+
+        std::vector<NtsTask *> cells{};
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            for (auto &cell : m_cells)
+                cells.push_back(cell.second);
+        }
+
+        for (auto *cell : cells)
+        {
+            auto copy = std::make_unique<rls::RlsHeartBeat>(heartbeat.sti);
+            copy->simPos = heartbeat.simPos;
+            deliver(cell, peerAddress, std::move(copy));
+        }
+        return;
+    }
+
+    NtsTask *cell = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_cells.find(msg->targetSti);
+        if (it != m_cells.end())
+            cell = it->second;
+    }
+
+    // Messages for a cell that is not hosted here (e.g. a released one) are ignored
+    if (cell != nullptr)
+        deliver(cell, peerAddress, std::move(msg));
+}
+
+void RlsTransport::onQuit()
+{
+    delete m_server;
+}
+
+void RlsTransport::deliver(NtsTask *cellTask, const InetAddress &address, std::unique_ptr<rls::RlsMessage> &&msg)
+{
+    auto w = std::make_unique<NmGnbRlsToRls>(NmGnbRlsToRls::RECEIVE_RLS_MESSAGE);
+    w->msg = std::move(msg);
+    w->address = address;
+    cellTask->push(std::move(w));
+}
+
+void RlsTransport::addCell(uint64_t sti, NtsTask *udpTask)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_cells[sti] = udpTask;
+}
+
+void RlsTransport::removeCell(uint64_t sti)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_cells.erase(sti);
+}
+
+void RlsTransport::send(const InetAddress &to, const rls::RlsMessage &msg, uint64_t targetSti)
+{
+    OctetString stream;
+    rls::EncodeRlsMessage(msg, targetSti, stream);
+
+    m_server->Send(to, stream.data(), static_cast<size_t>(stream.length()));
+}
+
+void RlsTransport::send(const InetAddress &to, const rls::RlsMessage &msg, uint64_t targetSti,
+                        udp::DatagramBatch &batch)
+{
+    OctetString stream;
+    rls::EncodeRlsMessage(msg, targetSti, stream);
+
+    m_server->Send(to, stream.data(), static_cast<size_t>(stream.length()), batch);
+}
+
+void RlsTransport::flush(udp::DatagramBatch &batch)
+{
+    m_server->Send(batch);
+}
+
+} // namespace nr::gnb
@@ -0,0 +1,61 @@
+//
+// This file is a part of UERANSIM project.
+// Copyright (c) 2023 ALİ GÜNGÖR.
+//
+// https://github.com/aligungr/UERANSIM/
+// See README, LICENSE, and CONTRIBUTING files for licensing details.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include <lib/rls/rls_pdu.hpp>
+#include <lib/udp/batch.hpp>
+#include <lib/udp/server.hpp>
+#include <utils/logger.hpp>
+#include <utils/nts.hpp>
+
+namespace nr::gnb
+{
+
+/*
+ * Radio link socket shared by all cells of the process. Heartbeats are given to every cell so that each of them is
+ * measured by the UE, other messages are dispatched to the cell whose STI they carry as the target. Datagrams coalesced
+ * by the receive offload of the kernel are split again before being decoded.
+ */
+class RlsTransport : public NtsTask
+{
+  private:
+    std::unique_ptr<Logger> m_logger;
+    udp::UdpServer *m_server;
+
+    std::mutex m_mutex;
+    std::unordered_map<uint64_t, NtsTask *> m_cells;
+
+  public:
+    RlsTransport(LogBase *logBase, const std::string &address, uint16_t port);
+    ~RlsTransport() override = default;
+
+  protected:
+    void onStart() override;
+    void onLoop() override;
+    void onQuit() override;
+
+  private:
+    void dispatch(const uint8_t *buffer, size_t size, const InetAddress &peerAddress);
+    void deliver(NtsTask *cellTask, const InetAddress &address, std::unique_ptr<rls::RlsMessage> &&msg);
+
+  public:
+    /* Thread safe */
+    void addCell(uint64_t sti, NtsTask *udpTask);
+    void removeCell(uint64_t sti);
+    void send(const InetAddress &to, const rls::RlsMessage &msg, uint64_t targetSti);
+    void send(const InetAddress &to, const rls::RlsMessage &msg, uint64_t targetSti, udp::DatagramBatch &batch);
+    void flush(udp::DatagramBatch &batch);
+};
+
+} // namespace nr::gnb
@@ -8,93 +8,116 @@
 
 #include "udp_task.hpp"
 
+#include <algorithm>
 #include <cmath>
 #include <cstdint>
 #include <cstring>
 #include <set>
 
 #include <gnb/nts.hpp>
+#include <gnb/rls/transport.hpp>
+#include <gnb/rls/ue_table.hpp>
 #include <utils/common.hpp>
 #include <utils/constants.hpp>
-#include <utils/libc_error.hpp>
 
-static constexpr const int BUFFER_SIZE = 16384;
-
-static constexpr const int LOOP_PERIOD = 1000;
-static constexpr const int RECEIVE_TIMEOUT = 200;
-static constexpr const int HEARTBEAT_THRESHOLD = 2000; // (LOOP_PERIOD + RECEIVE_TIMEOUT)'dan büyük olmalı
+static constexpr const int TIMER_ID_HEARTBEAT_CYCLE = 1;
+static constexpr const int TIMER_PERIOD_HEARTBEAT_CYCLE = 1000;
+static constexpr const int HEARTBEAT_THRESHOLD = 2000; // TIMER_PERIOD_HEARTBEAT_CYCLE'dan büyük olmalı
 
 static constexpr const int MIN_ALLOWED_DBM = -120;
 
-static int EstimateSimulatedDbm(const Vector3 &myPos, const Vector3 &uePos)
+static double FreeSpacePathLoss(double distance, double frequency)
+{
+    // Distance in meters and frequency in MHz
+    return 20.0 * std::log10(distance) + 20.0 * std::log10(frequency) - 27.55;
+}
+
+static int EstimateSimulatedDbm(const nr::gnb::PathLossConfig &pathLoss, const Vector3 &myPos, const Vector3 &uePos)
 {
-    int deltaX = myPos.x - uePos.x;
-    int deltaY = myPos.y - uePos.y;
-    int deltaZ = myPos.z - uePos.z;
-
-    int distance = static_cast<int>(std::sqrt(deltaX * deltaX + deltaY * deltaY + deltaZ * deltaZ));
-    if (distance == 0)
-        return -1; // 0 may be confusing for people
-    return -distance;
+    auto deltaX = static_cast<double>(myPos.x) - uePos.x;
+    auto deltaY = static_cast<double>(myPos.y) - uePos.y;
+    auto deltaZ = static_cast<double>(myPos.z) - uePos.z;
+
+    double distance = std::sqrt(deltaX * deltaX + deltaY * deltaY + deltaZ * deltaZ);
+
+    if (pathLoss.model == nr::gnb::EPathLossModel::DISTANCE)
+    {
+        if (static_cast<int>(distance) == 0)
+            return -1; // 0 may be confusing for people
+        return -static_cast<int>(std::min<double>(distance, INT32_MAX));
+    }
+
+    // The far-field formulas do not hold for the very close UEs
+    distance = std::max(distance, 1.0);
+
+    double loss;
+    if (pathLoss.model == nr::gnb::EPathLossModel::LOG_DISTANCE && distance > pathLoss.referenceDistance)
+        loss = FreeSpacePathLoss(pathLoss.referenceDistance, pathLoss.frequency) +
+               10.0 * pathLoss.exponent * std::log10(distance / pathLoss.referenceDistance);
+    else
+        loss = FreeSpacePathLoss(distance, pathLoss.frequency);
+
+    return static_cast<int>(std::lround(std::min(pathLoss.txPower - loss, -1.0)));
 }
 
 namespace nr::gnb
 {
 
 RlsUdpTask::RlsUdpTask(TaskBase *base, uint64_t sti, Vector3 phyLocation)
-    : m_server{}, m_ctlTask{}, m_sti{sti}, m_phyLocation{phyLocation}, m_lastLoop{}, m_stiToUe{}, m_ueMap{}, m_newIdCounter{}
+    : m_transport{base->rlsTransport}, m_ueTable{base->rlsUeTable}, m_ctlTask{}, m_sti{sti}, m_phyLocation{phyLocation},
+      m_pathLoss{base->config->pathLoss}, m_stiToUe{}, m_ueMap{}, m_newIdCounter{}
 {
     m_logger = base->logBase->makeUniqueLogger("rls-udp");
-
-    try
-    {
-        m_server = new udp::UdpServer(base->config->linkIp, cons::RadioLinkPort);
-    }
-    catch (const LibError &e)
-    {
-        m_logger->err("RLS failure [%s]", e.what());
-        quit();
-        return;
-    }
 }
 
 void RlsUdpTask::onStart()
 {
+    m_transport->addCell(m_sti, this);
+    setTimer(TIMER_ID_HEARTBEAT_CYCLE, TIMER_PERIOD_HEARTBEAT_CYCLE);
 }
 
 void RlsUdpTask::onLoop()
 {
-    auto current = utils::CurrentTimeMillis();
-    if (current - m_lastLoop > LOOP_PERIOD)
-    {
-        m_lastLoop = current;
-        heartbeatCycle(current);
-    }
-
-    uint8_t buffer[BUFFER_SIZE];
-    InetAddress peerAddress;
+    auto msg = take();
+    if (!msg)
+        return;
 
-    int size = m_server->Receive(buffer, BUFFER_SIZE, RECEIVE_TIMEOUT, peerAddress);
-    if (size > 0)
+    switch (msg->msgType)
     {
-        auto rlsMsg = rls::DecodeRlsMessage(OctetView{buffer, static_cast<size_t>(size)});
-        if (rlsMsg == nullptr)
-            m_logger->err("Unable to decode RLS message");
+    case NtsMessageType::GNB_RLS_TO_RLS: {
+        auto &w = dynamic_cast<NmGnbRlsToRls &>(*msg);
+        if (w.present == NmGnbRlsToRls::RECEIVE_RLS_MESSAGE)
+            receiveRlsPdu(w.address, std::move(w.msg));
         else
-            receiveRlsPdu(peerAddress, std::move(rlsMsg));
+            m_logger->unhandledNts(*msg);
+        break;
+    }
+    case NtsMessageType::TIMER_EXPIRED: {
+        auto &w = dynamic_cast<NmTimerExpired &>(*msg);
+        if (w.timerId == TIMER_ID_HEARTBEAT_CYCLE)
+        {
+            setTimer(TIMER_ID_HEARTBEAT_CYCLE, TIMER_PERIOD_HEARTBEAT_CYCLE);
+            heartbeatCycle(utils::CurrentTimeMillis());
+        }
+        break;
+    }
+    default:
+        m_logger->unhandledNts(*msg);
+        break;
     }
 }
 
 void RlsUdpTask::onQuit()
 {
-    delete m_server;
+    m_transport->removeCell(m_sti);
+    m_ueTable->publish(m_sti, {});
 }
 
 void RlsUdpTask::receiveRlsPdu(const InetAddress &addr, std::unique_ptr<rls::RlsMessage> &&msg)
 {
     if (msg->msgType == rls::EMessageType::HEARTBEAT)
     {
-        int dbm = EstimateSimulatedDbm(m_phyLocation, ((const rls::RlsHeartBeat &)*msg).simPos);
+        int dbm = EstimateSimulatedDbm(m_pathLoss, m_phyLocation, ((const rls::RlsHeartBeat &)*msg).simPos);
         if (dbm < MIN_ALLOWED_DBM)
         {
             // if the simulated signal strength is such low, then ignore this message
@@ -104,16 +127,23 @@ void RlsUdpTask::receiveRlsPdu(const InetAddress &addr, std::unique_ptr<rls::Rls
         if (m_stiToUe.count(msg->sti))
         {
             int ueId = m_stiToUe[msg->sti];
+            bool addressChanged = m_ueMap[ueId].address != addr;
+
             m_ueMap[ueId].address = addr;
             m_ueMap[ueId].lastSeen = utils::CurrentTimeMillis();
+
+            if (addressChanged)
+                publishLinks();
         }
         else
         {
             int ueId = ++m_newIdCounter;
 
             m_stiToUe[msg->sti] = ueId;
+            m_ueMap[ueId].sti = msg->sti;
             m_ueMap[ueId].address = addr;
             m_ueMap[ueId].lastSeen = utils::CurrentTimeMillis();
+            publishLinks();
 
             auto w = std::make_unique<NmGnbRlsToRls>(NmGnbRlsToRls::SIGNAL_DETECTED);
             w->ueId = ueId;
@@ -122,8 +152,9 @@ void RlsUdpTask::receiveRlsPdu(const InetAddress &addr, std::unique_ptr<rls::Rls
 
         rls::RlsHeartBeatAck ack{m_sti};
         ack.dbm = dbm;
+        ack.simPos = m_phyLocation;
 
-        sendRlsPdu(addr, ack);
+        sendRlsPdu(addr, ack, msg->sti);
         return;
     }
 
@@ -139,12 +170,9 @@ void RlsUdpTask::receiveRlsPdu(const InetAddress &addr, std::unique_ptr<rls::Rls
     m_ctlTask->push(std::move(w));
 }
 
-void RlsUdpTask::sendRlsPdu(const InetAddress &addr, const rls::RlsMessage &msg)
+void RlsUdpTask::sendRlsPdu(const InetAddress &addr, const rls::RlsMessage &msg, uint64_t targetSti)
 {
-    OctetString stream;
-    rls::EncodeRlsMessage(msg, stream);
-
-    m_server->Send(addr, stream.data(), static_cast<size_t>(stream.length()));
+    m_transport->send(addr, msg, targetSti);
 }
 
 void RlsUdpTask::heartbeatCycle(int64_t time)
@@ -167,6 +195,9 @@ void RlsUdpTask::heartbeatCycle(int64_t time)
     for (int ueId : lostUeId)
         m_ueMap.erase(ueId);
 
+    if (!lostUeId.empty())
+        publishLinks();
+
     for (int ueId : lostUeId)
     {
         auto w = std::make_unique<NmGnbRlsToRls>(NmGnbRlsToRls::SIGNAL_LOST);
@@ -175,6 +206,15 @@ void RlsUdpTask::heartbeatCycle(int64_t time)
     }
 }
 
+void RlsUdpTask::publishLinks()
+{
+    std::unordered_map<int, RlsUeTable::Link> links{};
+    for (auto &ue : m_ueMap)
+        links[ue.first] = RlsUeTable::Link{ue.second.sti, ue.second.address};
+
+    m_ueTable->publish(m_sti, std::move(links));
+}
+
 void RlsUdpTask::initialize(NtsTask *ctlTask)
 {
     m_ctlTask = ctlTask;
@@ -195,7 +235,21 @@ void RlsUdpTask::send(int ueId, const rls::RlsMessage &msg)
         return;
     }
 
-    sendRlsPdu(m_ueMap[ueId].address, msg);
+    sendRlsPdu(m_ueMap[ueId].address, msg, m_ueMap[ueId].sti);
+}
+
+void RlsUdpTask::send(int ueId, const rls::RlsMessage &msg, udp::DatagramBatch &batch)
+{
+    auto it = m_ueMap.find(ueId);
+    if (it == m_ueMap.end())
+        return;
+
+    m_transport->send(it->second.address, msg, it->second.sti, batch);
+}
+
+void RlsUdpTask::flush(udp::DatagramBatch &batch)
+{
+    m_transport->flush(batch);
 }
 
 } // namespace nr::gnb
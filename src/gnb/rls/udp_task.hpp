@@ -14,7 +14,7 @@
 
 #include <gnb/types.hpp>
 #include <lib/rls/rls_pdu.hpp>
-#include <lib/udp/server.hpp>
+#include <lib/udp/batch.hpp>
 #include <utils/nts.hpp>
 
 namespace nr::gnb
@@ -32,11 +32,12 @@ class RlsUdpTask : public NtsTask
 
   private:
     std::unique_ptr<Logger> m_logger;
-    udp::UdpServer *m_server;
+    RlsTransport *m_transport;
+    RlsUeTable *m_ueTable;
     NtsTask *m_ctlTask;
     uint64_t m_sti;
     Vector3 m_phyLocation;
-    int64_t m_lastLoop;
+    PathLossConfig m_pathLoss;
     std::unordered_map<uint64_t, int> m_stiToUe;
     std::unordered_map<int, UeInfo> m_ueMap;
     int m_newIdCounter;
@@ -52,12 +53,15 @@ class RlsUdpTask : public NtsTask
 
   private:
     void receiveRlsPdu(const InetAddress &addr, std::unique_ptr<rls::RlsMessage> &&msg);
-    void sendRlsPdu(const InetAddress &addr, const rls::RlsMessage &msg);
+    void sendRlsPdu(const InetAddress &addr, const rls::RlsMessage &msg, uint64_t targetSti);
     void heartbeatCycle(int64_t time);
+    void publishLinks();
 
   public:
     void initialize(NtsTask *ctlTask);
     void send(int ueId, const rls::RlsMessage &msg);
+    void send(int ueId, const rls::RlsMessage &msg, udp::DatagramBatch &batch);
+    void flush(udp::DatagramBatch &batch);
 };
 
 } // namespace nr::gnb
@@ -0,0 +1,40 @@
+//
+// This file is a part of UERANSIM project.
+// Copyright (c) 2023 ALİ GÜNGÖR.
+//
+// https://github.com/aligungr/UERANSIM/
+// See README, LICENSE, and CONTRIBUTING files for licensing details.
+//
+
+#include "ue_table.hpp"
+
+namespace nr::gnb
+{
+
+RlsUeTable::RlsUeTable() : m_table{}
+{
+}
+
+void RlsUeTable::publish(uint64_t cellSti, std::unordered_map<int, Link> &&links)
+{
+    Table table{};
+    table.cellSti = cellSti;
+    table.links = std::move(links);
+
+    m_table.set(std::move(table));
+}
+
+bool RlsUeTable::find(int ueId, uint64_t &cellSti, Link &link) const
+{
+    auto table = m_table.get();
+
+    auto it = table->links.find(ueId);
+    if (it == table->links.end())
+        return false;
+
+    cellSti = table->cellSti;
+    link = it->second;
+    return true;
+}
+
+} // namespace nr::gnb
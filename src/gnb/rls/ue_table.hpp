@@ -0,0 +1,54 @@
+//
+// This file is a part of UERANSIM project.
+// Copyright (c) 2023 ALİ GÜNGÖR.
+//
+// https://github.com/aligungr/UERANSIM/
+// See README, LICENSE, and CONTRIBUTING files for licensing details.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+
+#include <utils/network.hpp>
+#include <utils/snapshot.hpp>
+
+namespace nr::gnb
+{
+
+/*
+ * Radio links of the UEs in coverage of the cell, maintained by RlsUdpTask. The table is replaced as a whole on every
+ * change, so that other tasks look up a UE with a wait-free read and downlink user data may bypass the RLS tasks.
+ */
+class RlsUeTable
+{
+  public:
+    struct Link
+    {
+        uint64_t sti{};
+        InetAddress address{};
+    };
+
+  private:
+    struct Table
+    {
+        uint64_t cellSti{};
+        std::unordered_map<int, Link> links{};
+    };
+
+    Snapshot<Table> m_table;
+
+  public:
+    RlsUeTable();
+
+  public:
+    /* Called by RlsUdpTask only */
+    void publish(uint64_t cellSti, std::unordered_map<int, Link> &&links);
+
+    /* Thread safe, returns false if the UE has no radio link */
+    bool find(int ueId, uint64_t &cellSti, Link &link) const;
+};
+
+} // namespace nr::gnb
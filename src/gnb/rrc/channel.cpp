@@ -129,7 +129,7 @@ void GnbRrcTask::sendRrcMessage(int ueId, ASN_RRC_DL_DCCH_Message *msg)
     m_base->rlsTask->push(std::move(w));
 }
 
-void GnbRrcTask::sendRrcMessage(ASN_RRC_PCCH_Message *msg)
+void GnbRrcTask::sendRrcMessage(const rrc::PagingOccasion &occasion, ASN_RRC_PCCH_Message *msg)
 {
     OctetString pdu = rrc::encode::EncodeS(asn_DEF_ASN_RRC_PCCH_Message, msg);
     if (pdu.length() == 0)
@@ -142,6 +142,7 @@ void GnbRrcTask::sendRrcMessage(ASN_RRC_PCCH_Message *msg)
     w->ueId = 0;
     w->channel = rrc::RrcChannel::PCCH;
     w->pdu = std::move(pdu);
+    w->pagingTag = occasion.toTag();
     m_base->rlsTask->push(std::move(w));
 }
 
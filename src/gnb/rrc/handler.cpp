@@ -10,6 +10,7 @@
 
 #include <gnb/ngap/task.hpp>
 #include <lib/rrc/encode.hpp>
+#include <utils/common.hpp>
 
 #include <asn/ngap/ASN_NGAP_FiveG-S-TMSI.h>
 #include <asn/rrc/ASN_RRC_BCCH-BCH-Message.h>
@@ -63,7 +64,7 @@ void GnbRrcTask::deliverUplinkNas(int ueId, OctetString &&nasPdu)
     auto w = std::make_unique<NmGnbRrcToNgap>(NmGnbRrcToNgap::UPLINK_NAS_DELIVERY);
     w->ueId = ueId;
     w->pdu = std::move(nasPdu);
-    m_base->ngapTask->push(std::move(w));
+    m_base->ngapTaskOf(ueId)->push(std::move(w));
 }
 
 void GnbRrcTask::receiveUplinkInformationTransfer(int ueId, const ASN_RRC_ULInformationTransfer &msg)
@@ -99,7 +100,7 @@ void GnbRrcTask::handleRadioLinkFailure(int ueId)
     // Notify NGAP task
     auto w = std::make_unique<NmGnbRrcToNgap>(NmGnbRrcToNgap::RADIO_LINK_FAILURE);
     w->ueId = ueId;
-    m_base->ngapTask->push(std::move(w));
+    m_base->ngapTaskOf(ueId)->push(std::move(w));
 
     // Delete UE RRC context
     m_ueCtx.erase(ueId);
@@ -108,16 +109,6 @@ void GnbRrcTask::handleRadioLinkFailure(int ueId)
 void GnbRrcTask::handlePaging(const asn::Unique<ASN_NGAP_FiveG_S_TMSI> &tmsi,
                               const asn::Unique<ASN_NGAP_TAIListForPaging> &taiList)
 {
-    // Construct and send a Paging message
-    auto *pdu = asn::New<ASN_RRC_PCCH_Message>();
-    pdu->message.present = ASN_RRC_PCCH_MessageType_PR_c1;
-    pdu->message.choice.c1 = asn::NewFor(pdu->message.choice.c1);
-    pdu->message.choice.c1->present = ASN_RRC_PCCH_MessageType__c1_PR_paging;
-    auto &paging = pdu->message.choice.c1->choice.paging = asn::New<ASN_RRC_Paging>();
-
-    auto *record = asn::New<ASN_RRC_PagingRecord>();
-    record->ue_Identity.present = ASN_RRC_PagingUE_Identity_PR_ng_5G_S_TMSI;
-
     OctetString tmsiOctets{};
     tmsiOctets.appendOctet2(bits::Ranged16({
         {10, asn::GetBitStringInt<10>(tmsi->aMFSetID)},
@@ -125,12 +116,33 @@ void GnbRrcTask::handlePaging(const asn::Unique<ASN_NGAP_FiveG_S_TMSI> &tmsi,
     }));
     tmsiOctets.append(asn::GetOctetString(tmsi->fiveG_TMSI));
 
-    asn::SetBitString(record->ue_Identity.choice.ng_5G_S_TMSI, tmsiOctets);
+    auto occasion = rrc::PagingOccasion::Of(static_cast<uint32_t>(asn::GetOctet4(tmsi->fiveG_TMSI)),
+                                            static_cast<int>(m_config->pagingDrx));
+
+    // Paging is not sent immediately, but batched with the other records of the same paging occasion
+    schedulePaging(occasion, std::move(tmsiOctets), utils::CurrentTimeMillis());
+}
+
+void GnbRrcTask::sendPaging(const rrc::PagingOccasion &occasion, const std::vector<OctetString> &records)
+{
+    // Construct and send a Paging message
+    auto *pdu = asn::New<ASN_RRC_PCCH_Message>();
+    pdu->message.present = ASN_RRC_PCCH_MessageType_PR_c1;
+    pdu->message.choice.c1 = asn::NewFor(pdu->message.choice.c1);
+    pdu->message.choice.c1->present = ASN_RRC_PCCH_MessageType__c1_PR_paging;
+    auto &paging = pdu->message.choice.c1->choice.paging = asn::New<ASN_RRC_Paging>();
 
     paging->pagingRecordList = asn::NewFor(paging->pagingRecordList);
-    asn::SequenceAdd(*paging->pagingRecordList, record);
 
-    sendRrcMessage(pdu);
+    for (auto &tmsiOctets : records)
+    {
+        auto *record = asn::New<ASN_RRC_PagingRecord>();
+        record->ue_Identity.present = ASN_RRC_PagingUE_Identity_PR_ng_5G_S_TMSI;
+        asn::SetBitString(record->ue_Identity.choice.ng_5G_S_TMSI, tmsiOctets);
+        asn::SequenceAdd(*paging->pagingRecordList, record);
+    }
+
+    sendRrcMessage(occasion, pdu);
     asn::Free(asn_DEF_ASN_RRC_PCCH_Message, pdu);
 }
 
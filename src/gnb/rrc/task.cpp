@@ -11,25 +11,31 @@
 #include <gnb/nts.hpp>
 #include <gnb/rls/task.hpp>
 #include <lib/rrc/encode.hpp>
+#include <utils/common.hpp>
 
 #include <asn/rrc/ASN_RRC_DLInformationTransfer-IEs.h>
 #include <asn/rrc/ASN_RRC_DLInformationTransfer.h>
 
 static constexpr const int TIMER_ID_SI_BROADCAST = 1;
+static constexpr const int TIMER_ID_PAGING = 2;
 static constexpr const int TIMER_PERIOD_SI_BROADCAST = 10'000;
 
+static constexpr const size_t MAX_PAGING_RECORDS = 32; // maxNrofPageRec
+
 namespace nr::gnb
 {
 
-GnbRrcTask::GnbRrcTask(TaskBase *base) : m_base{base}, m_ueCtx{}, m_tidCounter{}
+GnbRrcTask::GnbRrcTask(TaskBase *base, int shard) : m_base{base}, m_shard{shard}, m_ueCtx{}, m_tidCounter{}
 {
-    m_logger = base->logBase->makeUniqueLogger("rrc");
+    m_logger = base->logBase->makeUniqueLogger(shard == 0 ? "rrc" : "rrc-" + std::to_string(shard));
     m_config = m_base->config;
 }
 
 void GnbRrcTask::onStart()
 {
-    setTimer(TIMER_ID_SI_BROADCAST, TIMER_PERIOD_SI_BROADCAST);
+    // System information is broadcast by the first shard only
+    if (m_shard == 0)
+        setTimer(TIMER_ID_SI_BROADCAST, TIMER_PERIOD_SI_BROADCAST);
 }
 
 void GnbRrcTask::onQuit()
@@ -79,6 +85,10 @@ void GnbRrcTask::onLoop()
             setTimer(TIMER_ID_SI_BROADCAST, TIMER_PERIOD_SI_BROADCAST);
             onBroadcastTimerExpired();
         }
+        else if (w.timerId == TIMER_ID_PAGING)
+        {
+            onPagingTimerExpired();
+        }
         break;
     }
     default:
@@ -87,4 +97,49 @@ void GnbRrcTask::onLoop()
     }
 }
 
+void GnbRrcTask::schedulePaging(const rrc::PagingOccasion &occasion, OctetString &&record, int64_t notBefore)
+{
+    int64_t time = occasion.nextTimeMs(notBefore);
+
+    auto &item = m_pagingQueue[time];
+    item.occasion = occasion;
+
+    for (auto &existing : item.records)
+        if (existing == record)
+            return;
+
+    item.records.push_back(std::move(record));
+
+    if (item.records.size() == 1)
+        setTimerAbsolute(TIMER_ID_PAGING, time);
+}
+
+void GnbRrcTask::onPagingTimerExpired()
+{
+    int64_t now = utils::CurrentTimeMillis();
+
+    while (!m_pagingQueue.empty() && m_pagingQueue.begin()->first <= now)
+    {
+        auto item = std::move(m_pagingQueue.begin()->second);
+        m_pagingQueue.erase(m_pagingQueue.begin());
+
+        if (item.records.size() <= MAX_PAGING_RECORDS)
+        {
+            sendPaging(item.occasion, item.records);
+            continue;
+        }
+
+        // Records exceeding the limit of a single paging message are deferred to the next cycle of the same occasion
+        std::vector<OctetString> records{};
+        for (size_t i = 0; i < item.records.size(); i++)
+        {
+            if (i < MAX_PAGING_RECORDS)
+                records.push_back(std::move(item.records[i]));
+            else
+                schedulePaging(item.occasion, std::move(item.records[i]), now + 1);
+        }
+        sendPaging(item.occasion, records);
+    }
+}
+
 } // namespace nr::gnb
@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include <map>
 #include <memory>
 #include <thread>
 #include <unordered_map>
@@ -42,6 +43,7 @@ class GnbRrcTask : public NtsTask
 {
   private:
     TaskBase *m_base;
+    int m_shard;
     GnbConfig *m_config;
     std::unique_ptr<Logger> m_logger;
 
@@ -53,10 +55,11 @@ class GnbRrcTask : public NtsTask
     UacAiBarringSet m_aiBarringSet = {};
     bool m_intraFreqReselectAllowed = true;
 
-    friend class GnbCmdHandler;
+    /* Pending paging records by the time of their paging occasion */
+    std::map<int64_t, RrcPagingOccasion> m_pagingQueue{};
 
   public:
-    explicit GnbRrcTask(TaskBase *base);
+    explicit GnbRrcTask(TaskBase *base, int shard);
     ~GnbRrcTask() override = default;
 
   protected:
@@ -76,6 +79,11 @@ class GnbRrcTask : public NtsTask
     void handleRadioLinkFailure(int ueId);
     void handlePaging(const asn::Unique<ASN_NGAP_FiveG_S_TMSI> &tmsi,
                       const asn::Unique<ASN_NGAP_TAIListForPaging> &taiList);
+    void sendPaging(const rrc::PagingOccasion &occasion, const std::vector<OctetString> &records);
+
+    /* Paging Scheduling */
+    void schedulePaging(const rrc::PagingOccasion &occasion, OctetString &&record, int64_t notBefore);
+    void onPagingTimerExpired();
 
     void receiveUplinkInformationTransfer(int ueId, const ASN_RRC_ULInformationTransfer &msg);
 
@@ -84,7 +92,7 @@ class GnbRrcTask : public NtsTask
     void sendRrcMessage(ASN_RRC_BCCH_DL_SCH_Message *msg);
     void sendRrcMessage(int ueId, ASN_RRC_DL_CCCH_Message *msg);
     void sendRrcMessage(int ueId, ASN_RRC_DL_DCCH_Message *msg);
-    void sendRrcMessage(ASN_RRC_PCCH_Message *msg);
+    void sendRrcMessage(const rrc::PagingOccasion &occasion, ASN_RRC_PCCH_Message *msg);
 
     /* RRC channel receive message */
     void receiveRrcMessage(int ueId, ASN_RRC_BCCH_BCH_Message *msg);
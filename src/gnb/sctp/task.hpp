@@ -39,8 +39,6 @@ class SctpTask : public NtsTask
     std::unique_ptr<Logger> m_logger;
     std::unordered_map<int, ClientEntry *> m_clients;
 
-    friend class GnbCmdHandler;
-
   public:
     explicit SctpTask(TaskBase *base);
     ~SctpTask() override = default;
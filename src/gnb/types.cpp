@@ -31,6 +31,12 @@ Json ToJson(const GnbConfig &v)
         {"gtp-ip", v.gtpIp},
         {"paging-drx", ToJson(v.pagingDrx)},
         {"ignore-sctp-id", v.ignoreStreamIds},
+        {"downlink-cut-through", v.downlinkCutThrough},
+        {"ngap-decode-workers", v.ngapDecodeWorkers},
+        {"signalling-shards", v.signallingShards},
+        {"position", std::to_string(v.phyLocation.x) + ", " + std::to_string(v.phyLocation.y) + ", " +
+                         std::to_string(v.phyLocation.z)},
+        {"path-loss", ToJson(v.pathLoss.model)},
     });
 }
 
@@ -83,6 +89,21 @@ Json ToJson(const EPagingDrx &v)
     }
 }
 
+Json ToJson(const EPathLossModel &v)
+{
+    switch (v)
+    {
+    case EPathLossModel::DISTANCE:
+        return "distance";
+    case EPathLossModel::FREE_SPACE:
+        return "free-space";
+    case EPathLossModel::LOG_DISTANCE:
+        return "log-distance";
+    default:
+        return "?";
+    }
+}
+
 Json ToJson(const SctpAssociation &v)
 {
     return Json::Obj({{"id", v.associationId}, {"rx-num", v.inStreams}, {"tx-num", v.outStreams}});
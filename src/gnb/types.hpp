@@ -8,15 +8,20 @@
 
 #pragma once
 
+#include <map>
+#include <memory>
 #include <set>
+#include <vector>
 
 #include <lib/app/monitor.hpp>
 #include <lib/asn/utils.hpp>
+#include <lib/rrc/rrc.hpp>
 #include <utils/common_types.hpp>
 #include <utils/logger.hpp>
 #include <utils/network.hpp>
 #include <utils/nts.hpp>
 #include <utils/octet_string.hpp>
+#include <utils/snapshot.hpp>
 
 #include <asn/ngap/ASN_NGAP_QosFlowSetupRequestList.h>
 #include <asn/rrc/ASN_RRC_InitialUE-Identity.h>
@@ -30,6 +35,9 @@ class NgapTask;
 class GnbRrcTask;
 class GnbRlsTask;
 class SctpTask;
+class GtpTransport;
+class RlsTransport;
+class RlsUeTable;
 
 enum class EAmfState
 {
@@ -155,6 +163,12 @@ struct RrcUeContext
     }
 };
 
+struct RrcPagingOccasion
+{
+    rrc::PagingOccasion occasion{};
+    std::vector<OctetString> records{}; // 48-bit 5G-S-TMSI values
+};
+
 struct NgapIdPair
 {
     std::optional<int64_t> amfUeNgapId{};
@@ -294,6 +308,23 @@ struct GtpUeContextUpdate
     }
 };
 
+enum class EPathLossModel
+{
+    DISTANCE, // Signal strength is the negative of the distance, regardless of the units
+    FREE_SPACE,
+    LOG_DISTANCE,
+};
+
+/* Simulated propagation from the cell to the UEs, positions are in meters */
+struct PathLossConfig
+{
+    EPathLossModel model = EPathLossModel::DISTANCE;
+    double txPower = 43.0;          // dBm
+    double frequency = 3500.0;      // MHz
+    double exponent = 3.0;          // LOG_DISTANCE only
+    double referenceDistance = 1.0; // LOG_DISTANCE only, free-space propagation up to this distance
+};
+
 struct GnbAmfConfig
 {
     std::string address{};
@@ -314,11 +345,15 @@ struct GnbConfig
     std::string gtpIp{};
     std::optional<std::string> gtpAdvertiseIp{};
     bool ignoreStreamIds{};
+    bool downlinkCutThrough{};
+    int ngapDecodeWorkers{};
+    int signallingShards{};
+    Vector3 phyLocation{};
+    PathLossConfig pathLoss{};
 
     /* Assigned by program */
     std::string name{};
     EPagingDrx pagingDrx{};
-    Vector3 phyLocation{};
 
     [[nodiscard]] inline uint32_t getGnbId() const
     {
@@ -331,6 +366,42 @@ struct GnbConfig
     }
 };
 
+struct NgapUeStatus
+{
+    int ueId{};
+    int64_t ranUeNgapId{};
+    int64_t amfUeNgapId{};
+
+    inline bool operator==(const NgapUeStatus &other) const
+    {
+        return ueId == other.ueId && ranUeNgapId == other.ranUeNgapId && amfUeNgapId == other.amfUeNgapId;
+    }
+};
+
+/* State of an NGAP shard published periodically for the CLI */
+struct NgapStatus
+{
+    std::map<int, Json> amfs{};
+    std::vector<NgapUeStatus> ues{};
+
+    inline bool operator==(const NgapStatus &other) const
+    {
+        return amfs == other.amfs && ues == other.ues;
+    }
+};
+
+/* State of the GTP task published periodically for the CLI */
+struct GtpStatus
+{
+    Json paths = Json::Arr({});
+    Json qosMonitoring = Json::Arr({});
+
+    inline bool operator==(const GtpStatus &other) const
+    {
+        return paths == other.paths && qosMonitoring == other.qosMonitoring;
+    }
+};
+
 struct TaskBase
 {
     GnbConfig *config{};
@@ -344,6 +415,29 @@ struct TaskBase
     GnbRrcTask *rrcTask{};
     SctpTask *sctpTask{};
     GnbRlsTask *rlsTask{};
+
+    // UE contexts are partitioned among the signalling shards by the UE ID. The first shard is the one above, which
+    // also handles the non-UE-associated signalling.
+    std::vector<NgapTask *> ngapShards{};
+    std::vector<GnbRrcTask *> rrcShards{};
+
+    GtpTransport *gtpTransport{};
+    RlsTransport *rlsTransport{};
+    RlsUeTable *rlsUeTable{};
+
+    // Status of the tasks for the CLI, which reads them without pausing the tasks. One per NGAP shard.
+    std::vector<std::unique_ptr<Snapshot<NgapStatus>>> ngapStatus{};
+    Snapshot<GtpStatus> gtpStatus{};
+
+    [[nodiscard]] inline NgapTask *ngapTaskOf(int ueId) const
+    {
+        return ngapShards[static_cast<size_t>(ueId) % ngapShards.size()];
+    }
+
+    [[nodiscard]] inline GnbRrcTask *rrcTaskOf(int ueId) const
+    {
+        return rrcShards[static_cast<size_t>(ueId) % rrcShards.size()];
+    }
 };
 
 Json ToJson(const GnbStatusInfo &v);
@@ -351,6 +445,7 @@ Json ToJson(const GnbConfig &v);
 Json ToJson(const NgapAmfContext &v);
 Json ToJson(const EAmfState &v);
 Json ToJson(const EPagingDrx &v);
+Json ToJson(const EPathLossModel &v);
 Json ToJson(const SctpAssociation &v);
 Json ToJson(const ServedGuami &v);
 Json ToJson(const Guami &v);
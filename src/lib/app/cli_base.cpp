@@ -8,16 +8,35 @@
 
 #include "cli_base.hpp"
 
+#include <cctype>
+
+#include <fnmatch.h>
+
+#include <utils/common.hpp>
+#include <utils/json.hpp>
 #include <utils/octet_string.hpp>
 #include <utils/octet_view.hpp>
 
-#define CMD_BUFFER_SIZE 8192
+#define CMD_BUFFER_SIZE 65536
 #define CMD_RCV_TIMEOUT 2500
-#define CMD_MIN_LENGTH (3 + 4 + 4 + 1)
+#define CMD_MIN_LENGTH (3 + 1 + 2 + 4 + 4)
+#define CMD_MAX_CHUNK_SIZE 32768
+#define CMD_SOCKET_RCV_BUFFER (4 * 1024 * 1024)
+#define BULK_TIMEOUT 10000
+
+static const int TIMER_ID_BULK_TIMEOUT = 1;
+static const int TIMER_PERIOD_BULK_TIMEOUT = 1000;
 
 namespace app
 {
 
+CliServer::CliServer()
+    : m_socket{Socket::CreateAndBindUdp({cons::CMD_SERVER_IP, 0})}, m_buffer(CMD_BUFFER_SIZE), m_chunked{}, m_sendMutex{}
+{
+    // Chunks of a large message arrive in a burst, the kernel may cap this to its own limit
+    m_socket.setReceiveBufferSize(CMD_SOCKET_RCV_BUFFER);
+}
+
 InetAddress CliServer::assignedAddress() const
 {
     return m_socket.getAddress();
@@ -25,14 +44,13 @@ InetAddress CliServer::assignedAddress() const
 
 CliMessage CliServer::receiveMessage()
 {
-    uint8_t buffer[CMD_BUFFER_SIZE] = {0};
     InetAddress address;
 
-    int size = m_socket.receive(buffer, CMD_BUFFER_SIZE, CMD_RCV_TIMEOUT, address);
+    int size = m_socket.receive(m_buffer.data(), CMD_BUFFER_SIZE, CMD_RCV_TIMEOUT, address);
     if (size < CMD_MIN_LENGTH || size >= CMD_BUFFER_SIZE)
         return {};
 
-    OctetView v{buffer, static_cast<size_t>(size)};
+    OctetView v{m_buffer.data(), static_cast<size_t>(size)};
     if (v.readI() != cons::Major)
         return {};
     if (v.readI() != cons::Minor)
@@ -42,29 +60,228 @@ CliMessage CliServer::receiveMessage()
 
     CliMessage res{};
     res.type = static_cast<CliMessage::Type>(v.readI());
+    int chunkIndex = v.read2I();
     int nodeNameLength = v.read4I();
     res.nodeName = v.readUtf8String(nodeNameLength);
     int valueLength = v.read4I();
     res.value = v.readUtf8String(valueLength);
     res.clientAddr = address;
+
+    if (v.hasError())
+        return {};
+
+    if (res.type == CliMessage::Type::CHUNK)
+    {
+        auto &chunked = m_chunked[address.toString()];
+        if (chunkIndex == 0)
+            chunked = {};
+        if (chunkIndex != chunked.chunkCount)
+            chunked.isBroken = true;
+
+        chunked.value += res.value;
+        chunked.chunkCount++;
+        return {};
+    }
+
+    auto it = m_chunked.find(address.toString());
+    if (it == m_chunked.end())
+    {
+        if (chunkIndex != 0)
+            return CliMessage::Error(address, "Message is incomplete, some parts of it are lost", res.nodeName);
+        return res;
+    }
+
+    auto chunked = std::move(it->second);
+    m_chunked.erase(it);
+
+    if (chunked.isBroken || chunkIndex != chunked.chunkCount)
+        return CliMessage::Error(address, "Message is incomplete, some parts of it are lost", res.nodeName);
+
+    res.value = std::move(chunked.value) + res.value;
     return res;
 }
 
 void CliServer::sendMessage(const CliMessage &msg)
+{
+    // Chunks of concurrently sent messages must not interleave
+    std::lock_guard<std::mutex> lock(m_sendMutex);
+
+    size_t offset = 0;
+    int chunkIndex = 0;
+
+    while (msg.value.size() - offset > CMD_MAX_CHUNK_SIZE)
+    {
+        sendDatagram(CliMessage::Type::CHUNK, msg.nodeName, msg.value.data() + offset, CMD_MAX_CHUNK_SIZE,
+                     chunkIndex, msg.clientAddr);
+        offset += CMD_MAX_CHUNK_SIZE;
+        chunkIndex++;
+    }
+
+    sendDatagram(msg.type, msg.nodeName, msg.value.data() + offset, msg.value.size() - offset, chunkIndex,
+                 msg.clientAddr);
+}
+
+void CliServer::sendDatagram(CliMessage::Type type, const std::string &nodeName, const char *value,
+                             size_t valueLength, int chunkIndex, const InetAddress &address)
 {
     OctetString stream{};
     stream.appendOctet(cons::Major);
     stream.appendOctet(cons::Minor);
     stream.appendOctet(cons::Patch);
-    stream.appendOctet(static_cast<int>(msg.type));
-    stream.appendOctet4(static_cast<int>(msg.nodeName.size()));
-    for (char c : msg.nodeName)
-        stream.appendOctet(static_cast<uint8_t>(c));
-    stream.appendOctet4(static_cast<int>(msg.value.size()));
-    for (char c : msg.value)
+    stream.appendOctet(static_cast<int>(type));
+    stream.appendOctet2(chunkIndex);
+    stream.appendOctet4(static_cast<int>(nodeName.size()));
+    for (char c : nodeName)
         stream.appendOctet(static_cast<uint8_t>(c));
+    stream.appendOctet4(static_cast<int>(valueLength));
+    for (size_t i = 0; i < valueLength; i++)
+        stream.appendOctet(static_cast<uint8_t>(value[i]));
+
+    m_socket.send(address, stream.data(), static_cast<size_t>(stream.length()));
+}
+
+bool IsNodeSelector(const std::string &value)
+{
+    return value.find_first_of("*?[") != std::string::npos || value.find("..") != std::string::npos;
+}
+
+bool MatchesNodeSelector(const std::string &selector, const std::string &nodeName)
+{
+    size_t rangePos = selector.find("..");
+    if (rangePos == std::string::npos)
+        return ::fnmatch(selector.c_str(), nodeName.c_str(), 0) == 0;
+
+    std::string first = selector.substr(0, rangePos);
+    std::string last = selector.substr(rangePos + 2);
+    if (first.size() != last.size() || nodeName.size() != first.size())
+        return false;
+
+    // Both ends share a prefix, and only the numeric part after that prefix varies in the range
+    size_t prefix = 0;
+    while (prefix < first.size() && first[prefix] == last[prefix])
+        prefix++;
+    if (nodeName.compare(0, prefix, first, 0, prefix) != 0)
+        return false;
+    for (size_t i = prefix; i < nodeName.size(); i++)
+        if (!std::isdigit(static_cast<unsigned char>(nodeName[i])))
+            return false;
+
+    // Same length digit strings compare lexicographically as numbers
+    return first <= nodeName && nodeName <= last;
+}
+
+void CliResponseTask::onStart()
+{
+}
+
+void CliResponseTask::onLoop()
+{
+    auto msg = take();
+    if (msg == nullptr)
+        return;
+
+    switch (msg->msgType)
+    {
+    case NtsMessageType::CLI_SEND_RESPONSE:
+        receiveResponse(dynamic_cast<NwCliSendResponse &>(*msg));
+        break;
+    case NtsMessageType::CLI_BULK_BEGIN:
+        receiveBulkBegin(dynamic_cast<NwCliBulkBegin &>(*msg));
+        break;
+    case NtsMessageType::TIMER_EXPIRED:
+        if (dynamic_cast<NmTimerExpired &>(*msg).timerId == TIMER_ID_BULK_TIMEOUT)
+            checkBulkTimeouts();
+        break;
+    default:
+        break;
+    }
+}
+
+void CliResponseTask::onQuit()
+{
+}
+
+void CliResponseTask::receiveResponse(NwCliSendResponse &msg)
+{
+    auto it = bulkJobs.find(msg.address.toString());
+    if (it == bulkJobs.end() || it->second.pending.erase(msg.nodeName) == 0)
+    {
+        cliServer->sendMessage(msg.isError ? CliMessage::Error(msg.address, msg.output)
+                                           : CliMessage::Result(msg.address, msg.output));
+        return;
+    }
+
+    auto &job = it->second;
+    if (msg.isError)
+        job.failed++;
+    else
+        job.succeeded++;
+
+    int64_t elapsed = utils::CurrentTimeMillis() - job.startTime;
+    std::string output = "[" + msg.nodeName + "] " + (msg.isError ? "error" : "ok") + " (" + std::to_string(elapsed) +
+                         " ms)";
+    if (!msg.output.empty())
+        output += "\n" + msg.output;
+    cliServer->sendMessage(CliMessage::PartialResult(job.address, std::move(output), msg.nodeName));
+
+    if (job.pending.empty())
+    {
+        finishBulkJob(job);
+        bulkJobs.erase(it);
+    }
+}
+
+void CliResponseTask::receiveBulkBegin(NwCliBulkBegin &msg)
+{
+    BulkJob job{};
+    job.address = msg.address;
+    job.startTime = utils::CurrentTimeMillis();
+    job.nodeCount = static_cast<int>(msg.nodes.size());
+    job.pending = std::unordered_set<std::string>(msg.nodes.begin(), msg.nodes.end());
+
+    // A previous job of the same client is superseded, the client does not wait for it anymore
+    bulkJobs[msg.address.toString()] = std::move(job);
+
+    if (!bulkTimerArmed)
+    {
+        bulkTimerArmed = true;
+        setTimer(TIMER_ID_BULK_TIMEOUT, TIMER_PERIOD_BULK_TIMEOUT);
+    }
+}
+
+void CliResponseTask::checkBulkTimeouts()
+{
+    int64_t currentTime = utils::CurrentTimeMillis();
+
+    for (auto it = bulkJobs.begin(); it != bulkJobs.end();)
+    {
+        if (currentTime - it->second.startTime >= BULK_TIMEOUT)
+        {
+            finishBulkJob(it->second);
+            it = bulkJobs.erase(it);
+        }
+        else
+            ++it;
+    }
+
+    bulkTimerArmed = !bulkJobs.empty();
+    if (bulkTimerArmed)
+        setTimer(TIMER_ID_BULK_TIMEOUT, TIMER_PERIOD_BULK_TIMEOUT);
+}
+
+void CliResponseTask::finishBulkJob(BulkJob &job)
+{
+    for (auto &node : job.pending)
+        cliServer->sendMessage(CliMessage::PartialResult(job.address, "[" + node + "] timeout", node));
 
-    m_socket.send(msg.clientAddr, stream.data(), static_cast<size_t>(stream.length()));
+    Json summary = Json::Obj({
+        {"nodes", job.nodeCount},
+        {"succeeded", job.succeeded},
+        {"failed", job.failed},
+        {"timed-out", static_cast<int>(job.pending.size())},
+        {"elapsed-ms", utils::CurrentTimeMillis() - job.startTime},
+    });
+    cliServer->sendMessage(CliMessage::Result(job.address, summary.dumpYaml()));
 }
 
 } // namespace app
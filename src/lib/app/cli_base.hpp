@@ -8,7 +8,10 @@
 
 #pragma once
 
+#include <mutex>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -28,7 +31,10 @@ struct CliMessage
         ECHO,
         ERROR,
         RESULT,
-        COMMAND
+        COMMAND,
+        PARTIAL_RESULT,
+        // A leading part of a message that does not fit into a single datagram
+        CHUNK
     } type{};
 
     std::string nodeName{};
@@ -55,6 +61,16 @@ struct CliMessage
         return m;
     }
 
+    static CliMessage PartialResult(InetAddress addr, std::string msg, std::string node)
+    {
+        CliMessage m{};
+        m.type = Type::PARTIAL_RESULT;
+        m.value = std::move(msg);
+        m.nodeName = std::move(node);
+        m.clientAddr = addr;
+        return m;
+    }
+
     static CliMessage Echo(InetAddress addr, std::string msg)
     {
         CliMessage m{};
@@ -76,15 +92,29 @@ struct CliMessage
     }
 };
 
+/*
+ * A message larger than a datagram is sent as a series of CHUNK datagrams followed by the datagram of the actual
+ * message type. Each datagram carries its chunk index, so a lost chunk is detected instead of silently truncating the
+ * message.
+ */
 class CliServer
 {
+  private:
+    struct ChunkedMessage
+    {
+        std::string value{};
+        int chunkCount{};
+        bool isBroken{};
+    };
+
   private:
     Socket m_socket;
+    std::vector<uint8_t> m_buffer;
+    std::unordered_map<std::string, ChunkedMessage> m_chunked; // by sender address
+    std::mutex m_sendMutex;
 
   public:
-    explicit CliServer() : m_socket{Socket::CreateAndBindUdp({cons::CMD_SERVER_IP, 0})}
-    {
-    }
+    explicit CliServer();
 
     ~CliServer()
     {
@@ -95,51 +125,80 @@ class CliServer
 
     CliMessage receiveMessage();
     void sendMessage(const CliMessage &msg);
+
+  private:
+    void sendDatagram(CliMessage::Type type, const std::string &nodeName, const char *value, size_t valueLength,
+                      int chunkIndex, const InetAddress &address);
 };
 
+/*
+ * A node selector addresses multiple nodes with a single command:
+ *  - "*" or a glob pattern, e.g. "imsi-00101*"
+ *  - an inclusive range of node names with a numeric suffix, e.g. "imsi-001010000000001..imsi-001010000000100"
+ */
+bool IsNodeSelector(const std::string &value);
+bool MatchesNodeSelector(const std::string &selector, const std::string &nodeName);
+
 struct NwCliSendResponse : NtsMessage
 {
     InetAddress address{};
     std::string output{};
     bool isError{};
+    std::string nodeName{};
 
-    NwCliSendResponse(const InetAddress &address, std::string output, bool isError)
-        : NtsMessage(NtsMessageType::CLI_SEND_RESPONSE), address(address), output(std::move(output)), isError(isError)
+    NwCliSendResponse(const InetAddress &address, std::string output, bool isError, std::string nodeName = "")
+        : NtsMessage(NtsMessageType::CLI_SEND_RESPONSE), address(address), output(std::move(output)), isError(isError),
+          nodeName(std::move(nodeName))
+    {
+    }
+};
+
+// Sent before a command is dispatched to the nodes matched by a selector, so that the responses of those nodes are
+// streamed to the client one by one, and followed by a summary once all of them responded.
+struct NwCliBulkBegin : NtsMessage
+{
+    InetAddress address{};
+    std::vector<std::string> nodes{};
+
+    NwCliBulkBegin(const InetAddress &address, std::vector<std::string> nodes)
+        : NtsMessage(NtsMessageType::CLI_BULK_BEGIN), address(address), nodes(std::move(nodes))
     {
     }
 };
 
 class CliResponseTask : public NtsTask
 {
+  private:
+    struct BulkJob
+    {
+        InetAddress address{};
+        int64_t startTime{};
+        int nodeCount{};
+        std::unordered_set<std::string> pending{};
+        int succeeded{};
+        int failed{};
+    };
+
   private:
     app::CliServer *cliServer;
+    std::unordered_map<std::string, BulkJob> bulkJobs; // by client address
+    bool bulkTimerArmed;
 
   public:
-    explicit CliResponseTask(CliServer *cliServer) : cliServer(cliServer)
+    explicit CliResponseTask(CliServer *cliServer) : cliServer(cliServer), bulkJobs{}, bulkTimerArmed{}
     {
     }
 
   protected:
-    void onStart() override
-    {
-    }
-
-    void onLoop() override
-    {
-        auto msg = take();
-        if (msg == nullptr)
-            return;
-        if (msg->msgType == NtsMessageType::CLI_SEND_RESPONSE)
-        {
-            auto& w = dynamic_cast<NwCliSendResponse &>(*msg);
-            cliServer->sendMessage(w.isError ? CliMessage::Error(w.address, w.output)
-                                             : CliMessage::Result(w.address, w.output));
-        }
-    }
+    void onStart() override;
+    void onLoop() override;
+    void onQuit() override;
 
-    void onQuit() override
-    {
-    }
+  private:
+    void receiveResponse(NwCliSendResponse &msg);
+    void receiveBulkBegin(NwCliBulkBegin &msg);
+    void checkBulkTimeouts();
+    void finishBulkJob(BulkJob &job);
 };
 
 } // namespace app
@@ -152,6 +152,8 @@ static OrderedMap<std::string, CmdEntry> g_gnbCmdEntries = {
     {"ue-list", {"List all UEs associated with the gNB", "", DefaultDesc, false}},
     {"ue-count", {"Print the total number of UEs connected the this gNB", "", DefaultDesc, false}},
     {"ue-release", {"Request a UE context release for the given UE", "<ue-id>", DefaultDesc, false}},
+    {"gtp-paths", {"Show latency, jitter and loss of the GTP-U paths towards the UPFs", "", DefaultDesc, false}},
+    {"qos-monitoring", {"Show packet delay histograms of the QoS monitored flows", "", DefaultDesc, false}},
 };
 
 static OrderedMap<std::string, CmdEntry> g_ueCmdEntries = {
@@ -160,6 +162,7 @@ static OrderedMap<std::string, CmdEntry> g_ueCmdEntries = {
     {"timers", {"Dump current status of the timers in the UE", "", DefaultDesc, false}},
     {"rls-state", {"Show status information about RLS", "", DefaultDesc, false}},
     {"coverage", {"Dump available cells and PLMNs in the coverage", "", DefaultDesc, false}},
+    {"memory", {"Show an estimate of the memory used by the UE", "", DefaultDesc, false}},
     {"ps-establish",
      {"Trigger a PDU session establishment procedure", "<session-type> [options]", DescForPsEstablish, true}},
     {"ps-list", {"List all PDU sessions", "", DefaultDesc, false}},
@@ -216,6 +219,14 @@ static std::unique_ptr<GnbCliCommand> GnbCliParseImpl(const std::string &subCmd,
             CMD_ERR("Invalid UE ID")
         return cmd;
     }
+    else if (subCmd == "gtp-paths")
+    {
+        return std::make_unique<GnbCliCommand>(GnbCliCommand::GTP_PATHS);
+    }
+    else if (subCmd == "qos-monitoring")
+    {
+        return std::make_unique<GnbCliCommand>(GnbCliCommand::QOS_MONITORING);
+    }
 
     return nullptr;
 }
@@ -331,6 +342,10 @@ static std::unique_ptr<UeCliCommand> UeCliParseImpl(const std::string &subCmd, c
     {
         return std::make_unique<UeCliCommand>(UeCliCommand::COVERAGE);
     }
+    else if (subCmd == "memory")
+    {
+        return std::make_unique<UeCliCommand>(UeCliCommand::MEMORY);
+    }
 
     return nullptr;
 }
@@ -29,6 +29,8 @@ struct GnbCliCommand
         UE_LIST,
         UE_COUNT,
         UE_RELEASE_REQ,
+        GTP_PATHS,
+        QOS_MONITORING,
     } present;
 
     // AMF_INFO
@@ -56,6 +58,7 @@ struct UeCliCommand
         DE_REGISTER,
         RLS_STATE,
         COVERAGE,
+        MEMORY,
     } present;
 
     // DE_REGISTER
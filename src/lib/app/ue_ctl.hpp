@@ -8,6 +8,10 @@
 
 #pragma once
 
+#include <vector>
+
+#include <utils/common_types.hpp>
+
 namespace nr::ue
 {
 
@@ -22,6 +26,8 @@ class IUeController
 {
   public:
     virtual void performSwitchOff(nr::ue::UserEquipment *ue) = 0;
+    virtual void performHibernation(nr::ue::UserEquipment *ue) = 0;
+    virtual void performPaging(std::vector<GutiMobileIdentity> &&tmsiIds) = 0;
 };
 
 } // namespace app
@@ -114,16 +114,12 @@ octet4 GetOctet4(const OCTET_STRING_t &source)
 
 OctetString GetOctetString(const OCTET_STRING_t &source)
 {
-    std::vector<uint8_t> v(source.size);
-    std::memcpy(v.data(), source.buf, source.size);
-    return OctetString{std::move(v)};
+    return OctetString::FromArray(source.buf, source.size);
 }
 
 OctetString GetOctetString(const BIT_STRING_t &source)
 {
-    std::vector<uint8_t> v(source.size);
-    std::memcpy(v.data(), source.buf, source.size);
-    return OctetString{std::move(v)};
+    return OctetString::FromArray(source.buf, source.size);
 }
 
 uint64_t GetUnsigned64(const INTEGER_t &source)
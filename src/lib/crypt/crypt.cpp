@@ -58,9 +58,9 @@ OctetString CalculatePrfPrime(const OctetString &key, const OctetString &input,
 
 OctetString HmacSha256(const OctetString &key, const OctetString &input)
 {
-    std::vector<uint8_t> out(32);
+    OctetString out = OctetString::FromSpare(32);
     HmacSha256(out.data(), input.data(), input.length(), key.data(), key.length());
-    return OctetString{std::move(out)};
+    return out;
 }
 
 OctetString CalculateKdfKey(const OctetString &key, int fc, OctetString *parameters, int numberOfParameter)
@@ -94,7 +94,7 @@ OctetString EncodeKdfString(const std::string &string)
     // V16.0.0 - B.2.1.2 Character string encoding
     // A character string shall be encoded to an octet string according to UTF-8 encoding rules as specified in
     // IETF RFC 3629 [24] and apply Normalization Form KC (NFKC) as specified in [37].
-    return OctetString{std::vector<uint8_t>{string.c_str(), string.c_str() + string.length()}};
+    return OctetString::FromAscii(string);
 }
 
 std::vector<uint32_t> Snow3g(const OctetString &key, const OctetString &iv, int length)
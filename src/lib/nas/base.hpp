@@ -142,7 +142,8 @@ static inline T DecodeIe4(const OctetView &stream)
 {
     static_assert(std::is_base_of<InformationElement4, T>::value);
 
-    return T::Decode(stream, stream.readI());
+    int length = stream.readI();
+    return T::Decode(stream.readView(length), length);
 }
 
 //======================================================================================================
@@ -166,7 +167,9 @@ template <typename T>
 static inline T DecodeIe6(const OctetView &stream)
 {
     static_assert(std::is_base_of<InformationElement6, T>::value);
-    return T::Decode(stream, stream.read2I());
+
+    int length = stream.read2I();
+    return T::Decode(stream.readView(length), length);
 }
 
 //======================================================================================================
@@ -212,7 +215,7 @@ template <typename T>
 static inline bool DecodeListIe(const OctetView &stream, int length, std::vector<T> &output)
 {
     size_t readLen = 0;
-    while (readLen < static_cast<size_t>(length))
+    while (readLen < static_cast<size_t>(length) && !stream.hasError())
     {
         size_t streamIndex = stream.currentIndex();
         output.push_back(DecodeIe2346<T>(stream));
@@ -227,7 +230,7 @@ template <typename T>
 static inline bool DecodeListVal(const OctetView &stream, int length, std::vector<T> &output)
 {
     size_t readLen = 0;
-    while (readLen < static_cast<size_t>(length))
+    while (readLen < static_cast<size_t>(length) && !stream.hasError())
     {
         size_t streamIndex = stream.currentIndex();
         output.push_back(T::Decode(stream));
@@ -167,6 +167,7 @@ class Eap
     const EEapType eapType;
 
     Eap(ECode code, octet id, EEapType eapType);
+    virtual ~Eap() = default;
 };
 
 class EapAkaPrime : public Eap
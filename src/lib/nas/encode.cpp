@@ -8,6 +8,7 @@
 
 #include "encode.hpp"
 
+#include <memory>
 #include <stdexcept>
 
 namespace nas
@@ -16,13 +17,8 @@ namespace nas
 template <typename T>
 static void EncodeViaBuilder(T &msg, OctetString &stream)
 {
-    NasMessageBuilder builder{};
-    msg.onBuild(builder);
-
-    for (auto &f : builder.mandatoryEncoders)
-        f(stream);
-    for (auto &f : builder.optionalEncoders)
-        f(stream);
+    NasMessageEncoder encoder{stream};
+    msg.onBuild(encoder);
 }
 
 static void EncodeMm(PlainMmMessage &msg, OctetString &stream)
@@ -190,6 +186,7 @@ static void EncodeSm(SmMessage &msg, OctetString &stream)
 
 void EncodeNasMessage(const NasMessage &msg, OctetString &stream)
 {
+    stream.reserveEncodeBuffer();
     stream.appendOctet(static_cast<int>(msg.epd));
     if (msg.epd == EExtendedProtocolDiscriminator::MOBILITY_MANAGEMENT_MESSAGES)
     {
@@ -214,29 +211,40 @@ static SecuredMmMessage *DecodeSecuredMmMessage(const OctetView &stream, ESecuri
     return p;
 }
 
+template <typename T>
+static NasIeTable BuildIeTable()
+{
+    NasIeTable table{};
+    T prototype{};
+    NasIeTableBuilder builder{&prototype, table};
+    prototype.onBuild(builder);
+    return table;
+}
+
 template <typename T>
 static T *DecodeViaBuilder(const OctetView &stream)
 {
-    T *p = new T();
+    static const NasIeTable table = BuildIeTable<T>();
 
-    NasMessageBuilder builder{};
-    p->onBuild(builder);
+    auto p = std::make_unique<T>();
 
-    for (auto &f : builder.mandatoryDecoders)
-        f(stream);
+    NasMessageDecoder decoder{stream};
+    p->onBuild(decoder);
 
     while (stream.hasNext())
     {
         int iei = stream.peekI();
-        if (builder.optionalDecoders.count(iei))
-            builder.optionalDecoders[iei](stream);
-        else if (builder.optionalDecoders.count((iei >> 4) & 0xF))
-            builder.optionalDecoders[(iei >> 4) & 0xF](stream);
-        else
+
+        auto *entry = &table.full[iei];
+        if (entry->decode == nullptr)
+            entry = &table.half[(iei >> 4) & 0xF];
+        if (entry->decode == nullptr)
             throw std::runtime_error("Bad constructed NAS message");
+
+        entry->decode(reinterpret_cast<uint8_t *>(p.get()) + entry->offset, stream);
     }
 
-    return p;
+    return p.release();
 }
 
 static PlainMmMessage *DecodePlainMmMessage(const OctetView &stream, EMessageType messageType)
@@ -345,7 +353,7 @@ static SmMessage *DecodeSmMessage(const OctetView &stream, EMessageType messageT
     }
 }
 
-std::unique_ptr<NasMessage> DecodeNasMessage(const OctetView &stream)
+static std::unique_ptr<NasMessage> DecodeMessage(const OctetView &stream)
 {
     auto epd = static_cast<EExtendedProtocolDiscriminator>(stream.readI());
     if (epd == EExtendedProtocolDiscriminator::MOBILITY_MANAGEMENT_MESSAGES)
@@ -384,4 +392,14 @@ std::unique_ptr<NasMessage> DecodeNasMessage(const OctetView &stream)
     }
 }
 
+std::unique_ptr<NasMessage> DecodeNasMessage(const OctetView &stream)
+{
+    auto msg = DecodeMessage(stream);
+
+    // Truncated messages and IEs exceeding their length are rejected as a whole
+    if (stream.hasError())
+        return nullptr;
+    return msg;
+}
+
 } // namespace nas
@@ -705,8 +705,8 @@ IENetworkName IENetworkName::Decode(const OctetView &stream, int length)
 
 void IENetworkName::Encode(const IENetworkName &ie, OctetString &stream)
 {
-    bits::Ranged8(
-        {{1, 0}, {3, static_cast<int>(ie.codingScheme)}, {1, static_cast<int>(ie.addCi)}, {3, ie.numOfSpareBits}});
+    stream.appendOctet(bits::Ranged8(
+        {{1, 0}, {3, static_cast<int>(ie.codingScheme)}, {1, static_cast<int>(ie.addCi)}, {3, ie.numOfSpareBits}}));
     stream.append(ie.textString);
 }
 
@@ -17,63 +17,174 @@
 namespace nas
 {
 
-struct NasMessageBuilder
+/*
+ * The IEs of each message are listed once in its onBuild() method, which is instantiated for both of the codecs below.
+ * Hence every message gets its own encoder and decoder at compile time, and no allocation is needed for the codec.
+ */
+class NasMessageEncoder
 {
-    std::vector<std::function<void(OctetString &)>> mandatoryEncoders{};
-    std::vector<std::function<void(OctetString &)>> optionalEncoders{};
+  private:
+    OctetString &m_stream;
 
-    std::vector<std::function<void(const OctetView &)>> mandatoryDecoders{};
-    std::unordered_map<int, std::function<void(const OctetView &)>> optionalDecoders{};
+  public:
+    explicit NasMessageEncoder(OctetString &stream) : m_stream(stream)
+    {
+    }
 
     template <typename T>
     inline void mandatoryIE(T *ptr)
     {
-        mandatoryEncoders.push_back([ptr](OctetString &stream) { Encode2346(*ptr, stream); });
-        mandatoryDecoders.push_back([ptr](const OctetView &stream) { *ptr = DecodeIe2346<T>(stream); });
+        Encode2346(*ptr, m_stream);
     }
 
     template <typename T>
     inline void mandatoryIE1(T *ptr)
     {
-        mandatoryEncoders.push_back([ptr](OctetString &stream) { EncodeIe1(0, *ptr, stream); });
-        mandatoryDecoders.push_back([ptr](const OctetView &stream) { *ptr = DecodeIe1<T>(stream); });
+        EncodeIe1(0, *ptr, m_stream);
     }
 
     template <typename T, typename U>
     inline void mandatoryIE1(T *ptr1, U *ptr2)
     {
-        mandatoryEncoders.push_back([ptr1, ptr2](OctetString &stream) { EncodeIe1(*ptr1, *ptr2, stream); });
-        mandatoryDecoders.push_back([ptr1, ptr2](const OctetView &stream) {
-            int octet = stream.readI();
-            *ptr1 = T::Decode((octet >> 4) & 0xF);
-            *ptr2 = U::Decode(octet & 0xF);
-        });
+        EncodeIe1(*ptr1, *ptr2, m_stream);
+    }
+
+    template <typename T>
+    inline void optionalIE(int iei, std::optional<T> *ptr)
+    {
+        if (ptr->has_value())
+        {
+            m_stream.appendOctet(iei);
+            Encode2346(ptr->value(), m_stream);
+        }
+    }
+
+    template <typename T>
+    inline void optionalIE1(int iei, std::optional<T> *ptr)
+    {
+        if (ptr->has_value())
+            EncodeIe1(iei, ptr->value(), m_stream);
+    }
+};
+
+/*
+ * Decodes the mandatory IEs in a single pass. Optional IEs are ignored here, they are dispatched through the IEI table
+ * of the message instead.
+ */
+class NasMessageDecoder
+{
+  private:
+    const OctetView &m_stream;
+
+  public:
+    explicit NasMessageDecoder(const OctetView &stream) : m_stream(stream)
+    {
+    }
+
+    template <typename T>
+    inline void mandatoryIE(T *ptr)
+    {
+        *ptr = DecodeIe2346<T>(m_stream);
+    }
+
+    template <typename T>
+    inline void mandatoryIE1(T *ptr)
+    {
+        *ptr = DecodeIe1<T>(m_stream);
+    }
+
+    template <typename T, typename U>
+    inline void mandatoryIE1(T *ptr1, U *ptr2)
+    {
+        int octet = m_stream.readI();
+        *ptr1 = T::Decode((octet >> 4) & 0xF);
+        *ptr2 = U::Decode(octet & 0xF);
+    }
+
+    template <typename T>
+    inline void optionalIE(int, std::optional<T> *)
+    {
+    }
+
+    template <typename T>
+    inline void optionalIE1(int, std::optional<T> *)
+    {
+    }
+};
+
+/*
+ * Maps each IEI of a message to the decoder of the corresponding optional IE. Full octet IEIs and half octet (type 1)
+ * IEIs are kept in separate slots, the IE is located by its offset from the start of the message.
+ */
+struct NasIeTable
+{
+    struct Entry
+    {
+        void (*decode)(void *ie, const OctetView &stream){};
+        size_t offset{};
+    };
+
+    Entry full[256]{};
+    Entry half[16]{};
+};
+
+/*
+ * Fills the IEI table of a message by running its onBuild() method once over a prototype instance.
+ */
+class NasIeTableBuilder
+{
+  private:
+    const void *m_base;
+    NasIeTable &m_table;
+
+    template <typename T>
+    static void DecodeOptional(void *ie, const OctetView &stream)
+    {
+        stream.readI();
+        *reinterpret_cast<std::optional<T> *>(ie) = DecodeIe2346<T>(stream);
+    }
+
+    template <typename T>
+    static void DecodeOptional1(void *ie, const OctetView &stream)
+    {
+        *reinterpret_cast<std::optional<T> *>(ie) = DecodeIe1<T>(stream);
+    }
+
+    [[nodiscard]] inline size_t offsetOf(const void *ptr) const
+    {
+        return static_cast<size_t>(reinterpret_cast<const uint8_t *>(ptr) - reinterpret_cast<const uint8_t *>(m_base));
+    }
+
+  public:
+    NasIeTableBuilder(const void *base, NasIeTable &table) : m_base(base), m_table(table)
+    {
+    }
+
+    template <typename T>
+    inline void mandatoryIE(T *)
+    {
+    }
+
+    template <typename T>
+    inline void mandatoryIE1(T *)
+    {
+    }
+
+    template <typename T, typename U>
+    inline void mandatoryIE1(T *, U *)
+    {
     }
 
     template <typename T>
     inline void optionalIE(int iei, std::optional<T> *ptr)
     {
-        optionalEncoders.push_back([ptr, iei](OctetString &stream) {
-            if (ptr->has_value())
-            {
-                stream.appendOctet(iei);
-                Encode2346(ptr->value(), stream);
-            }
-        });
-        optionalDecoders[iei] = [ptr](const OctetView &stream) {
-            stream.readI();
-            *ptr = DecodeIe2346<T>(stream);
-        };
+        m_table.full[iei & 0xFF] = {&DecodeOptional<T>, offsetOf(ptr)};
     }
 
     template <typename T>
     inline void optionalIE1(int iei, std::optional<T> *ptr)
     {
-        optionalEncoders.push_back([ptr, iei](OctetString &stream) {
-            if (ptr->has_value())
-                EncodeIe1(iei, ptr->value(), stream);
-        });
-        optionalDecoders[iei] = [ptr](const OctetView &stream) { *ptr = DecodeIe1<T>(stream); };
+        m_table.half[iei & 0xF] = {&DecodeOptional1<T>, offsetOf(ptr)};
     }
 };
 
@@ -129,7 +240,8 @@ struct AuthenticationFailure : PlainMmMessage
     std::optional<IEAuthenticationFailureParameter> authenticationFailureParameter{};
 
     AuthenticationFailure();
-    void onBuild(NasMessageBuilder &b);
+    template <typename Builder>
+    void onBuild(Builder &b);
 };
 
 struct AuthenticationReject : PlainMmMessage
@@ -137,7 +249,8 @@ struct AuthenticationReject : PlainMmMessage
     std::optional<IEEapMessage> eapMessage{};
 
     AuthenticationReject();
-    void onBuild(NasMessageBuilder &b);
+    template <typename Builder>
+    void onBuild(Builder &b);
 };
 
 struct AuthenticationRequest : PlainMmMessage
@@ -149,7 +262,8 @@ struct AuthenticationRequest : PlainMmMessage
     std::optional<IEEapMessage> eapMessage{};
 
     AuthenticationRequest();
-    void onBuild(NasMessageBuilder &b);
+    template <typename Builder>
+    void onBuild(Builder &b);
 };
 
 struct AuthenticationResponse : PlainMmMessage
@@ -158,7 +272,8 @@ struct AuthenticationResponse : PlainMmMessage
     std::optional<IEEapMessage> eapMessage{};
 
     AuthenticationResponse();
-    void onBuild(NasMessageBuilder &b);
+    template <typename Builder>
+    void onBuild(Builder &b);
 };
 
 struct AuthenticationResult : PlainMmMessage
@@ -168,7 +283,8 @@ struct AuthenticationResult : PlainMmMessage
     std::optional<IEAbba> abba{};
 
     AuthenticationResult();
-    void onBuild(NasMessageBuilder &b);
+    template <typename Builder>
+    void onBuild(Builder &b);
 };
 
 struct ConfigurationUpdateCommand : PlainMmMessage
@@ -192,25 +308,29 @@ struct ConfigurationUpdateCommand : PlainMmMessage
     std::optional<IESmsIndication> smsIndication{};
 
     ConfigurationUpdateCommand();
-    void onBuild(NasMessageBuilder &b);
+    template <typename Builder>
+    void onBuild(Builder &b);
 };
 
 struct ConfigurationUpdateComplete : PlainMmMessage
 {
     ConfigurationUpdateComplete();
-    void onBuild(NasMessageBuilder &b);
+    template <typename Builder>
+    void onBuild(Builder &b);
 };
 
 struct DeRegistrationAcceptUeOriginating : PlainMmMessage
 {
     DeRegistrationAcceptUeOriginating();
-    void onBuild(NasMessageBuilder &b);
+    template <typename Builder>
+    void onBuild(Builder &b);
 };
 
 struct DeRegistrationAcceptUeTerminated : PlainMmMessage
 {
     DeRegistrationAcceptUeTerminated();
-    void onBuild(NasMessageBuilder &b);
+    template <typename Builder>
+    void onBuild(Builder &b);
 };
 
 struct DeRegistrationRequestUeOriginating : PlainMmMessage
@@ -220,7 +340,8 @@ struct DeRegistrationRequestUeOriginating : PlainMmMessage
     IE5gsMobileIdentity mobileIdentity{};
 
     DeRegistrationRequestUeOriginating();
-    void onBuild(NasMessageBuilder &b);
+    template <typename Builder>
+    void onBuild(Builder &b);
 };
 
 struct DeRegistrationRequestUeTerminated : PlainMmMessage
@@ -230,7 +351,8 @@ struct DeRegistrationRequestUeTerminated : PlainMmMessage
     std::optional<IEGprsTimer2> t3346Value{};
 
     DeRegistrationRequestUeTerminated();
-    void onBuild(NasMessageBuilder &b);
+    template <typename Builder>
+    void onBuild(Builder &b);
 };
 
 struct DlNasTransport : PlainMmMessage
@@ -243,7 +365,8 @@ struct DlNasTransport : PlainMmMessage
     std::optional<IEGprsTimer3> backOffTimerValue{};
 
     DlNasTransport();
-    void onBuild(NasMessageBuilder &b);
+    template <typename Builder>
+    void onBuild(Builder &b);
 };
 
 struct FiveGMmStatus : PlainMmMessage
@@ -251,7 +374,8 @@ struct FiveGMmStatus : PlainMmMessage
     IE5gMmCause mmCause{};
 
     FiveGMmStatus();
-    void onBuild(NasMessageBuilder &b);
+    template <typename Builder>
+    void onBuild(Builder &b);
 };
 
 struct FiveGSmStatus : SmMessage
@@ -259,7 +383,8 @@ struct FiveGSmStatus : SmMessage
     IE5gSmCause smCause{};
 
     FiveGSmStatus();
-    void onBuild(NasMessageBuilder &b);
+    template <typename Builder>
+    void onBuild(Builder &b);
 };
 
 struct IdentityRequest : PlainMmMessage
@@ -267,7 +392,8 @@ struct IdentityRequest : PlainMmMessage
     IE5gsIdentityType identityType{};
 
     IdentityRequest();
-    void onBuild(NasMessageBuilder &b);
+    template <typename Builder>
+    void onBuild(Builder &b);
 };
 
 struct IdentityResponse : PlainMmMessage
@@ -275,7 +401,8 @@ struct IdentityResponse : PlainMmMessage
     IE5gsMobileIdentity mobileIdentity{};
 
     IdentityResponse();
-    void onBuild(NasMessageBuilder &b);
+    template <typename Builder>
+    void onBuild(Builder &b);
 };
 
 struct Notification : PlainMmMessage
@@ -283,7 +410,8 @@ struct Notification : PlainMmMessage
     IEAccessType accessType{};
 
     Notification();
-    void onBuild(NasMessageBuilder &b);
+    template <typename Builder>
+    void onBuild(Builder &b);
 };
 
 struct NotificationResponse : PlainMmMessage
@@ -291,7 +419,8 @@ struct NotificationResponse : PlainMmMessage
     std::optional<IEPduSessionStatus> pduSessionStatus{};
 
     NotificationResponse();
-    void onBuild(NasMessageBuilder &b);
+    template <typename Builder>
+    void onBuild(Builder &b);
 };
 
 struct PduSessionAuthenticationCommand : SmMessage
@@ -300,7 +429,8 @@ struct PduSessionAuthenticationCommand : SmMessage
     std::optional<IEExtendedProtocolConfigurationOptions> extendedProtocolConfigurationOptions{};
 
     PduSessionAuthenticationCommand();
-    void onBuild(NasMessageBuilder &b);
+    template <typename Builder>
+    void onBuild(Builder &b);
 };
 
 struct PduSessionAuthenticationComplete : SmMessage
@@ -309,7 +439,8 @@ struct PduSessionAuthenticationComplete : SmMessage
     std::optional<IEExtendedProtocolConfigurationOptions> extendedProtocolConfigurationOptions{};
 
     PduSessionAuthenticationComplete();
-    void onBuild(NasMessageBuilder &b);
+    template <typename Builder>
+    void onBuild(Builder &b);
 };
 
 struct PduSessionAuthenticationResult : SmMessage
@@ -318,7 +449,8 @@ struct PduSessionAuthenticationResult : SmMessage
     std::optional<IEExtendedProtocolConfigurationOptions> extendedProtocolConfigurationOptions{};
 
     PduSessionAuthenticationResult();
-    void onBuild(NasMessageBuilder &b);
+    template <typename Builder>
+    void onBuild(Builder &b);
 };
 
 struct PduSessionEstablishmentAccept : SmMessage
@@ -339,7 +471,8 @@ struct PduSessionEstablishmentAccept : SmMessage
     std::optional<IEDnn> dnn{};
 
     PduSessionEstablishmentAccept();
-    void onBuild(NasMessageBuilder &b);
+    template <typename Builder>
+    void onBuild(Builder &b);
 };
 
 struct PduSessionEstablishmentReject : SmMessage
@@ -351,7 +484,8 @@ struct PduSessionEstablishmentReject : SmMessage
     std::optional<IEExtendedProtocolConfigurationOptions> extendedProtocolConfigurationOptions{};
 
     PduSessionEstablishmentReject();
-    void onBuild(NasMessageBuilder &b);
+    template <typename Builder>
+    void onBuild(Builder &b);
 };
 
 struct PduSessionEstablishmentRequest : SmMessage
@@ -366,7 +500,8 @@ struct PduSessionEstablishmentRequest : SmMessage
     std::optional<IEExtendedProtocolConfigurationOptions> extendedProtocolConfigurationOptions{};
 
     PduSessionEstablishmentRequest();
-    void onBuild(NasMessageBuilder &b);
+    template <typename Builder>
+    void onBuild(Builder &b);
 };
 
 struct PduSessionModificationCommand : SmMessage
@@ -381,7 +516,8 @@ struct PduSessionModificationCommand : SmMessage
     std::optional<IEExtendedProtocolConfigurationOptions> extendedProtocolConfigurationOptions{};
 
     PduSessionModificationCommand();
-    void onBuild(NasMessageBuilder &b);
+    template <typename Builder>
+    void onBuild(Builder &b);
 };
 
 struct PduSessionModificationCommandReject : SmMessage
@@ -390,7 +526,8 @@ struct PduSessionModificationCommandReject : SmMessage
     std::optional<IEExtendedProtocolConfigurationOptions> extendedProtocolConfigurationOptions{};
 
     PduSessionModificationCommandReject();
-    void onBuild(NasMessageBuilder &b);
+    template <typename Builder>
+    void onBuild(Builder &b);
 };
 
 struct PduSessionModificationComplete : SmMessage
@@ -398,7 +535,8 @@ struct PduSessionModificationComplete : SmMessage
     std::optional<IEExtendedProtocolConfigurationOptions> extendedProtocolConfigurationOptions{};
 
     PduSessionModificationComplete();
-    void onBuild(NasMessageBuilder &b);
+    template <typename Builder>
+    void onBuild(Builder &b);
 };
 
 struct PduSessionModificationReject : SmMessage
@@ -408,7 +546,8 @@ struct PduSessionModificationReject : SmMessage
     std::optional<IEExtendedProtocolConfigurationOptions> extendedProtocolConfigurationOptions{};
 
     PduSessionModificationReject();
-    void onBuild(NasMessageBuilder &b);
+    template <typename Builder>
+    void onBuild(Builder &b);
 };
 
 struct PduSessionModificationRequest : SmMessage
@@ -424,7 +563,8 @@ struct PduSessionModificationRequest : SmMessage
     std::optional<IEExtendedProtocolConfigurationOptions> extendedProtocolConfigurationOptions{};
 
     PduSessionModificationRequest();
-    void onBuild(NasMessageBuilder &b);
+    template <typename Builder>
+    void onBuild(Builder &b);
 };
 
 struct PduSessionReleaseCommand : SmMessage
@@ -435,7 +575,8 @@ struct PduSessionReleaseCommand : SmMessage
     std::optional<IEExtendedProtocolConfigurationOptions> extendedProtocolConfigurationOptions{};
 
     PduSessionReleaseCommand();
-    void onBuild(NasMessageBuilder &b);
+    template <typename Builder>
+    void onBuild(Builder &b);
 };
 
 struct PduSessionReleaseComplete : SmMessage
@@ -444,7 +585,8 @@ struct PduSessionReleaseComplete : SmMessage
     std::optional<IEExtendedProtocolConfigurationOptions> extendedProtocolConfigurationOptions{};
 
     PduSessionReleaseComplete();
-    void onBuild(NasMessageBuilder &b);
+    template <typename Builder>
+    void onBuild(Builder &b);
 };
 
 struct PduSessionReleaseReject : SmMessage
@@ -453,7 +595,8 @@ struct PduSessionReleaseReject : SmMessage
     std::optional<IEExtendedProtocolConfigurationOptions> extendedProtocolConfigurationOptions{};
 
     PduSessionReleaseReject();
-    void onBuild(NasMessageBuilder &b);
+    template <typename Builder>
+    void onBuild(Builder &b);
 };
 
 struct PduSessionReleaseRequest : SmMessage
@@ -462,7 +605,8 @@ struct PduSessionReleaseRequest : SmMessage
     std::optional<IEExtendedProtocolConfigurationOptions> extendedProtocolConfigurationOptions{};
 
     PduSessionReleaseRequest();
-    void onBuild(NasMessageBuilder &b);
+    template <typename Builder>
+    void onBuild(Builder &b);
 };
 
 struct RegistrationAccept : PlainMmMessage
@@ -494,7 +638,8 @@ struct RegistrationAccept : PlainMmMessage
     std::optional<IEExtendedEmergencyNumberList> extendedEmergencyNumberList{};
 
     RegistrationAccept();
-    void onBuild(NasMessageBuilder &b);
+    template <typename Builder>
+    void onBuild(Builder &b);
 };
 
 struct RegistrationComplete : PlainMmMessage
@@ -502,7 +647,8 @@ struct RegistrationComplete : PlainMmMessage
     std::optional<IESorTransparentContainer> sorTransparentContainer{};
 
     RegistrationComplete();
-    void onBuild(NasMessageBuilder &b);
+    template <typename Builder>
+    void onBuild(Builder &b);
 };
 
 struct RegistrationReject : PlainMmMessage
@@ -513,7 +659,8 @@ struct RegistrationReject : PlainMmMessage
     std::optional<IEEapMessage> eapMessage{};
 
     RegistrationReject();
-    void onBuild(NasMessageBuilder &b);
+    template <typename Builder>
+    void onBuild(Builder &b);
 };
 
 struct RegistrationRequest : PlainMmMessage
@@ -543,7 +690,8 @@ struct RegistrationRequest : PlainMmMessage
     std::optional<IELadnIndication> ladnIndication{};
 
     RegistrationRequest();
-    void onBuild(NasMessageBuilder &b);
+    template <typename Builder>
+    void onBuild(Builder &b);
 };
 
 struct SecurityModeCommand : PlainMmMessage
@@ -562,7 +710,8 @@ struct SecurityModeCommand : PlainMmMessage
     OctetString _originalPlainNasPdu{};
 
     SecurityModeCommand();
-    void onBuild(NasMessageBuilder &b);
+    template <typename Builder>
+    void onBuild(Builder &b);
 };
 
 struct SecurityModeComplete : PlainMmMessage
@@ -571,7 +720,8 @@ struct SecurityModeComplete : PlainMmMessage
     std::optional<IENasMessageContainer> nasMessageContainer{};
 
     SecurityModeComplete();
-    void onBuild(NasMessageBuilder &b);
+    template <typename Builder>
+    void onBuild(Builder &b);
 };
 
 struct SecurityModeReject : PlainMmMessage
@@ -579,7 +729,8 @@ struct SecurityModeReject : PlainMmMessage
     IE5gMmCause mmCause{};
 
     SecurityModeReject();
-    void onBuild(NasMessageBuilder &b);
+    template <typename Builder>
+    void onBuild(Builder &b);
 };
 
 struct ServiceAccept : PlainMmMessage
@@ -590,7 +741,8 @@ struct ServiceAccept : PlainMmMessage
     std::optional<IEEapMessage> eapMessage{};
 
     ServiceAccept();
-    void onBuild(NasMessageBuilder &b);
+    template <typename Builder>
+    void onBuild(Builder &b);
 };
 
 struct ServiceReject : PlainMmMessage
@@ -601,7 +753,8 @@ struct ServiceReject : PlainMmMessage
     std::optional<IEEapMessage> eapMessage{};
 
     ServiceReject();
-    void onBuild(NasMessageBuilder &b);
+    template <typename Builder>
+    void onBuild(Builder &b);
 };
 
 struct ServiceRequest : PlainMmMessage
@@ -615,7 +768,8 @@ struct ServiceRequest : PlainMmMessage
     std::optional<IENasMessageContainer> nasMessageContainer{};
 
     ServiceRequest();
-    void onBuild(NasMessageBuilder &b);
+    template <typename Builder>
+    void onBuild(Builder &b);
 };
 
 struct UlNasTransport : PlainMmMessage
@@ -630,7 +784,8 @@ struct UlNasTransport : PlainMmMessage
     std::optional<IEAdditionalInformation> additionalInformation{};
 
     UlNasTransport();
-    void onBuild(NasMessageBuilder &b);
+    template <typename Builder>
+    void onBuild(Builder &b);
 };
 
 } // namespace nas
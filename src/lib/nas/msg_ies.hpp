@@ -0,0 +1,439 @@
+//
+// This file is a part of UERANSIM project.
+// Copyright (c) 2023 ALİ GÜNGÖR.
+//
+// https://github.com/aligungr/UERANSIM/
+// See README, LICENSE, and CONTRIBUTING files for licensing details.
+//
+
+#pragma once
+
+#include "msg.hpp"
+
+/*
+ * The IE lists of the messages. The codecs are instantiated in msg.cpp, other builders (e.g. of the tests) may include
+ * this file to instantiate the lists for themselves.
+ */
+
+namespace nas
+{
+
+template <typename Builder>
+void AuthenticationFailure::onBuild(Builder &b)
+{
+    b.mandatoryIE(&mmCause);
+    b.optionalIE(0x30, &authenticationFailureParameter);
+}
+
+template <typename Builder>
+void AuthenticationReject::onBuild(Builder &b)
+{
+    b.optionalIE(0x78, &eapMessage);
+}
+
+template <typename Builder>
+void AuthenticationRequest::onBuild(Builder &b)
+{
+    b.mandatoryIE1(&ngKSI);
+    b.mandatoryIE(&abba);
+    b.optionalIE(0x21, &authParamRAND);
+    b.optionalIE(0x20, &authParamAUTN);
+    b.optionalIE(0x78, &eapMessage);
+}
+
+template <typename Builder>
+void AuthenticationResponse::onBuild(Builder &b)
+{
+    b.optionalIE(0x2D, &authenticationResponseParameter);
+    b.optionalIE(0x78, &eapMessage);
+}
+
+template <typename Builder>
+void AuthenticationResult::onBuild(Builder &b)
+{
+    b.mandatoryIE1(&ngKSI);
+    b.mandatoryIE(&eapMessage);
+    b.optionalIE(0x38, &abba);
+}
+
+template <typename Builder>
+void ConfigurationUpdateCommand::onBuild(Builder &b)
+{
+    b.optionalIE1(0xD, &configurationUpdateIndication);
+    b.optionalIE(0x77, &guti);
+    b.optionalIE(0x54, &taiList);
+    b.optionalIE(0x15, &allowedNssai);
+    b.optionalIE(0x27, &serviceAreaList);
+    b.optionalIE(0x43, &networkFullName);
+    b.optionalIE(0x45, &networkShortName);
+    b.optionalIE(0x46, &localTimeZone);
+    b.optionalIE(0x47, &universalTimeAndLocalTimeZone);
+    b.optionalIE(0x49, &networkDaylightSavingTime);
+    b.optionalIE(0x79, &ladnInformation);
+    b.optionalIE1(0xB, &micoIndication);
+    b.optionalIE1(0x9, &networkSlicingIndication);
+    b.optionalIE(0x31, &configuredNssai);
+    b.optionalIE(0x11, &rejectedNssai);
+    b.optionalIE(0x76, &operatorDefinedAccessCategoryDefinitions);
+    b.optionalIE1(0xF, &smsIndication);
+}
+
+template <typename Builder>
+void ConfigurationUpdateComplete::onBuild(Builder &)
+{
+}
+
+template <typename Builder>
+void DeRegistrationAcceptUeOriginating::onBuild(Builder &)
+{
+}
+
+template <typename Builder>
+void DeRegistrationAcceptUeTerminated::onBuild(Builder &)
+{
+}
+
+template <typename Builder>
+void DeRegistrationRequestUeOriginating::onBuild(Builder &b)
+{
+    b.mandatoryIE1(&ngKSI, &deRegistrationType);
+    b.mandatoryIE(&mobileIdentity);
+}
+
+template <typename Builder>
+void DeRegistrationRequestUeTerminated::onBuild(Builder &b)
+{
+    b.mandatoryIE1(&deRegistrationType);
+    b.optionalIE(0x58, &mmCause);
+    b.optionalIE(0x5F, &t3346Value);
+}
+
+template <typename Builder>
+void DlNasTransport::onBuild(Builder &b)
+{
+    b.mandatoryIE1(&payloadContainerType);
+    b.mandatoryIE(&payloadContainer);
+    b.optionalIE(0x12, &pduSessionId);
+    b.optionalIE(0x24, &additionalInformation);
+    b.optionalIE(0x58, &mmCause);
+    b.optionalIE(0x37, &backOffTimerValue);
+}
+
+template <typename Builder>
+void FiveGMmStatus::onBuild(Builder &b)
+{
+    b.mandatoryIE(&mmCause);
+}
+
+template <typename Builder>
+void FiveGSmStatus::onBuild(Builder &b)
+{
+    b.mandatoryIE(&smCause);
+}
+
+template <typename Builder>
+void IdentityRequest::onBuild(Builder &b)
+{
+    b.mandatoryIE1(&identityType);
+}
+
+template <typename Builder>
+void IdentityResponse::onBuild(Builder &b)
+{
+    b.mandatoryIE(&mobileIdentity);
+}
+
+template <typename Builder>
+void Notification::onBuild(Builder &b)
+{
+    b.mandatoryIE1(&accessType);
+}
+
+template <typename Builder>
+void NotificationResponse::onBuild(Builder &b)
+{
+    b.optionalIE(0x50, &pduSessionStatus);
+}
+
+template <typename Builder>
+void PduSessionAuthenticationCommand::onBuild(Builder &b)
+{
+    b.mandatoryIE(&eapMessage);
+    b.optionalIE(0x7B, &extendedProtocolConfigurationOptions);
+}
+
+template <typename Builder>
+void PduSessionAuthenticationComplete::onBuild(Builder &b)
+{
+    b.mandatoryIE(&eapMessage);
+    b.optionalIE(0x7B, &extendedProtocolConfigurationOptions);
+}
+
+template <typename Builder>
+void PduSessionAuthenticationResult::onBuild(Builder &b)
+{
+    b.optionalIE(0x78, &eapMessage);
+    b.optionalIE(0x7B, &extendedProtocolConfigurationOptions);
+}
+
+template <typename Builder>
+void PduSessionEstablishmentAccept::onBuild(Builder &b)
+{
+    b.mandatoryIE1(&selectedSscMode, &selectedPduSessionType);
+    b.mandatoryIE(&authorizedQoSRules);
+    b.mandatoryIE(&sessionAmbr);
+    b.optionalIE(0x59, &smCause);
+    b.optionalIE(0x29, &pduAddress);
+    b.optionalIE(0x56, &rqTimerValue);
+    b.optionalIE(0x22, &sNssai);
+    b.optionalIE1(0x8, &alwaysOnPduSessionIndication);
+    b.optionalIE(0x7F, &mappedEpsBearerContexts);
+    b.optionalIE(0x78, &eapMessage);
+    b.optionalIE(0x79, &authorizedQoSFlowDescriptions);
+    b.optionalIE(0x7B, &extendedProtocolConfigurationOptions);
+    b.optionalIE(0x25, &dnn);
+}
+
+template <typename Builder>
+void PduSessionEstablishmentReject::onBuild(Builder &b)
+{
+    b.mandatoryIE(&smCause);
+    b.optionalIE(0x37, &backOffTimerValue);
+    b.optionalIE1(0xF, &allowedSscMode);
+    b.optionalIE(0x78, &eapMessage);
+    b.optionalIE(0x7B, &extendedProtocolConfigurationOptions);
+}
+
+template <typename Builder>
+void PduSessionEstablishmentRequest::onBuild(Builder &b)
+{
+    b.mandatoryIE(&integrityProtectionMaximumDataRate);
+    b.optionalIE1(0x9, &pduSessionType);
+    b.optionalIE1(0xA, &sscMode);
+    b.optionalIE(0x28, &smCapability);
+    b.optionalIE(0x55, &maximumNumberOfSupportedPacketFilters);
+    b.optionalIE1(0xB, &alwaysOnPduSessionRequested);
+    b.optionalIE(0x39, &smPduDnRequestContainer);
+    b.optionalIE(0x7B, &extendedProtocolConfigurationOptions);
+}
+
+template <typename Builder>
+void PduSessionModificationCommand::onBuild(Builder &b)
+{
+    b.optionalIE(0x59, &smCause);
+    b.optionalIE(0x2A, &sessionAmbr);
+    b.optionalIE(0x56, &rqTimerValue);
+    b.optionalIE1(0x8, &alwaysOnPduSessionIndication);
+    b.optionalIE(0x7A, &authorizedQoSRules);
+    b.optionalIE(0x7F, &mappedEpsBearerContexts);
+    b.optionalIE(0x79, &authorizedQoSFlowDescriptions);
+    b.optionalIE(0x7B, &extendedProtocolConfigurationOptions);
+}
+
+template <typename Builder>
+void PduSessionModificationCommandReject::onBuild(Builder &b)
+{
+    b.mandatoryIE(&smCause);
+    b.optionalIE(0x7B, &extendedProtocolConfigurationOptions);
+}
+
+template <typename Builder>
+void PduSessionModificationComplete::onBuild(Builder &b)
+{
+    b.optionalIE(0x7B, &extendedProtocolConfigurationOptions);
+}
+
+template <typename Builder>
+void PduSessionModificationReject::onBuild(Builder &b)
+{
+    b.mandatoryIE(&smCause);
+    b.optionalIE(0x37, &backOffTimerValue);
+    b.optionalIE(0x7B, &extendedProtocolConfigurationOptions);
+}
+
+template <typename Builder>
+void PduSessionModificationRequest::onBuild(Builder &b)
+{
+    b.optionalIE(0x28, &smCapability);
+    b.optionalIE(0x59, &smCause);
+    b.optionalIE(0x55, &maximumNumberOfSupportedPacketFilters);
+    b.optionalIE1(0xB, &alwaysOnPduSessionRequested);
+    b.optionalIE(0x13, &integrityProtectionMaximumDataRate);
+    b.optionalIE(0x7A, &requestedQosRules);
+    b.optionalIE(0x79, &requestedQosFlowDescriptions);
+    b.optionalIE(0x7F, &mappedEpsBearerContexts);
+    b.optionalIE(0x7B, &extendedProtocolConfigurationOptions);
+}
+
+template <typename Builder>
+void PduSessionReleaseCommand::onBuild(Builder &b)
+{
+    b.mandatoryIE(&smCause);
+    b.optionalIE(0x37, &backOffTimerValue);
+    b.optionalIE(0x78, &eapMessage);
+    b.optionalIE(0x7B, &extendedProtocolConfigurationOptions);
+}
+
+template <typename Builder>
+void PduSessionReleaseComplete::onBuild(Builder &b)
+{
+    b.optionalIE(0x59, &smCause);
+    b.optionalIE(0x7B, &extendedProtocolConfigurationOptions);
+}
+
+template <typename Builder>
+void PduSessionReleaseReject::onBuild(Builder &b)
+{
+    b.mandatoryIE(&smCause);
+    b.optionalIE(0x7B, &extendedProtocolConfigurationOptions);
+}
+
+template <typename Builder>
+void PduSessionReleaseRequest::onBuild(Builder &b)
+{
+    b.optionalIE(0x59, &smCause);
+    b.optionalIE(0x7B, &extendedProtocolConfigurationOptions);
+}
+
+template <typename Builder>
+void RegistrationAccept::onBuild(Builder &b)
+{
+    b.mandatoryIE(&registrationResult);
+    b.optionalIE1(0x9, &networkSlicingIndication);
+    b.optionalIE1(0xA, &nssaiInclusionMode);
+    b.optionalIE1(0xB, &micoIndication);
+    b.optionalIE(0x77, &mobileIdentity);
+    b.optionalIE(0x4A, &equivalentPLMNs);
+    b.optionalIE(0x54, &taiList);
+    b.optionalIE(0x15, &allowedNSSAI);
+    b.optionalIE(0x11, &rejectedNSSAI);
+    b.optionalIE(0x31, &configuredNSSAI);
+    b.optionalIE(0x21, &networkFeatureSupport);
+    b.optionalIE(0x50, &pduSessionStatus);
+    b.optionalIE(0x26, &pduSessionReactivationResult);
+    b.optionalIE(0x72, &pduSessionReactivationResultErrorCause);
+    b.optionalIE(0x79, &ladnInformation);
+    b.optionalIE(0x27, &serviceAreaList);
+    b.optionalIE(0x5E, &t3512Value);
+    b.optionalIE(0x5D, &non3gppDeRegistrationTimerValue);
+    b.optionalIE(0x16, &t3502Value);
+    b.optionalIE(0x34, &emergencyNumberList);
+    b.optionalIE(0x7A, &extendedEmergencyNumberList);
+    b.optionalIE(0x73, &sorTransparentContainer);
+    b.optionalIE(0x78, &eapMessage);
+    b.optionalIE(0x76, &operatorDefinedAccessCategoryDefinitions);
+    b.optionalIE(0x51, &negotiatedDrxParameters);
+}
+
+template <typename Builder>
+void RegistrationComplete::onBuild(Builder &b)
+{
+    b.optionalIE(0x73, &sorTransparentContainer);
+}
+
+template <typename Builder>
+void RegistrationReject::onBuild(Builder &b)
+{
+    b.mandatoryIE(&mmCause);
+    b.optionalIE(0x5F, &t3346value);
+    b.optionalIE(0x16, &t3502value);
+    b.optionalIE(0x78, &eapMessage);
+}
+
+template <typename Builder>
+void RegistrationRequest::onBuild(Builder &b)
+{
+    b.mandatoryIE1(&nasKeySetIdentifier, &registrationType);
+    b.mandatoryIE(&mobileIdentity);
+    b.optionalIE1(0xC, &nonCurrentNgKsi);
+    b.optionalIE1(0xB, &micoIndication);
+    b.optionalIE1(0x9, &networkSlicingIndication);
+    b.optionalIE(0x10, &mmCapability);
+    b.optionalIE(0x2E, &ueSecurityCapability);
+    b.optionalIE(0x2F, &requestedNSSAI);
+    b.optionalIE(0x52, &lastVisitedRegisteredTai);
+    b.optionalIE(0x17, &s1UeNetworkCapability);
+    b.optionalIE(0x40, &uplinkDataStatus);
+    b.optionalIE(0x50, &pduSessionStatus);
+    b.optionalIE(0x2B, &ueStatus);
+    b.optionalIE(0x77, &additionalGuti);
+    b.optionalIE(0x25, &allowedPduSessionStatus);
+    b.optionalIE(0x18, &uesUsageSetting);
+    b.optionalIE(0x51, &requestedDrxParameters);
+    b.optionalIE(0x70, &epsNasMessageContainer);
+    b.optionalIE(0x7E, &ladnIndication);
+    b.optionalIE(0x7B, &payloadContainer);
+    b.optionalIE(0x53, &updateType);
+    b.optionalIE(0x71, &nasMessageContainer);
+}
+
+template <typename Builder>
+void SecurityModeCommand::onBuild(Builder &b)
+{
+    b.mandatoryIE(&selectedNasSecurityAlgorithms);
+    b.mandatoryIE1(&ngKsi);
+    b.mandatoryIE(&replayedUeSecurityCapabilities);
+    b.optionalIE1(0xE, &imeiSvRequest);
+    b.optionalIE(0x57, &epsNasSecurityAlgorithms);
+    b.optionalIE(0x36, &additional5gSecurityInformation);
+    b.optionalIE(0x78, &eapMessage);
+    b.optionalIE(0x38, &abba);
+    b.optionalIE(0x19, &replayedS1UeNetworkCapability);
+}
+
+template <typename Builder>
+void SecurityModeComplete::onBuild(Builder &b)
+{
+    b.optionalIE(0x77, &imeiSv);
+    b.optionalIE(0x71, &nasMessageContainer);
+}
+
+template <typename Builder>
+void SecurityModeReject::onBuild(Builder &b)
+{
+    b.mandatoryIE(&mmCause);
+}
+
+template <typename Builder>
+void ServiceAccept::onBuild(Builder &b)
+{
+    b.optionalIE(0x50, &pduSessionStatus);
+    b.optionalIE(0x26, &pduSessionReactivationResult);
+    b.optionalIE(0x72, &pduSessionReactivationResultErrorCause);
+    b.optionalIE(0x78, &eapMessage);
+}
+
+template <typename Builder>
+void ServiceReject::onBuild(Builder &b)
+{
+    b.mandatoryIE(&mmCause);
+    b.optionalIE(0x50, &pduSessionStatus);
+    b.optionalIE(0x5f, &t3346Value);
+    b.optionalIE(0x78, &eapMessage);
+}
+
+template <typename Builder>
+void ServiceRequest::onBuild(Builder &b)
+{
+    b.mandatoryIE1(&serviceType, &ngKSI);
+    b.mandatoryIE(&tmsi);
+    b.optionalIE(0x40, &uplinkDataStatus);
+    b.optionalIE(0x50, &pduSessionStatus);
+    b.optionalIE(0x25, &allowedPduSessionStatus);
+    b.optionalIE(0x71, &nasMessageContainer);
+}
+
+template <typename Builder>
+void UlNasTransport::onBuild(Builder &b)
+{
+    b.mandatoryIE1(&payloadContainerType);
+    b.mandatoryIE(&payloadContainer);
+    b.optionalIE(0x12, &pduSessionId);
+    b.optionalIE(0x59, &oldPduSessionId);
+    b.optionalIE1(0x8, &requestType);
+    b.optionalIE(0x22, &sNssai);
+    b.optionalIE(0x25, &dnn);
+    b.optionalIE(0x24, &additionalInformation);
+}
+
+} // namespace nas
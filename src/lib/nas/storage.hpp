@@ -22,7 +22,8 @@ namespace nas
 
 /*
  * - Items are unique, if already exists, deletes the previous one
- * - List have fixed size, if capacity is full, oldest item is deleted
+ * - List have a size limit, if the limit is reached, oldest item is deleted
+ * - Storage is allocated on demand, an empty list costs no heap memory
  * - Automatically cleared after specified period
  * - The list is NOT thread safe
  */
@@ -44,7 +45,7 @@ class NasList
   public:
     NasList(size_t sizeLimit, int64_t autoClearingPeriod, std::optional<backup_functor_type> backupFunctor)
         : m_sizeLimit{sizeLimit}, m_autoClearingPeriod{autoClearingPeriod},
-          m_backupFunctor{backupFunctor}, m_data{sizeLimit}, m_size{}, m_lastAutoCleared{::utils::CurrentTimeMillis()}
+          m_backupFunctor{backupFunctor}, m_data{}, m_size{}, m_lastAutoCleared{::utils::CurrentTimeMillis()}
     {
     }
 
@@ -58,7 +59,7 @@ class NasList
         remove(item);
         makeSlotForNewItem();
 
-        m_data[m_size] = item;
+        m_data.push_back(item);
         m_size++;
 
         touch();
@@ -70,7 +71,7 @@ class NasList
         remove(item);
         makeSlotForNewItem();
 
-        m_data[m_size] = std::move(item);
+        m_data.push_back(std::move(item));
         m_size++;
 
         touch();
@@ -143,6 +144,11 @@ class NasList
         return m_data.size();
     }
 
+    [[nodiscard]] size_t memoryUsage() const
+    {
+        return sizeof(*this) + m_data.capacity() * sizeof(T);
+    }
+
   private:
     void autoClearIfNecessary()
     {
@@ -165,8 +171,7 @@ class NasList
 
     void removeAt(size_t index)
     {
-        for (size_t i = index; i < m_size; ++i)
-            m_data[i] = i + 1 < m_sizeLimit ? m_data[i + 1] : T{};
+        m_data.erase(m_data.begin() + static_cast<std::ptrdiff_t>(index));
         m_size--;
 
         touch();
@@ -213,6 +218,11 @@ class NasSlot
         return m_value;
     }
 
+    [[nodiscard]] size_t memoryUsage() const
+    {
+        return sizeof(*this);
+    }
+
     void clear()
     {
         set(T{});
@@ -8,8 +8,195 @@
 
 #include "rls_base.hpp"
 
+#include <algorithm>
+
+#include <utils/common.hpp>
+#include <utils/random.hpp>
+
+// Whether sequence number a precedes b, accounting for the wrap around
+static bool SeqBefore(uint32_t a, uint32_t b)
+{
+    return static_cast<int32_t>(a - b) < 0;
+}
+
 namespace rls
 {
 
+SendWindow::SendWindow() : m_epoch{Random{}.nextUI()}
+{
+}
+
+uint32_t SendWindow::epoch() const
+{
+    return m_epoch;
+}
+
+bool SendWindow::isFull() const
+{
+    return m_next - m_base >= SIZE;
+}
+
+bool SendWindow::isEmpty() const
+{
+    return m_next == m_base;
+}
+
+uint32_t SendWindow::push(PduInfo &&info, int64_t deadline)
+{
+    uint32_t seq = m_next++;
+
+    // Sequence number 0 denotes unacknowledged mode, its slot is just left unused
+    if (m_next == 0)
+        m_next++;
+
+    auto &entry = m_entries[seq % SIZE];
+    entry.used = true;
+    entry.deadline = deadline;
+    entry.info = std::move(info);
+    return seq;
+}
+
+SendWindow::Entry *SendWindow::find(uint32_t seq)
+{
+    if (SeqBefore(seq, m_base) || !SeqBefore(seq, m_next))
+        return nullptr;
+    auto &entry = m_entries[seq % SIZE];
+    return entry.used ? &entry : nullptr;
+}
+
+PduInfo SendWindow::remove(uint32_t seq)
+{
+    auto *entry = find(seq);
+    if (entry == nullptr)
+        return {};
+
+    entry->used = false;
+    auto info = std::move(entry->info);
+    slide();
+    return info;
+}
+
+void SendWindow::acknowledge(uint32_t cumulative, uint64_t bitmap)
+{
+    for (uint32_t seq = m_base; seq != m_next && !SeqBefore(cumulative, seq); seq++)
+        m_entries[seq % SIZE].used = false;
+
+    for (uint32_t i = 0; bitmap != 0; i++, bitmap >>= 1)
+    {
+        if ((bitmap & 1) == 0)
+            continue;
+        auto *entry = find(cumulative + 1 + i);
+        if (entry)
+            entry->used = false;
+    }
+
+    slide();
+}
+
+std::vector<PduInfo> SendWindow::clear()
+{
+    std::vector<PduInfo> res;
+    for (uint32_t seq = m_base; seq != m_next; seq++)
+    {
+        auto &entry = m_entries[seq % SIZE];
+        if (entry.used)
+            res.push_back(std::move(entry.info));
+        entry.used = false;
+    }
+    m_base = m_next;
+    return res;
+}
+
+void SendWindow::slide()
+{
+    while (m_base != m_next && !m_entries[m_base % SIZE].used)
+        m_base++;
+}
+
+bool ReceiveWindow::receive(uint32_t epoch, uint32_t seq)
+{
+    // Retransmissions are at most a send window behind, anything older belongs to a restarted sequence
+    if (!m_started || epoch != m_epoch || SeqBefore(seq, m_cumulative - SendWindow::SIZE))
+    {
+        m_started = true;
+        m_epoch = epoch;
+        m_cumulative = seq - 1;
+        m_bitmap = 0;
+    }
+
+    if (!SeqBefore(m_cumulative, seq))
+        return false;
+
+    uint32_t offset = seq - m_cumulative - 1;
+    if (offset >= 64)
+    {
+        // The peer has given up on some of the PDUs below the bitmap, they are not waited for any more
+        uint32_t shift = offset - 63;
+        m_bitmap = shift >= 64 ? 0 : m_bitmap >> shift;
+        m_cumulative += shift;
+        offset = 63;
+    }
+
+    uint64_t bit = uint64_t{1} << offset;
+    if (m_bitmap & bit)
+        return false;
+    m_bitmap |= bit;
+
+    while (m_bitmap & 1)
+    {
+        m_bitmap >>= 1;
+        m_cumulative++;
+    }
+    return true;
+}
+
+uint32_t ReceiveWindow::epoch() const
+{
+    return m_epoch;
+}
+
+uint32_t ReceiveWindow::cumulative() const
+{
+    return m_cumulative;
+}
+
+uint64_t ReceiveWindow::bitmap() const
+{
+    return m_bitmap;
+}
+
+bool RetransmissionWheel::isEmpty() const
+{
+    return m_size == 0;
+}
+
+void RetransmissionWheel::schedule(int64_t deadline, int endPointId, uint32_t seq)
+{
+    if (m_size == 0)
+        m_tick = utils::CurrentTimeMillis() / TICK;
+
+    int64_t tick = (deadline + TICK - 1) / TICK;
+    if (tick <= m_tick)
+        tick = m_tick + 1;
+    if (tick - m_tick >= BUCKETS)
+        tick = m_tick + BUCKETS - 1;
+
+    m_buckets[tick % BUCKETS].push_back({endPointId, seq});
+    m_size++;
+}
+
+void RetransmissionWheel::advance(int64_t now, std::vector<Entry> &expired)
+{
+    int64_t target = now / TICK;
+    for (int i = 0; m_tick < target && i < BUCKETS; i++)
+    {
+        m_tick++;
+        auto &bucket = m_buckets[m_tick % BUCKETS];
+        expired.insert(expired.end(), bucket.begin(), bucket.end());
+        m_size -= bucket.size();
+        bucket.clear();
+    }
+    m_tick = std::max(m_tick, target);
 }
 
+} // namespace rls
@@ -8,6 +8,9 @@
 
 #include "rls_pdu.hpp"
 
+#include <array>
+#include <vector>
+
 #include <lib/rrc/rrc.hpp>
 
 namespace rls
@@ -24,9 +27,101 @@ struct PduInfo
 
 enum class ERlfCause
 {
-    PDU_ID_EXISTS,
     PDU_ID_FULL,
     SIGNAL_LOST_TO_CONNECTED_CELL
 };
 
-} // namespace rls
\ No newline at end of file
+/*
+ * Outstanding acknowledged mode PDUs sent to a single peer. Sequence numbers are assigned consecutively, so the PDUs
+ * are kept in a ring indexed by the sequence number, and at most SIZE of them can be outstanding at a time. Each
+ * window has a random epoch, so that the receiver can tell a restarted sequence from the duplicates of the old one.
+ */
+class SendWindow
+{
+  public:
+    static constexpr uint32_t SIZE = 64;
+
+    struct Entry
+    {
+        bool used{};
+        int64_t deadline{};
+        PduInfo info{};
+    };
+
+  private:
+    std::array<Entry, SIZE> m_entries{};
+    uint32_t m_epoch;
+    uint32_t m_base = 1;
+    uint32_t m_next = 1;
+
+  public:
+    SendWindow();
+
+  public:
+    [[nodiscard]] uint32_t epoch() const;
+    [[nodiscard]] bool isFull() const;
+    [[nodiscard]] bool isEmpty() const;
+
+    /* Returns the sequence number assigned to the PDU */
+    uint32_t push(PduInfo &&info, int64_t deadline);
+    Entry *find(uint32_t seq);
+    PduInfo remove(uint32_t seq);
+    void acknowledge(uint32_t cumulative, uint64_t bitmap);
+    std::vector<PduInfo> clear();
+
+  private:
+    void slide();
+};
+
+/*
+ * Acknowledged mode PDUs received from a single peer. All the sequence numbers up to 'cumulative' are received, and
+ * bit i of 'bitmap' tells if cumulative + 1 + i is received. The window starts over with the first PDU of a new epoch,
+ * or with a PDU too far behind to be a retransmission, since the peer must have restarted its sequence in that case.
+ */
+class ReceiveWindow
+{
+  private:
+    uint32_t m_epoch = 0;
+    uint32_t m_cumulative = 0;
+    uint64_t m_bitmap = 0;
+    bool m_started = false;
+
+  public:
+    /* Returns false if the PDU is a duplicate */
+    bool receive(uint32_t epoch, uint32_t seq);
+
+    [[nodiscard]] uint32_t epoch() const;
+    [[nodiscard]] uint32_t cumulative() const;
+    [[nodiscard]] uint64_t bitmap() const;
+};
+
+/*
+ * Retransmission deadlines of the PDUs in all send windows, bucketed by TICK milliseconds. Entries are not removed
+ * upon acknowledgement, the owner ignores the ones that no longer match a pending deadline.
+ */
+class RetransmissionWheel
+{
+  public:
+    static constexpr int TICK = 100;
+    static constexpr int BUCKETS = 64;
+
+    struct Entry
+    {
+        int endPointId;
+        uint32_t seq;
+    };
+
+  private:
+    std::array<std::vector<Entry>, BUCKETS> m_buckets{};
+    int64_t m_tick = 0;
+    size_t m_size = 0;
+
+  public:
+    [[nodiscard]] bool isEmpty() const;
+
+    /* Deadlines beyond the horizon of the wheel are reported early, and should be scheduled again */
+    void schedule(int64_t deadline, int endPointId, uint32_t seq);
+    void advance(int64_t now, std::vector<Entry> &expired);
+};
+
+} // namespace rls
@@ -13,8 +13,9 @@
 namespace rls
 {
 
-void EncodeRlsMessage(const RlsMessage &msg, OctetString &stream)
+void EncodeRlsMessage(const RlsMessage &msg, uint64_t targetSti, OctetString &stream)
 {
+    stream.reserveEncodeBuffer();
     stream.appendOctet(0x03); // (Just for old RLS compatibility)
 
     stream.appendOctet(cons::Major);
@@ -22,6 +23,7 @@ void EncodeRlsMessage(const RlsMessage &msg, OctetString &stream)
     stream.appendOctet(cons::Patch);
     stream.appendOctet(static_cast<uint8_t>(msg.msgType));
     stream.appendOctet8(msg.sti);
+    stream.appendOctet8(targetSti);
     if (msg.msgType == EMessageType::HEARTBEAT)
     {
         auto &m = (const RlsHeartBeat &)msg;
@@ -33,12 +35,16 @@ void EncodeRlsMessage(const RlsMessage &msg, OctetString &stream)
     {
         auto &m = (const RlsHeartBeatAck &)msg;
         stream.appendOctet4(m.dbm);
+        stream.appendOctet4(m.simPos.x);
+        stream.appendOctet4(m.simPos.y);
+        stream.appendOctet4(m.simPos.z);
     }
     else if (msg.msgType == EMessageType::PDU_TRANSMISSION)
     {
         auto &m = (const RlsPduTransmission &)msg;
         stream.appendOctet(static_cast<uint8_t>(m.pduType));
         stream.appendOctet4(m.pduId);
+        stream.appendOctet4(m.epoch);
         stream.appendOctet4(m.payload);
         stream.appendOctet4(m.pdu.length());
         stream.append(m.pdu);
@@ -46,13 +52,13 @@ void EncodeRlsMessage(const RlsMessage &msg, OctetString &stream)
     else if (msg.msgType == EMessageType::PDU_TRANSMISSION_ACK)
     {
         auto &m = (const RlsPduTransmissionAck &)msg;
-        stream.appendOctet4(static_cast<uint32_t>(m.pduIds.size()));
-        for (auto pduId : m.pduIds)
-            stream.appendOctet4(pduId);
+        stream.appendOctet4(m.epoch);
+        stream.appendOctet4(m.cumulative);
+        stream.appendOctet8(m.bitmap);
     }
 }
 
-std::unique_ptr<RlsMessage> DecodeRlsMessage(const OctetView &stream)
+static std::unique_ptr<RlsMessage> DecodeMessage(const OctetView &stream)
 {
     auto first = stream.readI(); // (Just for old RLS compatibility)
     if (first != 3)
@@ -67,10 +73,12 @@ std::unique_ptr<RlsMessage> DecodeRlsMessage(const OctetView &stream)
 
     auto msgType = static_cast<EMessageType>(stream.readI());
     uint64_t sti = stream.read8UL();
+    uint64_t targetSti = stream.read8UL();
 
     if (msgType == EMessageType::HEARTBEAT)
     {
         auto res = std::make_unique<RlsHeartBeat>(sti);
+        res->targetSti = targetSti;
         res->simPos.x = stream.read4I();
         res->simPos.y = stream.read4I();
         res->simPos.z = stream.read4I();
@@ -79,34 +87,50 @@ std::unique_ptr<RlsMessage> DecodeRlsMessage(const OctetView &stream)
     else if (msgType == EMessageType::HEARTBEAT_ACK)
     {
         auto res = std::make_unique<RlsHeartBeatAck>(sti);
+        res->targetSti = targetSti;
         res->dbm = stream.read4I();
+        res->simPos.x = stream.read4I();
+        res->simPos.y = stream.read4I();
+        res->simPos.z = stream.read4I();
         return res;
     }
     else if (msgType == EMessageType::PDU_TRANSMISSION)
     {
         auto res = std::make_unique<RlsPduTransmission>(sti);
+        res->targetSti = targetSti;
         res->pduType = static_cast<EPduType>((uint8_t)stream.read());
         res->pduId = stream.read4UI();
+        res->epoch = stream.read4UI();
         res->payload = stream.read4UI();
 
         int pduLength = stream.read4I();
         if (pduLength > 16384)
             return nullptr;
-        
+
         res->pdu = stream.readOctetString(pduLength);
         return res;
     }
     else if (msgType == EMessageType::PDU_TRANSMISSION_ACK)
     {
         auto res = std::make_unique<RlsPduTransmissionAck>(sti);
-        auto count = stream.read4UI();
-        res->pduIds.reserve(count);
-        for (uint32_t i = 0; i < count; i++)
-            res->pduIds.push_back(stream.read4UI());
+        res->targetSti = targetSti;
+        res->epoch = stream.read4UI();
+        res->cumulative = stream.read4UI();
+        res->bitmap = stream.read8UL();
         return res;
     }
 
     return nullptr;
 }
 
+std::unique_ptr<RlsMessage> DecodeRlsMessage(const OctetView &stream)
+{
+    auto msg = DecodeMessage(stream);
+
+    // Truncated datagrams are dropped
+    if (stream.hasError())
+        return nullptr;
+    return msg;
+}
+
 } // namespace rls
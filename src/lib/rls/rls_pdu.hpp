@@ -44,6 +44,10 @@ struct RlsMessage
     const EMessageType msgType;
     const uint64_t sti{};
 
+    // STI of the intended receiver, or 0 if the message is for any node at the address. Set upon decoding, the sender
+    // gives it to the encoder.
+    uint64_t targetSti{};
+
     explicit RlsMessage(EMessageType msgType, uint64_t sti) : msgType(msgType), sti(sti)
     {
     }
@@ -61,6 +65,8 @@ struct RlsHeartBeat : RlsMessage
 struct RlsHeartBeatAck : RlsMessage
 {
     int dbm{};
+    // Position of the gNB, so that the UEs can check the cell positions in their mobility configuration
+    Vector3 simPos{};
 
     explicit RlsHeartBeatAck(uint64_t sti) : RlsMessage(EMessageType::HEARTBEAT_ACK, sti)
     {
@@ -70,7 +76,10 @@ struct RlsHeartBeatAck : RlsMessage
 struct RlsPduTransmission : RlsMessage
 {
     EPduType pduType{};
+    // Sequence number of the PDU for the acknowledged mode, or 0 for the unacknowledged mode
     uint32_t pduId{};
+    // Epoch of the sender's sequence numbers, meaningful in the acknowledged mode
+    uint32_t epoch{};
     uint32_t payload{};
     OctetString pdu{};
 
@@ -81,14 +90,18 @@ struct RlsPduTransmission : RlsMessage
 
 struct RlsPduTransmissionAck : RlsMessage
 {
-    std::vector<uint32_t> pduIds;
+    // All the PDUs up to the cumulative sequence number are received, and bit i of the bitmap tells if the
+    // cumulative + 1 + i is received. The epoch is the one of the acknowledged sequence numbers.
+    uint32_t epoch{};
+    uint32_t cumulative{};
+    uint64_t bitmap{};
 
     explicit RlsPduTransmissionAck(uint64_t sti) : RlsMessage(EMessageType::PDU_TRANSMISSION_ACK, sti)
     {
     }
 };
 
-void EncodeRlsMessage(const RlsMessage &msg, OctetString &stream);
+void EncodeRlsMessage(const RlsMessage &msg, uint64_t targetSti, OctetString &stream);
 std::unique_ptr<RlsMessage> DecodeRlsMessage(const OctetView &stream);
 
 } // namespace rls
\ No newline at end of file
@@ -44,10 +44,9 @@ inline OctetString EncodeS(const asn_TYPE_descriptor_t &desc, T *pdu)
     ssize_t encoded;
     if (Encode(desc, pdu, encoded, buffer))
     {
-        std::vector<uint8_t> v(encoded);
-        memcpy(v.data(), buffer, encoded);
+        auto res = OctetString::FromArray(buffer, static_cast<size_t>(encoded));
         free(buffer);
-        return OctetString{std::move(v)};
+        return res;
     }
     return OctetString{};
 }
@@ -7,3 +7,47 @@
 //
 
 #include "rrc.hpp"
+
+namespace rrc
+{
+
+static constexpr const int64_t RADIO_FRAME_MS = 10;
+
+int64_t PagingOccasion::nextTimeMs(int64_t nowMs) const
+{
+    int64_t currentFrame = (nowMs + RADIO_FRAME_MS - 1) / RADIO_FRAME_MS;
+    int64_t delta = ((frame - currentFrame % cycle) + cycle) % cycle;
+    return (currentFrame + delta) * RADIO_FRAME_MS;
+}
+
+uint32_t PagingOccasion::toTag() const
+{
+    int log2Cycle = 0;
+    while ((1 << log2Cycle) < cycle)
+        log2Cycle++;
+    return static_cast<uint32_t>(log2Cycle << 8) | static_cast<uint32_t>(frame & 0xFF);
+}
+
+std::optional<PagingOccasion> PagingOccasion::FromTag(uint32_t tag)
+{
+    int log2Cycle = static_cast<int>((tag >> 8) & 0xF);
+    if (log2Cycle < 5 || log2Cycle > 8)
+        return std::nullopt;
+
+    PagingOccasion po{};
+    po.cycle = 1 << log2Cycle;
+    po.frame = static_cast<int>(tag & 0xFF) % po.cycle;
+    return po;
+}
+
+PagingOccasion PagingOccasion::Of(uint32_t fiveGTmsi, int cycle)
+{
+    int ueId = static_cast<int>(fiveGTmsi % 1024u);
+
+    PagingOccasion po{};
+    po.cycle = cycle;
+    po.frame = ueId % cycle;
+    return po;
+}
+
+} // namespace rrc
@@ -8,6 +8,9 @@
 
 #pragma once
 
+#include <cstdint>
+#include <optional>
+
 namespace rrc
 {
 
@@ -23,4 +26,25 @@ enum class RrcChannel
     UL_DCCH,
 };
 
+/*
+ * Paging occasion of a UE, see 38.304 7.1. One paging frame per radio frame (N = T) and one paging occasion per paging
+ * frame (Ns = 1) are assumed, so an occasion is identified by the DRX cycle and the paging frame within the cycle.
+ * Radio frames are emulated on the wall clock, i.e. each radio frame is 10 ms.
+ */
+struct PagingOccasion
+{
+    int cycle{}; // DRX cycle (T) in radio frames, one of 32, 64, 128, 256
+    int frame{}; // Paging frame in [0, cycle)
+
+    // Time of the first occurrence of this occasion at or after the given time
+    [[nodiscard]] int64_t nextTimeMs(int64_t nowMs) const;
+
+    // Non-zero tag carried along with the PCCH deliveries of this occasion
+    [[nodiscard]] uint32_t toTag() const;
+    static std::optional<PagingOccasion> FromTag(uint32_t tag);
+
+    // UE_ID is (5G-S-TMSI mod 1024), i.e. the least significant 10 bits of 5G-TMSI
+    static PagingOccasion Of(uint32_t fiveGTmsi, int cycle);
+};
+
 } // namespace nr::rrc
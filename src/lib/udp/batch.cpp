@@ -0,0 +1,72 @@
+//
+// This file is a part of UERANSIM project.
+// Copyright (c) 2023 ALİ GÜNGÖR.
+//
+// https://github.com/aligungr/UERANSIM/
+// See README, LICENSE, and CONTRIBUTING files for licensing details.
+//
+
+#include "batch.hpp"
+
+namespace udp
+{
+
+DatagramBatch::DatagramBatch() : m_address{}, m_buffer{}, m_segmentSize{}, m_count{}
+{
+    m_buffer.reserve(MAX_SIZE);
+}
+
+bool DatagramBatch::append(const InetAddress &address, const uint8_t *data, size_t size)
+{
+    if (size == 0 || size > MAX_SIZE)
+        return false;
+
+    if (m_count == 0)
+    {
+        m_address = address;
+        m_segmentSize = size;
+    }
+    else
+    {
+        // A shorter datagram closes the batch
+        if (m_buffer.size() != m_count * m_segmentSize)
+            return false;
+        if (size > m_segmentSize || m_count >= MAX_SEGMENTS || m_buffer.size() + size > MAX_SIZE)
+            return false;
+        if (m_address != address)
+            return false;
+    }
+
+    m_buffer.insert(m_buffer.end(), data, data + size);
+    m_count++;
+    return true;
+}
+
+void DatagramBatch::clear()
+{
+    m_buffer.clear();
+    m_segmentSize = 0;
+    m_count = 0;
+}
+
+bool DatagramBatch::isEmpty() const
+{
+    return m_count == 0;
+}
+
+const InetAddress &DatagramBatch::address() const
+{
+    return m_address;
+}
+
+const std::vector<uint8_t> &DatagramBatch::buffer() const
+{
+    return m_buffer;
+}
+
+size_t DatagramBatch::segmentSize() const
+{
+    return m_segmentSize;
+}
+
+} // namespace udp
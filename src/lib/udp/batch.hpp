@@ -0,0 +1,49 @@
+//
+// This file is a part of UERANSIM project.
+// Copyright (c) 2023 ALİ GÜNGÖR.
+//
+// https://github.com/aligungr/UERANSIM/
+// See README, LICENSE, and CONTRIBUTING files for licensing details.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <utils/network.hpp>
+
+namespace udp
+{
+
+/*
+ * Consecutive datagrams to the same address, sent with a single system call by means of UDP segmentation offload.
+ * All datagrams must have the same size, except the last one which may be shorter.
+ */
+class DatagramBatch
+{
+  public:
+    static constexpr const size_t MAX_SEGMENTS = 64;
+    static constexpr const size_t MAX_SIZE = 65000;
+
+  private:
+    InetAddress m_address;
+    std::vector<uint8_t> m_buffer;
+    size_t m_segmentSize;
+    size_t m_count;
+
+  public:
+    DatagramBatch();
+
+  public:
+    /* Returns false if the datagram does not fit into the batch, the batch must be sent first in that case */
+    bool append(const InetAddress &address, const uint8_t *data, size_t size);
+    void clear();
+
+    [[nodiscard]] bool isEmpty() const;
+    [[nodiscard]] const InetAddress &address() const;
+    [[nodiscard]] const std::vector<uint8_t> &buffer() const;
+    [[nodiscard]] size_t segmentSize() const;
+};
+
+} // namespace udp
@@ -30,20 +30,59 @@ int UdpServer::Receive(uint8_t *buffer, size_t bufferSize, int timeoutMs, InetAd
     return socket.receive(buffer, bufferSize, timeoutMs, outPeerAddress);
 }
 
+int UdpServer::Receive(uint8_t *buffer, size_t bufferSize, int timeoutMs, InetAddress &outPeerAddress,
+                       size_t &outSegmentSize) const
+{
+    auto socket = Socket::Select(sockets, {}, timeoutMs);
+    if (!socket.hasFd())
+        return 0;
+    return socket.receive(buffer, bufferSize, timeoutMs, outPeerAddress, outSegmentSize);
+}
+
 void UdpServer::Send(const InetAddress &address, const uint8_t *buffer, size_t bufferSize) const
+{
+    findSocket(address).send(address, buffer, bufferSize);
+}
+
+void UdpServer::Send(const InetAddress &address, const uint8_t *buffer, size_t bufferSize, DatagramBatch &batch) const
+{
+    if (batch.append(address, buffer, bufferSize))
+        return;
+
+    Send(batch);
+
+    if (!batch.append(address, buffer, bufferSize))
+        Send(address, buffer, bufferSize);
+}
+
+void UdpServer::Send(DatagramBatch &batch) const
+{
+    if (batch.isEmpty())
+        return;
+
+    auto &buffer = batch.buffer();
+    findSocket(batch.address()).sendSegments(batch.address(), buffer.data(), buffer.size(), batch.segmentSize());
+    batch.clear();
+}
+
+bool UdpServer::EnableReceiveOffload() const
+{
+    bool enabled = true;
+    for (const Socket &s : sockets)
+        if (s.hasFd())
+            enabled &= s.setReceiveOffload();
+    return enabled;
+}
+
+const Socket &UdpServer::findSocket(const InetAddress &address) const
 {
     int version = address.getIpVersion();
     if (version != 4 && version != 6)
         throw std::runtime_error{"UdpServer::Send failure: Invalid IP version"};
 
     for (const Socket &s : sockets)
-    {
         if (s.hasFd() && s.getIpVersion() == version)
-        {
-            s.send(address, buffer, bufferSize);
-            return;
-        }
-    }
+            return s;
 
     throw std::runtime_error{"UdpServer::Send failure: No IP socket found"};
 }
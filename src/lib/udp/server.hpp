@@ -8,6 +8,8 @@
 
 #pragma once
 
+#include "batch.hpp"
+
 #include <string>
 #include <utils/network.hpp>
 
@@ -25,7 +27,18 @@ class UdpServer
     ~UdpServer();
 
     int Receive(uint8_t *buffer, size_t bufferSize, int timeoutMs, InetAddress &outPeerAddress) const;
+    int Receive(uint8_t *buffer, size_t bufferSize, int timeoutMs, InetAddress &outPeerAddress,
+                size_t &outSegmentSize) const;
     void Send(const InetAddress &address, const uint8_t *buffer, size_t bufferSize) const;
+
+    /* The datagram is appended to the batch, which is sent beforehand if the datagram does not fit into it */
+    void Send(const InetAddress &address, const uint8_t *buffer, size_t bufferSize, DatagramBatch &batch) const;
+    void Send(DatagramBatch &batch) const;
+
+    bool EnableReceiveOffload() const;
+
+  private:
+    const Socket &findSocket(const InetAddress &address) const;
 };
 
 } // namespace udp
@@ -6,10 +6,13 @@
 // See README, LICENSE, and CONTRIBUTING files for licensing details.
 //
 
+#include <algorithm>
 #include <chrono>
 #include <iostream>
+#include <queue>
 #include <stdexcept>
 #include <thread>
+#include <unordered_map>
 
 #include <unistd.h>
 
@@ -18,6 +21,11 @@
 #include <lib/app/cli_cmd.hpp>
 #include <lib/app/proc_table.hpp>
 #include <lib/app/ue_ctl.hpp>
+#include <ue/mobility.hpp>
+#include <ue/paging.hpp>
+#include <ue/snapshot.hpp>
+#include <ue/sysinfo_cache.hpp>
+#include <ue/tun/tun.hpp>
 #include <ue/ue.hpp>
 #include <utils/common.hpp>
 #include <utils/concurrent_map.hpp>
@@ -33,6 +41,10 @@ static app::CliServer *g_cliServer = nullptr;
 static nr::ue::UeConfig *g_refConfig = nullptr;
 static ConcurrentMap<std::string, nr::ue::UserEquipment *> g_ueMap{};
 static app::CliResponseTask *g_cliRespTask = nullptr;
+static nr::ue::UeSnapshotFile *g_snapshotFile = nullptr;
+static nr::ue::UeSystemInfoCache *g_siCache = nullptr;
+static nr::ue::UeMobilityTask *g_mobilityTask = nullptr;
+static nr::ue::UePagingListener *g_pagingListener = nullptr;
 
 static struct Options
 {
@@ -40,6 +52,8 @@ static struct Options
     bool noRoutingConfigs{};
     bool disableCmd{};
     std::string imsi{};
+    std::string snapshotFile{};
+    int hibernateDelay{};
     int count{};
     int tempo{};
 } g_options{};
@@ -49,18 +63,43 @@ struct NwUeControllerCmd : NtsMessage
     enum PR
     {
         PERFORM_SWITCH_OFF,
+        PERFORM_HIBERNATION,
+        PERFORM_PAGING,
     } present;
 
     // PERFORM_SWITCH_OFF
     nr::ue::UserEquipment *ue{};
 
+    // PERFORM_HIBERNATION
+    std::string nodeName{};
+
+    // PERFORM_PAGING
+    std::vector<GutiMobileIdentity> tmsiIds{};
+
     explicit NwUeControllerCmd(PR present) : NtsMessage(NtsMessageType::UE_CTL_COMMAND), present(present)
     {
     }
 };
 
+static constexpr const int TIMER_ID_WAKE_UP = 1;
+
+static uint64_t PagingKey(const GutiMobileIdentity &tmsi)
+{
+    return (static_cast<uint64_t>(tmsi.amfSetId) << 38) | (static_cast<uint64_t>(tmsi.amfPointer) << 32) |
+           static_cast<uint64_t>(static_cast<uint32_t>(tmsi.tmsi));
+}
+
 class UeControllerTask : public NtsTask
 {
+  private:
+    // Hibernated UEs by their wake up times, the entries of the UEs woken up earlier are skipped when due
+    std::priority_queue<std::pair<int64_t, std::string>, std::vector<std::pair<int64_t, std::string>>,
+                        std::greater<>>
+        m_wakeUps{};
+
+    // Hibernated UEs by their 5G-S-TMSIs, the entries of the UEs woken up or re-registered meanwhile are skipped
+    std::unordered_map<uint64_t, std::string> m_pagingFilter{};
+
   protected:
     void onStart() override
     {
@@ -92,8 +131,66 @@ class UeControllerTask : public NtsTask
                 delete w.ue;
                 break;
             }
+            case NwUeControllerCmd::PERFORM_HIBERNATION: {
+                auto *ue = g_ueMap.getOrDefault(w.nodeName);
+                if (ue == nullptr)
+                    return;
+
+                int64_t wakeTime = ue->hibernate();
+
+                auto tmsi = ue->pagingTmsi();
+                if (tmsi.has_value())
+                    m_pagingFilter[PagingKey(*tmsi)] = w.nodeName;
+
+                if (wakeTime == 0)
+                    return;
+
+                if (m_wakeUps.empty() || wakeTime < m_wakeUps.top().first)
+                    setTimerAbsolute(TIMER_ID_WAKE_UP, wakeTime);
+                m_wakeUps.emplace(wakeTime, w.nodeName);
+                break;
+            }
+            case NwUeControllerCmd::PERFORM_PAGING: {
+                for (auto &tmsi : w.tmsiIds)
+                {
+                    auto it = m_pagingFilter.find(PagingKey(tmsi));
+                    if (it == m_pagingFilter.end())
+                        continue;
+
+                    auto *ue = g_ueMap.getOrDefault(it->second);
+                    m_pagingFilter.erase(it);
+
+                    auto current = ue != nullptr ? ue->pagingTmsi() : std::nullopt;
+                    if (current.has_value() && PagingKey(*current) == PagingKey(tmsi))
+                        ue->page(w.tmsiIds);
+                }
+                break;
+            }
             }
         }
+        else if (msg->msgType == NtsMessageType::TIMER_EXPIRED)
+        {
+            auto &w = dynamic_cast<NmTimerExpired &>(*msg);
+            if (w.timerId == TIMER_ID_WAKE_UP)
+                wakeUpDueUes();
+        }
+    }
+
+    void wakeUpDueUes()
+    {
+        int64_t now = utils::CurrentTimeMillis();
+        while (!m_wakeUps.empty() && m_wakeUps.top().first <= now)
+        {
+            auto entry = m_wakeUps.top();
+            m_wakeUps.pop();
+
+            auto *ue = g_ueMap.getOrDefault(entry.second);
+            if (ue != nullptr && ue->wakeTime() == entry.first)
+                ue->wakeUp();
+        }
+
+        if (!m_wakeUps.empty())
+            setTimerAbsolute(TIMER_ID_WAKE_UP, m_wakeUps.top().first);
     }
 
     void onQuit() override
@@ -103,6 +200,73 @@ class UeControllerTask : public NtsTask
 
 static UeControllerTask *g_controllerTask;
 
+static nr::ue::MobilityConfig ReadMobilityConfig(const YAML::Node &node)
+{
+    nr::ue::MobilityConfig result{};
+
+    auto model = yaml::GetString(node, "model");
+    if (model == "static")
+        result.model = nr::ue::EMobilityModel::STATIC;
+    else if (model == "random-waypoint")
+        result.model = nr::ue::EMobilityModel::RANDOM_WAYPOINT;
+    else if (model == "highway")
+        result.model = nr::ue::EMobilityModel::HIGHWAY;
+    else if (model == "trace")
+        result.model = nr::ue::EMobilityModel::TRACE;
+    else
+        throw std::runtime_error("Invalid mobility model: " + model);
+
+    if (yaml::HasField(node, "updatePeriod"))
+        result.updatePeriod = yaml::GetInt32(node, "updatePeriod", 10, 60'000);
+
+    if (result.model == nr::ue::EMobilityModel::TRACE)
+    {
+        result.traceFile = yaml::GetString(node, "traceFile");
+    }
+    else
+    {
+        yaml::AssertHasField(node, "area");
+        auto area = node["area"];
+        result.minX = yaml::GetInt32(area, "minX");
+        result.maxX = yaml::GetInt32(area, "maxX");
+        result.minY = yaml::GetInt32(area, "minY");
+        result.maxY = yaml::GetInt32(area, "maxY");
+        if (result.minX > result.maxX || result.minY > result.maxY)
+            throw std::runtime_error("Invalid mobility area");
+    }
+
+    if (yaml::HasField(node, "speed"))
+    {
+        result.minSpeed = yaml::GetDouble(node["speed"], "min", 0.0, 1000.0);
+        result.maxSpeed = yaml::GetDouble(node["speed"], "max", result.minSpeed, 1000.0);
+    }
+    if (yaml::HasField(node, "pause"))
+        result.pause = yaml::GetInt32(node, "pause", 0, 3'600'000);
+    if (yaml::HasField(node, "lanes"))
+        result.lanes = yaml::GetInt32(node, "lanes", 1, 64);
+    if (yaml::HasField(node, "laneSpacing"))
+        result.laneSpacing = yaml::GetInt32(node, "laneSpacing", 0, 1000);
+    if (yaml::HasField(node, "seed"))
+        result.seed = static_cast<uint32_t>(yaml::GetInt64(node, "seed", 0, UINT32_MAX));
+
+    if (yaml::HasField(node, "cells"))
+    {
+        for (auto &cell : yaml::GetSequence(node, "cells"))
+        {
+            nr::ue::MobilityCell c{};
+            c.address = yaml::GetString(cell, "address");
+            c.position.x = yaml::GetInt32(cell, "x");
+            c.position.y = yaml::GetInt32(cell, "y");
+            c.position.z = yaml::GetInt32(cell, "z");
+            result.cells.push_back(c);
+        }
+    }
+    if (yaml::HasField(node, "cellRange"))
+        result.cellRange = yaml::GetInt32(node, "cellRange", 0, 1'000'000);
+
+    return result;
+}
+
 static nr::ue::UeConfig *ReadConfigYaml()
 {
     auto *result = new nr::ue::UeConfig();
@@ -255,6 +419,17 @@ static nr::ue::UeConfig *ReadConfigYaml()
         result->uacAcc.cls15 = yaml::GetBool(config["uacAcc"], "class15");
     }
 
+    if (yaml::HasField(config, "safetyCycle"))
+    {
+        if (yaml::HasField(config["safetyCycle"], "mm"))
+            result->safetyCycle.mm = yaml::GetInt32(config["safetyCycle"], "mm", 0, 3'600'000);
+        if (yaml::HasField(config["safetyCycle"], "rrc"))
+            result->safetyCycle.rrc = yaml::GetInt32(config["safetyCycle"], "rrc", 0, 3'600'000);
+    }
+
+    if (yaml::HasField(config, "mobility"))
+        result->mobility = ReadMobilityConfig(config["mobility"]);
+
     return result;
 }
 
@@ -273,6 +448,10 @@ static void ReadOptions(int argc, char **argv)
                                       std::nullopt};
     opt::OptionItem itemDisableRouting = {'r', "no-routing-config",
                                           "Do not auto configure routing for UE TUN interface", std::nullopt};
+    opt::OptionItem itemSnapshot = {'s', "snapshot", "Keep UE states in specified file to resume them after restart",
+                                    "snapshot-file"};
+    opt::OptionItem itemHibernate = {'H', "hibernate", "Hibernate the registered UEs after being idle for given ms",
+                                     "delay"};
 
     desc.items.push_back(itemConfigFile);
     desc.items.push_back(itemImsi);
@@ -280,17 +459,28 @@ static void ReadOptions(int argc, char **argv)
     desc.items.push_back(itemTempo);
     desc.items.push_back(itemDisableCmd);
     desc.items.push_back(itemDisableRouting);
+    desc.items.push_back(itemSnapshot);
+    desc.items.push_back(itemHibernate);
 
     opt::OptionsResult opt{argc, argv, desc, false, nullptr};
 
     g_options.configFile = opt.getOption(itemConfigFile);
     g_options.noRoutingConfigs = opt.hasFlag(itemDisableRouting);
+
+    if (opt.hasFlag(itemHibernate))
+    {
+        g_options.hibernateDelay = utils::ParseInt(opt.getOption(itemHibernate));
+        if (g_options.hibernateDelay <= 0)
+            throw std::runtime_error("Invalid hibernation delay");
+    }
+
     if (opt.hasFlag(itemCount))
     {
+        // Hibernated UEs have no threads, so many more of them fit into a process
         g_options.count = utils::ParseInt(opt.getOption(itemCount));
         if (g_options.count <= 0)
             throw std::runtime_error("Invalid number of UEs");
-        if (g_options.count > 512)
+        if (g_options.count > (g_options.hibernateDelay > 0 ? 100'000 : 512))
             throw std::runtime_error("Number of UEs is too big");
     }
     else
@@ -317,6 +507,9 @@ static void ReadOptions(int argc, char **argv)
     }
 
     g_options.disableCmd = opt.hasFlag(itemDisableCmd);
+
+    if (opt.hasFlag(itemSnapshot))
+        g_options.snapshotFile = opt.getOption(itemSnapshot);
 }
 
 static std::string LargeSum(std::string a, std::string b)
@@ -380,10 +573,18 @@ static nr::ue::UeConfig *GetConfigByUe(int ueIndex)
     c->integrityMaxRate = g_refConfig->integrityMaxRate;
     c->uacAic = g_refConfig->uacAic;
     c->uacAcc = g_refConfig->uacAcc;
+    c->safetyCycle = g_refConfig->safetyCycle;
     c->caCertificate = g_refConfig->caCertificate;
     c->clientCertificate = g_refConfig->clientCertificate;
     c->clientPrivateKey = g_refConfig->clientPrivateKey;
 
+    c->snapshotFile = g_snapshotFile;
+    c->snapshotSlot = ueIndex;
+    c->siCache = g_siCache;
+    c->mobilityTask = g_mobilityTask;
+    c->mobilitySlot = ueIndex;
+    c->hibernateDelay = g_options.hibernateDelay;
+
     if (c->supi.has_value())
         IncrementNumber(c->supi->value, ueIndex);
     if (c->imei.has_value())
@@ -435,6 +636,30 @@ static void ReceiveCommand(app::CliMessage &msg)
         return;
     }
 
+    if (app::IsNodeSelector(msg.nodeName))
+    {
+        std::vector<std::pair<std::string, nr::ue::UserEquipment *>> targets{};
+        g_ueMap.invokeForeach([&targets, &msg](const auto &item) {
+            if (app::MatchesNodeSelector(msg.nodeName, item.first))
+                targets.emplace_back(item.first, item.second);
+        });
+
+        if (targets.empty())
+        {
+            g_cliServer->sendMessage(app::CliMessage::Error(msg.clientAddr, "No node matches: " + msg.nodeName));
+            return;
+        }
+
+        std::vector<std::string> nodes{};
+        for (auto &target : targets)
+            nodes.push_back(target.first);
+        g_cliRespTask->push(std::make_unique<app::NwCliBulkBegin>(msg.clientAddr, std::move(nodes)));
+
+        for (auto &target : targets)
+            target.second->pushCommand(std::make_unique<app::UeCliCommand>(*cmd), msg.clientAddr);
+        return;
+    }
+
     auto *ue = g_ueMap.getOrDefault(msg.nodeName);
     if (ue == nullptr)
     {
@@ -478,6 +703,23 @@ static void Loop()
     ReceiveCommand(msg);
 }
 
+static void SyncSnapshotFile()
+{
+    g_snapshotFile->sync();
+}
+
+static void PrepareRoutingTables()
+{
+    // Routing tables of all TUN interfaces that may be used are registered at once, rather than one by one upon each
+    // PDU session establishment
+    std::string prefix = g_refConfig->tunName.value_or(cons::TunNamePrefix);
+    int count = g_options.count * std::max<int>(1, static_cast<int>(g_refConfig->defaultSessions.size()));
+
+    std::string error{};
+    if (!nr::ue::tun::TunPrepareRouting(prefix, count, error))
+        std::cerr << "WARNING: Routing tables could not be prepared [" << error << "]" << std::endl;
+}
+
 static class UeController : public app::IUeController
 {
   public:
@@ -487,6 +729,20 @@ static class UeController : public app::IUeController
         w->ue = ue;
         g_controllerTask->push(std::move(w));
     }
+
+    void performHibernation(nr::ue::UserEquipment *ue) override
+    {
+        auto w = std::make_unique<NwUeControllerCmd>(NwUeControllerCmd::PERFORM_HIBERNATION);
+        w->nodeName = ue->getNodeName();
+        g_controllerTask->push(std::move(w));
+    }
+
+    void performPaging(std::vector<GutiMobileIdentity> &&tmsiIds) override
+    {
+        auto w = std::make_unique<NwUeControllerCmd>(NwUeControllerCmd::PERFORM_PAGING);
+        w->tmsiIds = std::move(tmsiIds);
+        g_controllerTask->push(std::move(w));
+    }
 } g_ueController;
 
 int main(int argc, char **argv)
@@ -499,6 +755,13 @@ int main(int argc, char **argv)
         g_refConfig = ReadConfigYaml();
         if (g_options.imsi.length() > 0)
             g_refConfig->supi = Supi::Parse("imsi-" + g_options.imsi);
+        if (!g_options.snapshotFile.empty())
+        {
+            g_snapshotFile = new nr::ue::UeSnapshotFile(g_options.snapshotFile, g_options.count);
+            app::RunAtExit(SyncSnapshotFile);
+        }
+        if (g_refConfig->mobility.has_value())
+            g_mobilityTask = new nr::ue::UeMobilityTask(*g_refConfig->mobility, static_cast<size_t>(g_options.count));
     }
     catch (const std::runtime_error &e)
     {
@@ -508,9 +771,35 @@ int main(int argc, char **argv)
 
     std::cout << cons::Name << std::endl;
 
+    if (g_refConfig->configureRouting)
+        PrepareRoutingTables();
+
+    g_siCache = new nr::ue::UeSystemInfoCache();
+
     g_controllerTask = new UeControllerTask();
     g_controllerTask->start();
 
+    if (g_mobilityTask)
+        g_mobilityTask->start();
+
+    if (g_options.hibernateDelay > 0)
+    {
+        // The gNB positions are known from the mobility configuration, if any
+        std::vector<std::pair<InetAddress, Vector3>> cells{};
+        for (auto &address : g_refConfig->gnbSearchList)
+        {
+            Vector3 position{};
+            if (g_refConfig->mobility.has_value())
+                for (auto &cell : g_refConfig->mobility->cells)
+                    if (cell.address == address)
+                        position = cell.position;
+            cells.emplace_back(InetAddress{address, cons::RadioLinkPort}, position);
+        }
+
+        g_pagingListener = new nr::ue::UePagingListener(std::move(cells), &g_ueController);
+        g_pagingListener->start();
+    }
+
     if (!g_options.disableCmd)
     {
         g_cliServer = new app::CliServer{};
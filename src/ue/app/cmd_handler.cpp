@@ -8,11 +8,16 @@
 
 #include "cmd_handler.hpp"
 
+#include <fstream>
+
+#include <malloc.h>
+
 #include <ue/app/task.hpp>
 #include <ue/nas/task.hpp>
 #include <ue/rls/task.hpp>
 #include <ue/rrc/task.hpp>
 #include <ue/tun/task.hpp>
+#include <ue/ue.hpp>
 #include <utils/common.hpp>
 #include <utils/printer.hpp>
 
@@ -31,17 +36,137 @@ static std::string SignalDescription(int dbm)
     return "Poor";
 }
 
+static size_t HeapSize(const void *ptr)
+{
+    return ptr == nullptr ? 0 : malloc_usable_size(const_cast<void *>(ptr));
+}
+
+static std::string ReadProcStatus(const std::string &field)
+{
+    std::ifstream file{"/proc/self/status"};
+    std::string line;
+    while (std::getline(file, line))
+    {
+        if (line.size() > field.size() && line.compare(0, field.size(), field) == 0 && line[field.size()] == ':')
+        {
+            auto value = line.substr(field.size() + 1);
+            utils::Trim(value);
+            return value;
+        }
+    }
+    return "";
+}
+
 namespace nr::ue
 {
 
+static Json InfoJson(const UeConfig &config, bool isECallOnly, bool isHighPriority)
+{
+    return Json::Obj({
+        {"supi", ToJson(config.supi)},
+        {"hplmn", ToJson(config.hplmn)},
+        {"imei", ::ToJson(config.imei)},
+        {"imeisv", ::ToJson(config.imeiSv)},
+        {"ecall-only", ::ToJson(isECallOnly)},
+        {"uac-aic", Json::Obj({
+                        {"mps", config.uacAic.mps},
+                        {"mcs", config.uacAic.mcs},
+                    })},
+        {"uac-acc", Json::Obj({
+                        {"normal-class", config.uacAcc.normalCls},
+                        {"class-11", config.uacAcc.cls11},
+                        {"class-12", config.uacAcc.cls12},
+                        {"class-13", config.uacAcc.cls13},
+                        {"class-14", config.uacAcc.cls14},
+                        {"class-15", config.uacAcc.cls15},
+                    })},
+        {"is-high-priority", isHighPriority},
+    });
+}
+
+bool HandleHibernatedCmd(const UeConfig &config, const UeHibernatedState &state, const app::UeCliCommand &cmd,
+                         std::string &output)
+{
+    // The state of a UE that left the idle mode meanwhile is not final until it is restored
+    if (!state.isIdle)
+        return false;
+
+    switch (cmd.present)
+    {
+    case app::UeCliCommand::STATUS: {
+        auto registration = DecodeSnapshotRegistration(state.record, config.getNodeName());
+        if (!registration.has_value())
+            return false;
+
+        Json json = Json::Obj({
+            {"cm-state", ToJson(ECmState::CM_IDLE)},
+            {"rm-state", ToJson(registration->rmState)},
+            {"mm-state", ToJson(state.mmSubState)},
+            {"5u-state", ToJson(registration->uState)},
+            {"last-tai", ToJson(registration->lastTai)},
+            {"stored-guti", ToJson(registration->guti)},
+            {"hibernated", true},
+        });
+        output = json.dumpYaml();
+        return true;
+    }
+    case app::UeCliCommand::INFO: {
+        auto &acc = config.uacAcc;
+        output = InfoJson(config, false, acc.cls11 || acc.cls12 || acc.cls13 || acc.cls14 || acc.cls15).dumpYaml();
+        return true;
+    }
+    case app::UeCliCommand::TIMERS: {
+        // Only T3512 may be running for a hibernated UE
+        NasTimers timers{nullptr};
+        if (state.wakeTime != 0)
+            timers.t3512.resume(state.t3512Interval, state.wakeTime);
+        output = ToJson(timers).dumpYaml();
+        return true;
+    }
+    case app::UeCliCommand::PS_LIST: {
+        // A UE with PDU sessions is not hibernated
+        output = Json::Obj({}).dumpYaml();
+        return true;
+    }
+    case app::UeCliCommand::RLS_STATE: {
+        Json json = Json::Obj({
+            {"gnb-search-space", ::ToJson(config.gnbSearchList)},
+            {"hibernated", true},
+        });
+        output = json.dumpYaml();
+        return true;
+    }
+    case app::UeCliCommand::COVERAGE: {
+        output = Json{"No cell available"}.dumpYaml();
+        return true;
+    }
+    case app::UeCliCommand::MEMORY: {
+        auto total = static_cast<int64_t>(sizeof(UeHibernatedState) + state.record.heapUsage());
+        Json json = Json::Obj({
+            {"hibernated-state", total},
+            {"total", total},
+            {"threads", 0},
+            {"process-rss", ReadProcStatus("VmRSS")},
+            {"process-threads", ReadProcStatus("Threads")},
+        });
+        output = json.dumpYaml();
+        return true;
+    }
+    default:
+        return false;
+    }
+}
+
 void UeCmdHandler::sendResult(const InetAddress &address, const std::string &output)
 {
-    m_base->cliCallbackTask->push(std::make_unique<app::NwCliSendResponse>(address, output, false));
+    m_base->cliCallbackTask->push(std::make_unique<app::NwCliSendResponse>(address, output, false,
+                                                                             m_base->config->getNodeName()));
 }
 
 void UeCmdHandler::sendError(const InetAddress &address, const std::string &output)
 {
-    m_base->cliCallbackTask->push(std::make_unique<app::NwCliSendResponse>(address, output, true));
+    m_base->cliCallbackTask->push(std::make_unique<app::NwCliSendResponse>(address, output, true,
+                                                                             m_base->config->getNodeName()));
 }
 
 void UeCmdHandler::pauseTasks()
@@ -110,11 +235,11 @@ void UeCmdHandler::handleCmdImpl(NmUeCliCommand &msg)
         std::optional<int> currentTac = std::nullopt;
 
         auto currentCell = m_base->shCtx.currentCell.get();
-        if (currentCell.hasValue())
+        if (currentCell->hasValue())
         {
-            currentCellId = currentCell.cellId;
-            currentPlmn = currentCell.plmn;
-            currentTac = currentCell.tac;
+            currentCellId = currentCell->cellId;
+            currentPlmn = currentCell->plmn;
+            currentTac = currentCell->tac;
         }
 
         Json json = Json::Obj({
@@ -123,7 +248,7 @@ void UeCmdHandler::handleCmdImpl(NmUeCliCommand &msg)
             {"mm-state", ToJson(m_base->nasTask->mm->m_mmSubState)},
             {"5u-state", ToJson(m_base->nasTask->mm->m_storage->uState->get())},
             {"sim-inserted", m_base->nasTask->mm->m_usim->isValid()},
-            {"selected-plmn", ::ToJson(m_base->shCtx.selectedPlmn.get())},
+            {"selected-plmn", ::ToJson(*m_base->shCtx.selectedPlmn.get())},
             {"current-cell", ::ToJson(currentCellId)},
             {"current-plmn", ::ToJson(currentPlmn)},
             {"current-tac", ::ToJson(currentTac)},
@@ -136,27 +261,8 @@ void UeCmdHandler::handleCmdImpl(NmUeCliCommand &msg)
         break;
     }
     case app::UeCliCommand::INFO: {
-        auto json = Json::Obj({
-            {"supi", ToJson(m_base->config->supi)},
-            {"hplmn", ToJson(m_base->config->hplmn)},
-            {"imei", ::ToJson(m_base->config->imei)},
-            {"imeisv", ::ToJson(m_base->config->imeiSv)},
-            {"ecall-only", ::ToJson(m_base->nasTask->usim->m_isECallOnly)},
-            {"uac-aic", Json::Obj({
-                            {"mps", m_base->config->uacAic.mps},
-                            {"mcs", m_base->config->uacAic.mcs},
-                        })},
-            {"uac-acc", Json::Obj({
-                            {"normal-class", m_base->config->uacAcc.normalCls},
-                            {"class-11", m_base->config->uacAcc.cls11},
-                            {"class-12", m_base->config->uacAcc.cls12},
-                            {"class-13", m_base->config->uacAcc.cls13},
-                            {"class-14", m_base->config->uacAcc.cls14},
-                            {"class-15", m_base->config->uacAcc.cls15},
-                        })},
-            {"is-high-priority", m_base->nasTask->mm->isHighPriority()},
-        });
-
+        auto *nas = m_base->nasTask;
+        auto json = InfoJson(*m_base->config, nas->usim->m_isECallOnly, nas->mm->isHighPriority());
         sendResult(msg.address, json.dumpYaml());
         break;
     }
@@ -217,6 +323,74 @@ void UeCmdHandler::handleCmdImpl(NmUeCliCommand &msg)
         sendResult(msg.address, json.dumpYaml());
         break;
     }
+    case app::UeCliCommand::MEMORY: {
+        auto *nas = m_base->nasTask;
+        auto *rls = m_base->rlsTask;
+
+        size_t nasBytes = HeapSize(nas) + HeapSize(nas->mm) + HeapSize(nas->sm) + HeapSize(nas->usim) +
+                          HeapSize(nas->usim->m_sqnMng.get()) +
+                          nas->usim->m_sqnMng->getSqnArray().capacity() * sizeof(uint64_t);
+        size_t storageBytes = nas->mm->m_storage->memoryUsage();
+
+        size_t securityBytes = 0;
+        for (auto *ctx : {nas->usim->m_currentNsCtx.get(), nas->usim->m_nonCurrentNsCtx.get()})
+        {
+            if (ctx == nullptr)
+                continue;
+            securityBytes += HeapSize(ctx) + ctx->keys.abba.heapUsage() + ctx->keys.kAusf.heapUsage() +
+                             ctx->keys.kSeaf.heapUsage() + ctx->keys.kAmf.heapUsage() +
+                             ctx->keys.kNasInt.heapUsage() + ctx->keys.kNasEnc.heapUsage();
+        }
+
+        size_t sessionBytes = 0;
+        for (auto *ps : nas->sm->m_pduSessions)
+            sessionBytes += HeapSize(ps);
+        size_t transactionBytes = 0;
+        for (auto &pt : nas->sm->m_procedureTransactions)
+            transactionBytes += HeapSize(pt.timer.get()) + HeapSize(pt.message.get());
+
+        size_t rrcBytes = HeapSize(m_base->rrcTask) +
+                          m_base->rrcTask->m_cellDesc.bucket_count() * sizeof(void *) +
+                          m_base->rrcTask->m_cellDesc.size() * sizeof(std::pair<const int, UeCellDesc>);
+        size_t rlsBytes = HeapSize(rls) + HeapSize(rls->m_udpTask) + HeapSize(rls->m_ctlTask);
+
+        size_t appBytes = HeapSize(m_base->appTask);
+        for (auto *tun : m_base->appTask->m_tunTasks)
+            appBytes += HeapSize(tun);
+
+        size_t total = HeapSize(m_base->ue) + HeapSize(m_base) + HeapSize(m_base->config) + HeapSize(m_base->logBase) +
+                       HeapSize(m_base->fastPath) + nasBytes + storageBytes + securityBytes + sessionBytes +
+                       transactionBytes + rrcBytes + rlsBytes + appBytes;
+
+        // Threads that are actually running for this UE
+        int threads = 0;
+        for (NtsTask *task : std::initializer_list<NtsTask *>{nas, m_base->rrcTask, m_base->appTask, rls,
+                                                               rls->m_udpTask, rls->m_ctlTask})
+            if (task != nullptr && task->isRunning())
+                threads++;
+        for (auto *tun : m_base->appTask->m_tunTasks)
+            if (tun != nullptr && tun->isRunning())
+                threads++;
+
+        // Heap memory held by the UE as reported by the allocator, excluding thread stacks. The process totals also
+        // include the memory and threads shared by all the UEs of the process.
+        Json json = Json::Obj({
+            {"nas", static_cast<int64_t>(nasBytes)},
+            {"nas-storage", static_cast<int64_t>(storageBytes)},
+            {"security-contexts", static_cast<int64_t>(securityBytes)},
+            {"pdu-sessions", static_cast<int64_t>(sessionBytes)},
+            {"procedure-transactions", static_cast<int64_t>(transactionBytes)},
+            {"rrc", static_cast<int64_t>(rrcBytes)},
+            {"rls", static_cast<int64_t>(rlsBytes)},
+            {"app", static_cast<int64_t>(appBytes)},
+            {"total", static_cast<int64_t>(total)},
+            {"threads", threads},
+            {"process-rss", ReadProcStatus("VmRSS")},
+            {"process-threads", ReadProcStatus("Threads")},
+        });
+        sendResult(msg.address, json.dumpYaml());
+        break;
+    }
     case app::UeCliCommand::RLS_STATE: {
         Json json = Json::Obj({
             {"sti", OctetString::FromOctet8(m_base->rlsTask->m_shCtx->sti).toHexString()},
@@ -236,21 +410,21 @@ void UeCmdHandler::handleCmdImpl(NmUeCliCommand &msg)
             auto mib = Json{};
             auto sib1 = Json{};
 
-            if (cell.mib.hasMib)
+            if (cell.mib)
             {
                 mib = Json::Obj({
-                    {"barred", cell.mib.isBarred},
+                    {"barred", cell.mib->isBarred},
                     {"intra-freq-reselection",
-                     std::string{cell.mib.isIntraFreqReselectAllowed ? "allowed" : "not-allowed"}},
+                     std::string{cell.mib->isIntraFreqReselectAllowed ? "allowed" : "not-allowed"}},
                 });
             }
-            if (cell.sib1.hasSib1)
+            if (cell.sib1)
             {
                 sib1 = Json::Obj({
-                    {"nr-cell-id", utils::IntToHex(cell.sib1.nci)},
-                    {"plmn", ToJson(cell.sib1.plmn)},
-                    {"tac", cell.sib1.tac},
-                    {"operator-reserved", cell.sib1.isReserved},
+                    {"nr-cell-id", utils::IntToHex(cell.sib1->nci)},
+                    {"plmn", ToJson(cell.sib1->plmn)},
+                    {"tac", cell.sib1->tac},
+                    {"operator-reserved", cell.sib1->isReserved},
                 });
             }
 
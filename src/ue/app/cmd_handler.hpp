@@ -39,4 +39,8 @@ class UeCmdHandler
     void sendError(const InetAddress &address, const std::string &output);
 };
 
+/* Answers a read-only command from the hibernated state, returns false if the UE has to be woken up for the command */
+bool HandleHibernatedCmd(const UeConfig &config, const UeHibernatedState &state, const app::UeCliCommand &cmd,
+                         std::string &output);
+
 } // namespace nr::ue
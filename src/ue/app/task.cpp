@@ -9,6 +9,7 @@
 #include "task.hpp"
 #include "cmd_handler.hpp"
 #include <lib/nas/utils.hpp>
+#include <ue/fast_path.hpp>
 #include <ue/nas/task.hpp>
 #include <ue/rls/task.hpp>
 #include <ue/tun/tun.hpp>
@@ -32,6 +33,9 @@ void UeAppTask::onStart()
 
 void UeAppTask::onQuit()
 {
+    for (int psi = 0; psi < static_cast<int>(m_tunTasks.size()); psi++)
+        m_base->fastPath->setTunDevice(psi, -1);
+
     for (auto &tunTask : m_tunTasks)
     {
         if (tunTask != nullptr)
@@ -130,6 +134,7 @@ void UeAppTask::receiveStatusUpdate(NmUeStatusUpdate &msg)
     {
         if (m_tunTasks[msg.psi] != nullptr)
         {
+            m_base->fastPath->setTunDevice(msg.psi, -1);
             m_tunTasks[msg.psi]->quit();
             delete m_tunTasks[msg.psi];
             m_tunTasks[msg.psi] = nullptr;
@@ -201,6 +206,7 @@ void UeAppTask::setupTunInterface(const PduSession *pduSession)
 
     auto *task = new TunTask(m_base, psi, fd);
     m_tunTasks[psi] = task;
+    m_base->fastPath->setTunDevice(psi, fd);
     task->start();
 
     m_logger->info("Connection setup for PDU session[%d] is successful, TUN interface[%s, %s] is up.", pduSession->psi,
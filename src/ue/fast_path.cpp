@@ -0,0 +1,113 @@
+//
+// This file is a part of UERANSIM project.
+// Copyright (c) 2023 ALİ GÜNGÖR.
+//
+// https://github.com/aligungr/UERANSIM/
+// See README, LICENSE, and CONTRIBUTING files for licensing details.
+//
+
+#include "fast_path.hpp"
+
+#include <unistd.h>
+
+#include <lib/rls/rls_pdu.hpp>
+#include <ue/types.hpp>
+
+namespace nr::ue
+{
+
+UserPlaneFastPath::UserPlaneFastPath()
+    : m_mutex{}, m_sessions{}, m_cells{}, m_servingCell{}, m_server{}, m_rlsCtx{}
+{
+}
+
+void UserPlaneFastPath::setForwarding(int psi, bool uplink, bool downlink)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_sessions[psi].uplink = uplink;
+    m_sessions[psi].downlink = downlink;
+}
+
+void UserPlaneFastPath::setTunDevice(int psi, int fd)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_sessions[psi].tunFd = fd;
+}
+
+void UserPlaneFastPath::attachRadioLink(const udp::UdpServer *server, RlsSharedContext *rlsCtx)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_server = server;
+    m_rlsCtx = rlsCtx;
+}
+
+void UserPlaneFastPath::setCellLink(int cellId, const InetAddress &address, uint64_t sti)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_cells[cellId] = CellLink{address, sti};
+}
+
+void UserPlaneFastPath::removeCellLink(int cellId)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_cells.erase(cellId);
+}
+
+void UserPlaneFastPath::setServingCell(int cellId)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_servingCell = cellId;
+}
+
+bool UserPlaneFastPath::sendUplink(int psi, const uint8_t *data, size_t length)
+{
+    const udp::UdpServer *server;
+    CellLink cell;
+    uint64_t sti;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (psi < 0 || psi >= static_cast<int>(m_sessions.size()))
+            return false;
+        if (!m_sessions[psi].uplink || m_server == nullptr)
+            return false;
+
+        auto it = m_cells.find(m_servingCell);
+        if (it == m_cells.end())
+            return false;
+
+        server = m_server;
+        cell = it->second;
+        sti = m_rlsCtx->sti;
+    }
+
+    rls::RlsPduTransmission msg{sti};
+    msg.pduType = rls::EPduType::DATA;
+    msg.pdu = OctetString::FromArray(data, length);
+    msg.payload = static_cast<uint32_t>(psi);
+    msg.pduId = 0;
+
+    OctetString stream;
+    rls::EncodeRlsMessage(msg, cell.sti, stream);
+
+    server->Send(cell.address, stream.data(), static_cast<size_t>(stream.length()));
+    return true;
+}
+
+bool UserPlaneFastPath::deliverDownlink(int psi, const OctetString &data)
+{
+    // The lock is held during the write so that the device is not closed meanwhile
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (psi < 0 || psi >= static_cast<int>(m_sessions.size()))
+        return false;
+
+    auto &session = m_sessions[psi];
+    if (!session.downlink || session.tunFd < 0)
+        return false;
+
+    // A failed write only drops the packet
+    (void)::write(session.tunFd, data.data(), static_cast<size_t>(data.length()));
+    return true;
+}
+
+} // namespace nr::ue
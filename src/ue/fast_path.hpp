@@ -0,0 +1,77 @@
+//
+// This file is a part of UERANSIM project.
+// Copyright (c) 2023 ALİ GÜNGÖR.
+//
+// https://github.com/aligungr/UERANSIM/
+// See README, LICENSE, and CONTRIBUTING files for licensing details.
+//
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+
+#include <lib/udp/server.hpp>
+#include <utils/network.hpp>
+#include <utils/octet_string.hpp>
+
+namespace nr::ue
+{
+
+struct RlsSharedContext;
+
+/*
+ * Forwarding state of the user plane. NAS allows the forwarding per PDU session, RLS provides the serving cell and App
+ * provides the TUN devices. While all of them are in place, uplink packets are sent to the serving cell by the TUN
+ * receivers and downlink packets are written to the TUN devices by RLS, without passing through App and NAS tasks.
+ * Otherwise the packets take the regular path through the tasks.
+ */
+class UserPlaneFastPath
+{
+  private:
+    struct CellLink
+    {
+        InetAddress address{};
+        uint64_t sti{};
+    };
+
+    struct Session
+    {
+        bool uplink{};
+        bool downlink{};
+        int tunFd = -1;
+    };
+
+  private:
+    std::mutex m_mutex;
+    std::array<Session, 16> m_sessions;
+    std::unordered_map<int, CellLink> m_cells;
+    int m_servingCell;
+    const udp::UdpServer *m_server;
+    RlsSharedContext *m_rlsCtx;
+
+  public:
+    UserPlaneFastPath();
+
+  public:
+    /* NAS */
+    void setForwarding(int psi, bool uplink, bool downlink);
+
+    /* App */
+    void setTunDevice(int psi, int fd);
+
+    /* RLS */
+    void attachRadioLink(const udp::UdpServer *server, RlsSharedContext *rlsCtx);
+    void setCellLink(int cellId, const InetAddress &address, uint64_t sti);
+    void removeCellLink(int cellId);
+    void setServingCell(int cellId);
+
+    /* Data, these return false if the packet must take the regular path */
+    bool sendUplink(int psi, const uint8_t *data, size_t length);
+    bool deliverDownlink(int psi, const OctetString &data);
+};
+
+} // namespace nr::ue
@@ -0,0 +1,360 @@
+//
+// This file is a part of UERANSIM project.
+// Copyright (c) 2023 ALİ GÜNGÖR.
+//
+// https://github.com/aligungr/UERANSIM/
+// See README, LICENSE, and CONTRIBUTING files for licensing details.
+//
+
+#include "mobility.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+
+#include <utils/common.hpp>
+#include <utils/io.hpp>
+
+static constexpr const int TIMER_ID_UPDATE = 1;
+
+static int64_t GridCoordinate(double value, int cellRange)
+{
+    return static_cast<int64_t>(std::floor(value / cellRange));
+}
+
+static int64_t GridKey(int64_t x, int64_t y)
+{
+    return static_cast<int64_t>((static_cast<uint64_t>(x) << 32) ^ (static_cast<uint64_t>(y) & 0xFFFFFFFFull));
+}
+
+namespace nr::ue
+{
+
+UeMobilityTask::UeMobilityTask(const MobilityConfig &config, size_t count)
+    : m_config{config}, m_count{count}, m_random{config.seed.value_or(std::random_device{}())}, m_startTime{},
+      m_lastUpdate{}, m_posX(count), m_posY(count), m_posZ(count), m_velX(count), m_velY(count), m_targetX(count),
+      m_targetY(count), m_pauseUntil(count), m_traces{}, m_traceDuration{}, m_positions{}, m_cellGrid{},
+      m_cellMismatch(config.cells.size())
+{
+    m_startTime = utils::CurrentTimeMillis();
+    m_lastUpdate = m_startTime;
+
+    if (m_config.model == EMobilityModel::TRACE)
+    {
+        loadTraces();
+        updateTrace(m_startTime);
+    }
+    else
+    {
+        placeUes();
+    }
+
+    if (m_config.cellRange > 0)
+    {
+        for (size_t i = 0; i < m_config.cells.size(); i++)
+        {
+            auto &position = m_config.cells[i].position;
+            int64_t key = GridKey(GridCoordinate(position.x, m_config.cellRange),
+                                  GridCoordinate(position.y, m_config.cellRange));
+            m_cellGrid[key].push_back(static_cast<int>(i));
+        }
+    }
+
+    publishPositions();
+}
+
+void UeMobilityTask::onStart()
+{
+    if (m_config.model != EMobilityModel::STATIC)
+        setTimer(TIMER_ID_UPDATE, m_config.updatePeriod);
+}
+
+void UeMobilityTask::onLoop()
+{
+    auto msg = take();
+    if (!msg)
+        return;
+
+    if (msg->msgType == NtsMessageType::TIMER_EXPIRED)
+    {
+        auto &w = dynamic_cast<NmTimerExpired &>(*msg);
+        if (w.timerId == TIMER_ID_UPDATE)
+        {
+            setTimer(TIMER_ID_UPDATE, m_config.updatePeriod);
+            update(utils::CurrentTimeMillis());
+        }
+    }
+}
+
+void UeMobilityTask::onQuit()
+{
+}
+
+Vector3 UeMobilityTask::positionOf(int slot)
+{
+    Vector3 position{};
+    m_positions.access([slot, &position](auto &positions) {
+        if (slot >= 0 && static_cast<size_t>(slot) < positions.size())
+            position = positions[slot];
+    });
+    return position;
+}
+
+int UeMobilityTask::cellIndexOf(const std::string &address) const
+{
+    for (size_t i = 0; i < m_config.cells.size(); i++)
+        if (m_config.cells[i].address == address)
+            return static_cast<int>(i);
+    return -1;
+}
+
+void UeMobilityTask::findNearbyCells(const Vector3 &position, std::vector<int> &cells) const
+{
+    cells.clear();
+
+    if (m_config.cellRange <= 0)
+    {
+        for (size_t i = 0; i < m_config.cells.size(); i++)
+            cells.push_back(static_cast<int>(i));
+        return;
+    }
+
+    // The grid is as large as the range, so the cells in the range are among the neighbouring grid squares
+    int64_t gridX = GridCoordinate(position.x, m_config.cellRange);
+    int64_t gridY = GridCoordinate(position.y, m_config.cellRange);
+    double rangeSquared = static_cast<double>(m_config.cellRange) * m_config.cellRange;
+
+    for (int64_t x = gridX - 1; x <= gridX + 1; x++)
+    {
+        for (int64_t y = gridY - 1; y <= gridY + 1; y++)
+        {
+            auto it = m_cellGrid.find(GridKey(x, y));
+            if (it == m_cellGrid.end())
+                continue;
+
+            for (int cell : it->second)
+            {
+                auto &cellPosition = m_config.cells[cell].position;
+                auto deltaX = static_cast<double>(cellPosition.x) - position.x;
+                auto deltaY = static_cast<double>(cellPosition.y) - position.y;
+                auto deltaZ = static_cast<double>(cellPosition.z) - position.z;
+                if (deltaX * deltaX + deltaY * deltaY + deltaZ * deltaZ <= rangeSquared)
+                    cells.push_back(cell);
+            }
+        }
+    }
+}
+
+bool UeMobilityTask::checkCellPosition(int cell, const Vector3 &position)
+{
+    if (cell < 0 || static_cast<size_t>(cell) >= m_config.cells.size())
+        return true;
+
+    auto &configured = m_config.cells[cell].position;
+    if (configured.x == position.x && configured.y == position.y && configured.z == position.z)
+        return true;
+
+    // Only the first UE that notices the mismatch reports it
+    return m_cellMismatch[cell].exchange(true);
+}
+
+void UeMobilityTask::loadTraces()
+{
+    m_traces.resize(m_count);
+
+    if (!io::IsRegularFile(m_config.traceFile))
+        throw std::runtime_error("Mobility trace file not found: " + m_config.traceFile);
+
+    std::stringstream stream{io::ReadAllText(m_config.traceFile)};
+    std::string line;
+    while (std::getline(stream, line))
+    {
+        utils::Trim(line);
+        if (line.empty() || line[0] == '#')
+            continue;
+
+        // Each line is "timeMs,ueIndex,x,y,z"
+        std::replace(line.begin(), line.end(), ',', ' ');
+        std::stringstream fields{line};
+
+        TracePoint point{};
+        size_t ue{};
+        if (!(fields >> point.time >> ue >> point.x >> point.y >> point.z) || point.time < 0)
+            throw std::runtime_error("Invalid mobility trace line: " + line);
+
+        if (ue < m_count)
+            m_traces[ue].push_back(point);
+        m_traceDuration = std::max(m_traceDuration, point.time);
+    }
+
+    for (auto &trace : m_traces)
+        std::sort(trace.begin(), trace.end(), [](auto &a, auto &b) { return a.time < b.time; });
+}
+
+void UeMobilityTask::placeUes()
+{
+    std::uniform_real_distribution<float> randomX(static_cast<float>(m_config.minX), static_cast<float>(m_config.maxX));
+    std::uniform_real_distribution<float> randomY(static_cast<float>(m_config.minY), static_cast<float>(m_config.maxY));
+
+    for (size_t i = 0; i < m_count; i++)
+    {
+        m_posX[i] = randomX(m_random);
+        m_posY[i] = randomY(m_random);
+
+        if (m_config.model == EMobilityModel::HIGHWAY)
+        {
+            // Traffic of the consecutive lanes is in the opposite directions
+            int lane = static_cast<int>(i % static_cast<size_t>(m_config.lanes));
+            m_posY[i] = static_cast<float>(m_config.minY + lane * m_config.laneSpacing);
+            m_velX[i] = lane % 2 == 0 ? randomSpeed() : -randomSpeed();
+        }
+    }
+}
+
+void UeMobilityTask::update(int64_t time)
+{
+    float elapsed = static_cast<float>(time - m_lastUpdate) / 1000.0f;
+    m_lastUpdate = time;
+
+    if (m_config.model == EMobilityModel::TRACE)
+    {
+        updateTrace(time);
+        publishPositions();
+        return;
+    }
+
+    // Linear motion of all the UEs in a single branch-free pass
+    float *posX = m_posX.data();
+    float *posY = m_posY.data();
+    const float *velX = m_velX.data();
+    const float *velY = m_velY.data();
+    for (size_t i = 0; i < m_count; i++)
+    {
+        posX[i] += velX[i] * elapsed;
+        posY[i] += velY[i] * elapsed;
+    }
+
+    if (m_config.model == EMobilityModel::RANDOM_WAYPOINT)
+        updateRandomWaypoint(time);
+    else if (m_config.model == EMobilityModel::HIGHWAY)
+        updateHighway();
+
+    publishPositions();
+}
+
+void UeMobilityTask::updateRandomWaypoint(int64_t time)
+{
+    std::uniform_real_distribution<float> randomX(static_cast<float>(m_config.minX), static_cast<float>(m_config.maxX));
+    std::uniform_real_distribution<float> randomY(static_cast<float>(m_config.minY), static_cast<float>(m_config.maxY));
+
+    for (size_t i = 0; i < m_count; i++)
+    {
+        if (m_velX[i] == 0.0f && m_velY[i] == 0.0f)
+        {
+            if (time >= m_pauseUntil[i])
+            {
+                float x = randomX(m_random);
+                float y = randomY(m_random);
+                startMovingTowards(i, x, y);
+            }
+            continue;
+        }
+
+        // The waypoint is reached once it is no longer ahead in the direction of the motion
+        float deltaX = m_targetX[i] - m_posX[i];
+        float deltaY = m_targetY[i] - m_posY[i];
+        if (deltaX * m_velX[i] + deltaY * m_velY[i] <= 0.0f)
+        {
+            m_posX[i] = m_targetX[i];
+            m_posY[i] = m_targetY[i];
+            m_velX[i] = 0.0f;
+            m_velY[i] = 0.0f;
+            m_pauseUntil[i] = time + m_config.pause;
+        }
+    }
+}
+
+void UeMobilityTask::updateHighway()
+{
+    auto length = static_cast<float>(m_config.maxX - m_config.minX);
+    if (length <= 0.0f)
+        return;
+
+    // The road is circular, the UEs leaving at one end enter from the other
+    for (size_t i = 0; i < m_count; i++)
+    {
+        if (m_posX[i] > static_cast<float>(m_config.maxX))
+            m_posX[i] -= length;
+        else if (m_posX[i] < static_cast<float>(m_config.minX))
+            m_posX[i] += length;
+    }
+}
+
+void UeMobilityTask::updateTrace(int64_t time)
+{
+    // The trace is repeated once it is over
+    int64_t elapsed = time - m_startTime;
+    if (m_traceDuration > 0)
+        elapsed %= m_traceDuration;
+
+    for (size_t i = 0; i < m_count; i++)
+    {
+        auto &trace = m_traces[i];
+        if (trace.empty())
+            continue;
+
+        auto next = std::upper_bound(trace.begin(), trace.end(), elapsed,
+                                     [](int64_t value, auto &point) { return value < point.time; });
+
+        if (next == trace.begin() || next == trace.end())
+        {
+            auto &point = next == trace.begin() ? trace.front() : trace.back();
+            m_posX[i] = point.x;
+            m_posY[i] = point.y;
+            m_posZ[i] = point.z;
+            continue;
+        }
+
+        auto &previous = *(next - 1);
+        float ratio = static_cast<float>(elapsed - previous.time) / static_cast<float>(next->time - previous.time);
+        m_posX[i] = previous.x + (next->x - previous.x) * ratio;
+        m_posY[i] = previous.y + (next->y - previous.y) * ratio;
+        m_posZ[i] = previous.z + (next->z - previous.z) * ratio;
+    }
+}
+
+void UeMobilityTask::startMovingTowards(size_t ue, float x, float y)
+{
+    float deltaX = x - m_posX[ue];
+    float deltaY = y - m_posY[ue];
+    float distance = std::sqrt(deltaX * deltaX + deltaY * deltaY);
+    float speed = randomSpeed();
+    if (distance < 1.0f || speed <= 0.0f)
+        return;
+
+    m_targetX[ue] = x;
+    m_targetY[ue] = y;
+    m_velX[ue] = deltaX / distance * speed;
+    m_velY[ue] = deltaY / distance * speed;
+}
+
+void UeMobilityTask::publishPositions()
+{
+    std::vector<Vector3> positions(m_count);
+    for (size_t i = 0; i < m_count; i++)
+    {
+        positions[i] = Vector3{static_cast<int>(std::lround(m_posX[i])), static_cast<int>(std::lround(m_posY[i])),
+                               static_cast<int>(std::lround(m_posZ[i]))};
+    }
+    m_positions.set(std::move(positions));
+}
+
+float UeMobilityTask::randomSpeed()
+{
+    std::uniform_real_distribution<float> speed(static_cast<float>(m_config.minSpeed),
+                                                static_cast<float>(m_config.maxSpeed));
+    return speed(m_random);
+}
+
+} // namespace nr::ue
@@ -0,0 +1,97 @@
+//
+// This file is a part of UERANSIM project.
+// Copyright (c) 2023 ALİ GÜNGÖR.
+//
+// https://github.com/aligungr/UERANSIM/
+// See README, LICENSE, and CONTRIBUTING files for licensing details.
+//
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <ue/types.hpp>
+#include <utils/common_types.hpp>
+#include <utils/nts.hpp>
+#include <utils/snapshot.hpp>
+
+namespace nr::ue
+{
+
+/*
+ * Moves all the UEs of the process according to the mobility model, and publishes their positions to be reported in
+ * the RLS heartbeats. The motion state is kept in separate arrays, so that all the UEs are advanced in a single pass
+ * per update. The gNB search list entries with known positions are indexed by a grid of the cell range, so that a UE
+ * only searches for the cells around it.
+ */
+class UeMobilityTask : public NtsTask
+{
+  private:
+    struct TracePoint
+    {
+        int64_t time{};
+        float x{};
+        float y{};
+        float z{};
+    };
+
+  private:
+    MobilityConfig m_config;
+    size_t m_count;
+    std::mt19937 m_random;
+    int64_t m_startTime;
+    int64_t m_lastUpdate;
+
+    std::vector<float> m_posX;
+    std::vector<float> m_posY;
+    std::vector<float> m_posZ;
+    std::vector<float> m_velX;
+    std::vector<float> m_velY;
+    std::vector<float> m_targetX;
+    std::vector<float> m_targetY;
+    std::vector<int64_t> m_pauseUntil;
+    std::vector<std::vector<TracePoint>> m_traces;
+    int64_t m_traceDuration;
+
+    Snapshot<std::vector<Vector3>> m_positions;
+
+    /* Immutable after the construction */
+    std::unordered_map<int64_t, std::vector<int>> m_cellGrid;
+
+    // Set once a gNB has reported a position other than the configured one for the cell
+    std::vector<std::atomic<bool>> m_cellMismatch;
+
+  public:
+    UeMobilityTask(const MobilityConfig &config, size_t count);
+    ~UeMobilityTask() override = default;
+
+  protected:
+    void onStart() override;
+    void onLoop() override;
+    void onQuit() override;
+
+  public:
+    /* Thread-safe */
+    Vector3 positionOf(int slot);
+    int cellIndexOf(const std::string &address) const;
+    void findNearbyCells(const Vector3 &position, std::vector<int> &cells) const;
+    bool checkCellPosition(int cell, const Vector3 &position);
+
+  private:
+    void loadTraces();
+    void placeUes();
+    void update(int64_t time);
+    void updateRandomWaypoint(int64_t time);
+    void updateHighway();
+    void updateTrace(int64_t time);
+    void startMovingTowards(size_t ue, float x, float y);
+    void publishPositions();
+    float randomSpeed();
+};
+
+} // namespace nr::ue
@@ -134,7 +134,8 @@ std::unique_ptr<nas::SecuredMmMessage> Encrypt(NasSecurityContext &ctx, const na
     return Encrypt(ctx, std::move(stream), msgType, bypassCiphering, noCipheredHeader);
 }
 
-std::unique_ptr<nas::NasMessage> Decrypt(NasSecurityContext &ctx, const nas::SecuredMmMessage &msg)
+std::unique_ptr<nas::NasMessage> Decrypt(NasSecurityContext &ctx, const nas::SecuredMmMessage &msg,
+                                         EDecryptionRes &result)
 {
     auto estimatedCount = ctx.estimatedDownlinkCount(msg.sequenceNumber);
 
@@ -148,14 +149,27 @@ std::unique_ptr<nas::NasMessage> Decrypt(NasSecurityContext &ctx, const nas::Sec
 
     if (mac != (uint32_t)msg.messageAuthenticationCode)
     {
-        // MAC mismatch
+        result = EDecryptionRes::MAC_FAILURE;
         return nullptr;
     }
 
     ctx.updateDownlinkCount(estimatedCount);
     OctetString decryptedData = DecryptData(encAlg, estimatedCount, is3gppAccess, encKey, msg.sht, msg.plainNasMessage);
     OctetView buff{decryptedData};
-    return nas::DecodeNasMessage(buff);
+
+    // The message is authentic at this point, so a failure here is about the message content and not the MAC
+    std::unique_ptr<nas::NasMessage> decoded{};
+    try
+    {
+        decoded = nas::DecodeNasMessage(buff);
+    }
+    catch (const std::runtime_error &)
+    {
+        decoded = nullptr;
+    }
+
+    result = decoded != nullptr ? EDecryptionRes::OK : EDecryptionRes::DECODE_FAILURE;
+    return decoded;
 }
 
 uint32_t ComputeMac(nas::ETypeOfIntegrityProtectionAlgorithm alg, NasCount count, bool is3gppAccess, bool isUplink,
@@ -164,7 +178,10 @@ uint32_t ComputeMac(nas::ETypeOfIntegrityProtectionAlgorithm alg, NasCount count
     if (alg == nas::ETypeOfIntegrityProtectionAlgorithm::IA0)
         return 0;
 
-    auto data = OctetString::Concat(OctetString::FromOctet(count.sqn), plainMessage);
+    OctetString data;
+    data.reserve(plainMessage.length() + 1);
+    data.appendOctet(count.sqn);
+    data.append(plainMessage);
 
     int bearer = is3gppAccess ? 1 : 2;
     int direction = isUplink ? 0 : 1;
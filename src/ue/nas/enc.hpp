@@ -14,9 +14,17 @@
 namespace nr::ue::nas_enc
 {
 
+enum class EDecryptionRes
+{
+    OK,
+    MAC_FAILURE,
+    DECODE_FAILURE,
+};
+
 std::unique_ptr<nas::SecuredMmMessage> Encrypt(NasSecurityContext &ctx, const nas::PlainMmMessage &msg,
                                                bool bypassCiphering, bool noCipheredHeader);
-std::unique_ptr<nas::NasMessage> Decrypt(NasSecurityContext &ctx, const nas::SecuredMmMessage &msg);
+std::unique_ptr<nas::NasMessage> Decrypt(NasSecurityContext &ctx, const nas::SecuredMmMessage &msg,
+                                         EDecryptionRes &result);
 
 uint32_t ComputeMac(nas::ETypeOfIntegrityProtectionAlgorithm alg, NasCount count, bool is3gppAccess, bool isUplink,
                     const OctetString &key, const OctetString &plainMessage);
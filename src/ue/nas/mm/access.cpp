@@ -107,14 +107,14 @@ void NasMm::setN1Capability(bool enabled)
 bool NasMm::isInNonAllowedArea()
 {
     auto currentCell = m_base->shCtx.currentCell.get();
-    if (!currentCell.hasValue())
+    if (!currentCell->hasValue())
         return false;
 
-    auto plmn = currentCell.plmn;
+    auto plmn = currentCell->plmn;
     if (nas::utils::ServiceAreaListForbidsPlmn(m_storage->serviceAreaList->get(), nas::utils::PlmnFrom(plmn)))
         return true;
 
-    int tac = currentCell.tac;
+    int tac = currentCell->tac;
     if (nas::utils::ServiceAreaListForbidsTai(m_storage->serviceAreaList->get(),
                                               nas::VTrackingAreaIdentity{nas::utils::PlmnFrom(plmn), octet3{tac}}))
     {
@@ -123,6 +123,31 @@ bool NasMm::isInNonAllowedArea()
     return false;
 }
 
+static EUacResult EvaluateBarring(const UacBarringInfo &barring, const std::bitset<16> &identities)
+{
+    if (barring.isBarred)
+        return EUacResult::BARRED;
+
+    size_t barredCount = 0;
+
+    if (barring.aiBarringSet.ai1 && identities[1])
+        barredCount++;
+    if (barring.aiBarringSet.ai2 && identities[2])
+        barredCount++;
+    if (barring.aiBarringSet.ai11 && identities[11])
+        barredCount++;
+    if (barring.aiBarringSet.ai12 && identities[12])
+        barredCount++;
+    if (barring.aiBarringSet.ai13 && identities[13])
+        barredCount++;
+    if (barring.aiBarringSet.ai14 && identities[14])
+        barredCount++;
+    if (barring.aiBarringSet.ai15 && identities[15])
+        barredCount++;
+
+    return identities.count() == barredCount ? EUacResult::BARRED : EUacResult::ALLOWED;
+}
+
 EUacResult NasMm::performUac()
 {
     auto accessIdentities = [this]() {
@@ -260,26 +285,14 @@ EUacResult NasMm::performUac()
         return ASN_RRC_EstablishmentCause_mt_Access;
     }();
 
-    auto uacInput = std::make_unique<UacInput>();
-    uacInput->identities = accessIdentities;
-    uacInput->category = accessCategory;
-    uacInput->establishmentCause = static_cast<int>(establishmentCause);
-
-    auto uacCtl = LightSync<UacInput, UacOutput>::MakeShared(100, 0, std::move(uacInput));
-
-    auto w = std::make_unique<NmUeNasToRrc>(NmUeNasToRrc::PERFORM_UAC);
-    w->uacCtl = uacCtl;
+    // The establishment cause is delivered before any uplink NAS of this access attempt, hence RRC uses it for the
+    // connection setup if needed
+    auto w = std::make_unique<NmUeNasToRrc>(NmUeNasToRrc::ESTABLISHMENT_CAUSE);
+    w->establishmentCause = static_cast<int>(establishmentCause);
     m_base->rrcTask->push(std::move(w));
 
-    auto uacOutput = uacCtl->waitForProcess();
-
-    if (uacOutput == nullptr)
-    {
-        m_logger->err("No response from RRC from UAC checks, considering access attempt is barred");
-        return EUacResult::BARRED;
-    }
-
-    auto res = uacOutput->res;
+    // Barring information of the current cell is published by RRC, so the checks are performed here without waiting
+    auto res = EvaluateBarring(*m_base->shCtx.uacBarring.get(), accessIdentities);
 
     switch (res)
     {
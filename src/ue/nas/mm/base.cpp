@@ -93,22 +93,29 @@ void NasMm::onQuit()
 
 void NasMm::triggerMmCycle()
 {
+    // Coalesce the triggers, one pending cycle already evaluates the latest state
+    if (m_mmCyclePending)
+        return;
+    m_mmCyclePending = true;
+
     m_base->nasTask->push(std::make_unique<NmUeNasToNas>(NmUeNasToNas::PERFORM_MM_CYCLE));
 }
 
 void NasMm::performMmCycle()
 {
+    m_mmCyclePending = false;
+
     /* Do nothing in case of MM-NULL */
     if (m_mmState == EMmState::MM_NULL)
         return;
 
     auto currentCell = m_base->shCtx.currentCell.get();
-    Tai currentTai = Tai{currentCell.plmn, currentCell.tac};
+    Tai currentTai = Tai{currentCell->plmn, currentCell->tac};
 
     /* Perform substate selection in case of primary substate */
     if (m_mmSubState == EMmSubState::MM_DEREGISTERED_PS)
     {
-        if (currentCell.hasValue())
+        if (currentCell->hasValue())
         {
             if (!m_usim->isValid())
                 switchMmState(EMmSubState::MM_DEREGISTERED_NO_SUPI);
@@ -117,9 +124,9 @@ void NasMm::performMmCycle()
                 // TODO: check this later
                 switchMmState(EMmSubState::MM_REGISTERED_NON_ALLOWED_SERVICE);
             }
-            else if (currentCell.category == ECellCategory::SUITABLE_CELL)
+            else if (currentCell->category == ECellCategory::SUITABLE_CELL)
                 switchMmState(EMmSubState::MM_DEREGISTERED_NORMAL_SERVICE);
-            else if (currentCell.category == ECellCategory::ACCEPTABLE_CELL)
+            else if (currentCell->category == ECellCategory::ACCEPTABLE_CELL)
                 switchMmState(EMmSubState::MM_DEREGISTERED_LIMITED_SERVICE);
             else
                 switchMmState(EMmSubState::MM_DEREGISTERED_PLMN_SEARCH);
@@ -134,16 +141,16 @@ void NasMm::performMmCycle()
     if (m_mmSubState == EMmSubState::MM_REGISTERED_PS)
     {
         auto cell = m_base->shCtx.currentCell.get();
-        if (cell.hasValue())
+        if (cell->hasValue())
         {
             if (isInNonAllowedArea())
             {
                 // TODO: check this later
                 switchMmState(EMmSubState::MM_REGISTERED_NON_ALLOWED_SERVICE);
             }
-            else if (cell.category == ECellCategory::SUITABLE_CELL)
+            else if (cell->category == ECellCategory::SUITABLE_CELL)
                 switchMmState(EMmSubState::MM_REGISTERED_NORMAL_SERVICE);
-            else if (cell.category == ECellCategory::ACCEPTABLE_CELL)
+            else if (cell->category == ECellCategory::ACCEPTABLE_CELL)
                 switchMmState(EMmSubState::MM_REGISTERED_LIMITED_SERVICE);
             else
                 switchMmState(EMmSubState::MM_REGISTERED_PLMN_SEARCH);
@@ -234,7 +234,7 @@ void NasMm::receiveNasMessage(const nas::NasMessage &msg)
     {
         auto smcMsg = nas::DecodeNasMessage(OctetView{securedMm.plainNasMessage});
 
-        if (smcMsg->epd != nas::EExtendedProtocolDiscriminator::MOBILITY_MANAGEMENT_MESSAGES ||
+        if (smcMsg == nullptr || smcMsg->epd != nas::EExtendedProtocolDiscriminator::MOBILITY_MANAGEMENT_MESSAGES ||
             (((const nas::MmMessage &)(*smcMsg)).sht != nas::ESecurityHeaderType::NOT_PROTECTED) ||
             (((const nas::PlainMmMessage &)(*smcMsg)).messageType != nas::EMessageType::SECURITY_MODE_COMMAND))
         {
@@ -273,13 +273,20 @@ void NasMm::receiveNasMessage(const nas::NasMessage &msg)
         }
     }
 
-    auto decrypted = nas_enc::Decrypt(*m_usim->m_currentNsCtx, securedMm);
-    if (decrypted == nullptr)
+    nas_enc::EDecryptionRes decryptionRes{};
+    auto decrypted = nas_enc::Decrypt(*m_usim->m_currentNsCtx, securedMm, decryptionRes);
+    if (decryptionRes == nas_enc::EDecryptionRes::MAC_FAILURE)
     {
         m_logger->err("MAC mismatch in NAS encryption. Ignoring received NAS Message.");
         sendMmStatus(nas::EMmCause::MAC_FAILURE);
         return;
     }
+    if (decryptionRes == nas_enc::EDecryptionRes::DECODE_FAILURE)
+    {
+        m_logger->err("Malformed NAS message received in a valid security envelope. Ignoring received NAS Message.");
+        sendMmStatus(nas::EMmCause::INVALID_MANDATORY_INFORMATION);
+        return;
+    }
 
     auto &innerMsg = *decrypted;
     if (innerMsg.epd == nas::EExtendedProtocolDiscriminator::MOBILITY_MANAGEMENT_MESSAGES)
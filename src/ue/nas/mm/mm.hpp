@@ -38,6 +38,7 @@ class NasMm
 
     TaskBase *m_base;
     NasTimers *m_timers;
+    bool m_mmCyclePending{};
     std::unique_ptr<Logger> m_logger;
     NasSm *m_sm;
     Usim *m_usim;
@@ -115,7 +115,7 @@ void NasMm::serviceRequestRequiredForData()
 void NasMm::invokeProcedures()
 {
     auto activeCell = m_base->shCtx.currentCell.get();
-    bool hasActiveCell = activeCell.hasValue();
+    bool hasActiveCell = activeCell->hasValue();
 
     if (hasActiveCell && m_procCtl.deregistration)
     {
@@ -53,9 +53,9 @@ void NasMm::performPlmnSelection()
         logFailures = false;
     }
 
-    Plmn lastSelectedPlmn = m_base->shCtx.selectedPlmn.get();
+    Plmn lastSelectedPlmn = *m_base->shCtx.selectedPlmn.get();
 
-    std::unordered_set<Plmn> plmns = m_base->shCtx.availablePlmns.get();
+    std::unordered_set<Plmn> plmns = *m_base->shCtx.availablePlmns.get();
 
     if (!m_usim->isValid() || plmns.empty())
     {
@@ -124,12 +124,12 @@ void NasMm::handleActiveCellChange(const Tai &prevTai)
     }
 
     auto currentCell = m_base->shCtx.currentCell.get();
-    Tai currentTai = Tai{currentCell.plmn, currentCell.tac};
+    Tai currentTai = Tai{currentCell->plmn, currentCell->tac};
 
-    if (currentCell.hasValue() && !m_storage->equivalentPlmnList->contains(currentCell.plmn))
+    if (currentCell->hasValue() && !m_storage->equivalentPlmnList->contains(currentCell->plmn))
         m_timers->t3346.stop();
 
-    if (currentCell.hasValue() && prevTai != currentTai)
+    if (currentCell->hasValue() && prevTai != currentTai)
     {
         // "Additionally, the registration attempt counter shall be reset when the UE is in substate
         // 5GMM-DEREGISTERED.ATTEMPTING-REGISTRATION or 5GMM-REGISTERED.ATTEMPTING-REGISTRATION-UPDATE, and a new
@@ -145,7 +145,7 @@ void NasMm::handleActiveCellChange(const Tai &prevTai)
         // one of the forbidden PLMN lists and the tracking area is not in one of the lists of 5GS forbidden tracking
         // area"
         if (m_mmSubState == EMmSubState::MM_REGISTERED_ATTEMPTING_REGISTRATION_UPDATE && !m_timers->t3346.isRunning() &&
-            currentCell.category == ECellCategory::SUITABLE_CELL)
+            currentCell->category == ECellCategory::SUITABLE_CELL)
         {
             mobilityUpdatingRequired(ERegUpdateCause::TAI_CHANGE_IN_ATT_UPD);
         }
@@ -154,13 +154,13 @@ void NasMm::handleActiveCellChange(const Tai &prevTai)
         // timer T3346 is not running, the PLMN identity of the new cell is not in one of the forbidden PLMN lists and
         // the tracking area of the new cell is not in one of the lists of 5GS forbidden tracking areas"
         if (m_mmSubState == EMmSubState::MM_DEREGISTERED_ATTEMPTING_REGISTRATION && !m_timers->t3346.isRunning() &&
-            currentCell.category == ECellCategory::SUITABLE_CELL)
+            currentCell->category == ECellCategory::SUITABLE_CELL)
         {
             initialRegistrationRequired(EInitialRegCause::TAI_CHANGE_IN_ATT_REG);
         }
     }
 
-    if (currentCell.hasValue() && prevTai.plmn != currentTai.plmn)
+    if (currentCell->hasValue() && prevTai.plmn != currentTai.plmn)
     {
         // "Shall initiate a registration procedure for mobility and periodic registration update when entering a new
         // PLMN, if timer T3346 is running and the new PLMN is not equivalent to the PLMN where the UE started timer
@@ -168,7 +168,7 @@ void NasMm::handleActiveCellChange(const Tai &prevTai)
         // one of the lists of 5GS forbidden tracking areas"
         if (m_mmSubState == EMmSubState::MM_REGISTERED_ATTEMPTING_REGISTRATION_UPDATE && m_timers->t3346.isRunning() &&
             !m_storage->equivalentPlmnList->contains(currentTai.plmn) &&
-            currentCell.category == ECellCategory::SUITABLE_CELL)
+            currentCell->category == ECellCategory::SUITABLE_CELL)
         {
             mobilityUpdatingRequired(ERegUpdateCause::PLMN_CHANGE_IN_ATT_UPD);
         }
@@ -179,7 +179,7 @@ void NasMm::handleActiveCellChange(const Tai &prevTai)
         // areas"
         if (m_mmSubState == EMmSubState::MM_DEREGISTERED_ATTEMPTING_REGISTRATION && m_timers->t3346.isRunning() &&
             !m_storage->equivalentPlmnList->contains(currentTai.plmn) &&
-            currentCell.category == ECellCategory::SUITABLE_CELL)
+            currentCell->category == ECellCategory::SUITABLE_CELL)
         {
             initialRegistrationRequired(EInitialRegCause::PLMN_CHANGE_IN_ATT_REG);
         }
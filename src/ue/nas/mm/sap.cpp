@@ -60,6 +60,9 @@ void NasMm::handleRrcEvent(const NmUeRrcToNas &msg)
         break;
     }
     }
+
+    // Any lower layer event may change the outcome of the state evaluation
+    triggerMmCycle();
 }
 
 void NasMm::handleNasEvent(const NmUeNasToNas &msg)
@@ -74,6 +77,7 @@ void NasMm::handleNasEvent(const NmUeNasToNas &msg)
         break;
     case NmUeNasToNas::NAS_TIMER_EXPIRE:
         onTimerExpire(*msg.timer);
+        triggerMmCycle();
         break;
     default:
         break;
@@ -56,7 +56,7 @@ void NasMm::receiveDlNasTransport(const nas::DlNasTransport &msg)
     OctetView buff{msg.payloadContainer.data.data(), static_cast<size_t>(msg.payloadContainer.data.length())};
     auto nasMessage = nas::DecodeNasMessage(buff);
 
-    if (nasMessage->epd != nas::EExtendedProtocolDiscriminator::SESSION_MANAGEMENT_MESSAGES)
+    if (nasMessage == nullptr || nasMessage->epd != nas::EExtendedProtocolDiscriminator::SESSION_MANAGEMENT_MESSAGES)
     {
         m_logger->err("Bad payload container in DL NAS Transport, ignoring received message");
         return;
@@ -12,9 +12,20 @@
 
 #include <lib/nas/proto_conf.hpp>
 #include <ue/app/task.hpp>
+#include <ue/fast_path.hpp>
 #include <ue/nas/mm/mm.hpp>
 #include <ue/rls/task.hpp>
 
+static bool IsUserPlaneAllowed(nr::ue::EMmSubState state)
+{
+    using nr::ue::EMmSubState;
+
+    return state == EMmSubState::MM_REGISTERED_INITIATED_PS || state == EMmSubState::MM_REGISTERED_NORMAL_SERVICE ||
+           state == EMmSubState::MM_REGISTERED_NON_ALLOWED_SERVICE ||
+           state == EMmSubState::MM_REGISTERED_LIMITED_SERVICE || state == EMmSubState::MM_DEREGISTERED_INITIATED_PS ||
+           state == EMmSubState::MM_SERVICE_REQUEST_INITIATED_PS;
+}
+
 namespace nr::ue
 {
 
@@ -49,11 +60,7 @@ void NasSm::onTimerTick()
 
 void NasSm::handleUplinkDataRequest(int psi, OctetString &&data)
 {
-    auto state = m_mm->m_mmSubState;
-    if (state != EMmSubState::MM_REGISTERED_INITIATED_PS && state != EMmSubState::MM_REGISTERED_NORMAL_SERVICE &&
-        state != EMmSubState::MM_REGISTERED_NON_ALLOWED_SERVICE &&
-        state != EMmSubState::MM_REGISTERED_LIMITED_SERVICE && state != EMmSubState::MM_DEREGISTERED_INITIATED_PS &&
-        state != EMmSubState::MM_SERVICE_REQUEST_INITIATED_PS)
+    if (!IsUserPlaneAllowed(m_mm->m_mmSubState))
         return;
 
     if (m_pduSessions[psi]->psState != EPsState::ACTIVE)
@@ -90,11 +97,7 @@ void NasSm::handleDownlinkDataRequest(int psi, OctetString &&data)
     if (m_mm->m_cmState == ECmState::CM_IDLE)
         return;
 
-    auto state = m_mm->m_mmSubState;
-    if (state != EMmSubState::MM_REGISTERED_INITIATED_PS && state != EMmSubState::MM_REGISTERED_NORMAL_SERVICE &&
-        state != EMmSubState::MM_REGISTERED_NON_ALLOWED_SERVICE &&
-        state != EMmSubState::MM_REGISTERED_LIMITED_SERVICE && state != EMmSubState::MM_DEREGISTERED_INITIATED_PS &&
-        state != EMmSubState::MM_SERVICE_REQUEST_INITIATED_PS)
+    if (!IsUserPlaneAllowed(m_mm->m_mmSubState))
         return;
 
     auto w = std::make_unique<NmUeNasToApp>(NmUeNasToApp::DOWNLINK_DATA_DELIVERY);
@@ -104,4 +107,24 @@ void NasSm::handleDownlinkDataRequest(int psi, OctetString &&data)
     m_base->appTask->push(std::move(w));
 }
 
+void NasSm::updateFastPath()
+{
+    // Same conditions as the ones of the regular path above, the regular path is used whenever they do not hold
+    bool allowed = IsUserPlaneAllowed(m_mm->m_mmSubState);
+
+    for (int psi = PduSession::MIN_ID; psi <= PduSession::MAX_ID; psi++)
+    {
+        auto &ps = m_pduSessions[psi];
+        bool uplink = allowed && m_mm->m_cmState == ECmState::CM_CONNECTED && ps->psState == EPsState::ACTIVE &&
+                      !ps->uplinkPending;
+        bool downlink = allowed && m_mm->m_cmState != ECmState::CM_IDLE;
+        if (uplink == m_fastUplink[psi] && downlink == m_fastDownlink[psi])
+            continue;
+
+        m_fastUplink[psi] = uplink;
+        m_fastDownlink[psi] = downlink;
+        m_base->fastPath->setForwarding(psi, uplink, downlink);
+    }
+}
+
 } // namespace nr::ue
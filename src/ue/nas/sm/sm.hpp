@@ -31,6 +31,10 @@ class NasSm
     std::array<PduSession *, 16> m_pduSessions{};
     std::array<ProcedureTransaction, 255> m_procedureTransactions{};
 
+    // Forwarding flags last given to the fast path, so that it is locked only when they change
+    std::bitset<16> m_fastUplink{};
+    std::bitset<16> m_fastDownlink{};
+
     friend class UeCmdHandler;
     friend class NasMm;
     friend class NasTask;
@@ -94,6 +98,7 @@ class NasSm
     void onTimerTick();
     void handleUplinkDataRequest(int psi, OctetString &&data);
     void handleDownlinkDataRequest(int psi, OctetString &&data);
+    void updateFastPath();
 };
 
 } // namespace nr::ue
\ No newline at end of file
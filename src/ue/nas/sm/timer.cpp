@@ -12,6 +12,7 @@
 #include <lib/nas/utils.hpp>
 #include <ue/app/task.hpp>
 #include <ue/nas/mm/mm.hpp>
+#include <ue/nas/task.hpp>
 
 namespace nr::ue
 {
@@ -23,13 +24,13 @@ std::unique_ptr<UeTimer> NasSm::newTransactionTimer(int code)
     switch (code)
     {
     case 3580:
-        timer = std::make_unique<UeTimer>(3580, false, 16);
+        timer = std::make_unique<UeTimer>(3580, false, 16, m_base->nasTask);
         break;
     case 3581:
-        timer = std::make_unique<UeTimer>(3581, false, 16);
+        timer = std::make_unique<UeTimer>(3581, false, 16, m_base->nasTask);
         break;
     case 3582:
-        timer = std::make_unique<UeTimer>(3582, false, 16);
+        timer = std::make_unique<UeTimer>(3582, false, 16, m_base->nasTask);
         break;
     default:
         m_logger->err("Bad SM transaction timer code");
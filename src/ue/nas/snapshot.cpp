@@ -0,0 +1,351 @@
+//
+// This file is a part of UERANSIM project.
+// Copyright (c) 2023 ALİ GÜNGÖR.
+//
+// https://github.com/aligungr/UERANSIM/
+// See README, LICENSE, and CONTRIBUTING files for licensing details.
+//
+
+#include "task.hpp"
+
+#include <lib/nas/utils.hpp>
+#include <ue/app/task.hpp>
+#include <ue/snapshot.hpp>
+#include <utils/octet_view.hpp>
+
+static const int SNAPSHOT_VERSION = 2;
+
+namespace nr::ue
+{
+
+static void EncodeOctets(const OctetString &value, OctetString &stream)
+{
+    stream.appendOctet(value.length());
+    stream.append(value);
+}
+
+static OctetString DecodeOctets(const OctetView &stream)
+{
+    return stream.readOctetString(stream.readI());
+}
+
+static void EncodeString(const std::string &value, OctetString &stream)
+{
+    stream.appendOctet(static_cast<int>(value.size()));
+    stream.appendUtf8(value);
+}
+
+static std::string DecodeString(const OctetView &stream)
+{
+    return stream.readUtf8String(stream.readI());
+}
+
+static void EncodePlmn(const Plmn &plmn, OctetString &stream)
+{
+    stream.appendOctet2(plmn.mcc);
+    stream.appendOctet2(plmn.mnc);
+    stream.appendOctet(plmn.isLongMnc ? 1 : 0);
+}
+
+static Plmn DecodePlmn(const OctetView &stream)
+{
+    Plmn plmn;
+    plmn.mcc = stream.read2I();
+    plmn.mnc = stream.read2I();
+    plmn.isLongMnc = stream.read() != 0;
+    return plmn;
+}
+
+static void EncodeSlice(const SingleSlice &slice, OctetString &stream)
+{
+    stream.appendOctet(slice.sst);
+    stream.appendOctet(slice.sd.has_value() ? 1 : 0);
+    if (slice.sd.has_value())
+        stream.appendOctet3(*slice.sd);
+}
+
+static SingleSlice DecodeSlice(const OctetView &stream)
+{
+    SingleSlice slice;
+    slice.sst = stream.read();
+    if (stream.read() != 0)
+        slice.sd = stream.read3();
+    return slice;
+}
+
+static void EncodeSecurityContext(const NasSecurityContext &ctx, OctetString &stream)
+{
+    stream.appendOctet(static_cast<int>(ctx.tsc));
+    stream.appendOctet(ctx.ngKsi);
+    stream.appendOctet2(ctx.downlinkCount.overflow);
+    stream.appendOctet(ctx.downlinkCount.sqn);
+    stream.appendOctet2(ctx.uplinkCount.overflow);
+    stream.appendOctet(ctx.uplinkCount.sqn);
+    stream.appendOctet(static_cast<int>(ctx.integrity));
+    stream.appendOctet(static_cast<int>(ctx.ciphering));
+
+    EncodeOctets(ctx.keys.abba, stream);
+    EncodeOctets(ctx.keys.kAusf, stream);
+    EncodeOctets(ctx.keys.kSeaf, stream);
+    EncodeOctets(ctx.keys.kAmf, stream);
+    EncodeOctets(ctx.keys.kNasInt, stream);
+    EncodeOctets(ctx.keys.kNasEnc, stream);
+}
+
+static std::unique_ptr<NasSecurityContext> DecodeSecurityContext(const OctetView &stream)
+{
+    auto ctx = std::make_unique<NasSecurityContext>();
+    ctx->tsc = static_cast<nas::ETypeOfSecurityContext>(stream.readI());
+    ctx->ngKsi = stream.readI();
+    ctx->downlinkCount.overflow = stream.read2();
+    ctx->downlinkCount.sqn = stream.read();
+    ctx->uplinkCount.overflow = stream.read2();
+    ctx->uplinkCount.sqn = stream.read();
+    ctx->integrity = static_cast<nas::ETypeOfIntegrityProtectionAlgorithm>(stream.readI());
+    ctx->ciphering = static_cast<nas::ETypeOfCipheringAlgorithm>(stream.readI());
+
+    ctx->keys.abba = DecodeOctets(stream);
+    ctx->keys.kAusf = DecodeOctets(stream);
+    ctx->keys.kSeaf = DecodeOctets(stream);
+    ctx->keys.kAmf = DecodeOctets(stream);
+    ctx->keys.kNasInt = DecodeOctets(stream);
+    ctx->keys.kNasEnc = DecodeOctets(stream);
+    return ctx;
+}
+
+static void EncodeSession(const PduSession &ps, OctetString &stream)
+{
+    stream.appendOctet(ps.psi);
+    stream.appendOctet(static_cast<int>(ps.sessionType));
+    stream.appendOctet(ps.isEmergency ? 1 : 0);
+
+    stream.appendOctet(ps.apn.has_value() ? 1 : 0);
+    if (ps.apn.has_value())
+        EncodeString(*ps.apn, stream);
+
+    stream.appendOctet(ps.sNssai.has_value() ? 1 : 0);
+    if (ps.sNssai.has_value())
+        EncodeSlice(*ps.sNssai, stream);
+
+    stream.appendOctet(ps.authorizedQoSRules.has_value() ? 1 : 0);
+    if (ps.authorizedQoSRules.has_value())
+        nas::EncodeIe6(*ps.authorizedQoSRules, stream);
+
+    stream.appendOctet(ps.sessionAmbr.has_value() ? 1 : 0);
+    if (ps.sessionAmbr.has_value())
+        nas::EncodeIe4(*ps.sessionAmbr, stream);
+
+    stream.appendOctet(ps.authorizedQoSFlowDescriptions.has_value() ? 1 : 0);
+    if (ps.authorizedQoSFlowDescriptions.has_value())
+        nas::EncodeIe6(*ps.authorizedQoSFlowDescriptions, stream);
+
+    stream.appendOctet(ps.pduAddress.has_value() ? 1 : 0);
+    if (ps.pduAddress.has_value())
+        nas::EncodeIe4(*ps.pduAddress, stream);
+}
+
+static void DecodeSession(const OctetView &stream, PduSession &ps)
+{
+    ps.sessionType = static_cast<nas::EPduSessionType>(stream.readI());
+    ps.isEmergency = stream.read() != 0;
+
+    if (stream.read() != 0)
+        ps.apn = DecodeString(stream);
+    if (stream.read() != 0)
+        ps.sNssai = DecodeSlice(stream);
+    if (stream.read() != 0)
+        ps.authorizedQoSRules = nas::DecodeIe6<nas::IEQoSRules>(stream);
+    if (stream.read() != 0)
+        ps.sessionAmbr = nas::DecodeIe4<nas::IESessionAmbr>(stream);
+    if (stream.read() != 0)
+        ps.authorizedQoSFlowDescriptions = nas::DecodeIe6<nas::IEQoSFlowDescriptions>(stream);
+    if (stream.read() != 0)
+        ps.pduAddress = nas::DecodeIe4<nas::IEPduAddress>(stream);
+}
+
+static bool DecodeRegistration(const OctetView &stream, const std::string &nodeName, SnapshotRegistration &result)
+{
+    if (stream.readI() != SNAPSHOT_VERSION)
+        return false;
+    if (DecodeString(stream) != nodeName)
+        return false;
+
+    result.rmState = static_cast<ERmState>(stream.readI());
+    result.uState = static_cast<E5UState>(stream.readI());
+    result.guti = nas::DecodeIe6<nas::IE5gsMobileIdentity>(stream);
+    result.taiList = nas::DecodeIe4<nas::IE5gsTrackingAreaIdentityList>(stream);
+    result.lastTai.plmn = DecodePlmn(stream);
+    result.lastTai.tac = stream.read4I();
+    return !stream.hasError();
+}
+
+std::optional<SnapshotRegistration> DecodeSnapshotRegistration(const OctetString &record, const std::string &nodeName)
+{
+    SnapshotRegistration result{};
+    OctetView stream{record};
+    if (!DecodeRegistration(stream, nodeName, result))
+        return std::nullopt;
+    return result;
+}
+
+OctetString NasTask::encodeSnapshot()
+{
+    auto *storage = mm->m_storage;
+
+    OctetString stream;
+    stream.appendOctet(SNAPSHOT_VERSION);
+    EncodeString(base->config->getNodeName(), stream);
+
+    stream.appendOctet(static_cast<int>(mm->m_rmState));
+    stream.appendOctet(static_cast<int>(storage->uState->getPure()));
+    nas::EncodeIe6(storage->storedGuti->getPure(), stream);
+    nas::EncodeIe4(storage->taiList->getPure(), stream);
+
+    auto &lastTai = storage->lastVisitedRegisteredTai->getPure();
+    EncodePlmn(lastTai.plmn, stream);
+    stream.appendOctet4(lastTai.tac);
+
+    auto &allowedNssai = storage->allowedNssai->getPure();
+    stream.appendOctet(static_cast<int>(allowedNssai.slices.size()));
+    for (auto &slice : allowedNssai.slices)
+        EncodeSlice(slice, stream);
+
+    stream.appendOctet(usim->m_currentNsCtx ? 1 : 0);
+    if (usim->m_currentNsCtx)
+        EncodeSecurityContext(*usim->m_currentNsCtx, stream);
+
+    auto &sqnArr = usim->m_sqnMng->getSqnArray();
+    stream.appendOctet(static_cast<int>(sqnArr.size()));
+    for (uint64_t sqn : sqnArr)
+        stream.appendOctet8(sqn);
+
+    int activeSessions = 0;
+    for (int psi = PduSession::MIN_ID; psi <= PduSession::MAX_ID; psi++)
+        if (sm->m_pduSessions[psi]->psState == EPsState::ACTIVE)
+            activeSessions++;
+
+    stream.appendOctet(activeSessions);
+    for (int psi = PduSession::MIN_ID; psi <= PduSession::MAX_ID; psi++)
+        if (sm->m_pduSessions[psi]->psState == EPsState::ACTIVE)
+            EncodeSession(*sm->m_pduSessions[psi], stream);
+
+    stream.appendOctet4(timers.t3512.getInterval());
+    stream.appendOctet8(timers.t3512.getEndMillis());
+    return stream;
+}
+
+void NasTask::storeSnapshot()
+{
+    auto *file = base->config->snapshotFile;
+    if (file == nullptr)
+        return;
+
+    OctetString stream = encodeSnapshot();
+    if (!file->store(static_cast<size_t>(base->config->snapshotSlot), stream) && !snapshotTooLarge)
+    {
+        snapshotTooLarge = true;
+        logger->warn("UE state does not fit into the snapshot slot, state will not be preserved across restarts");
+    }
+}
+
+void NasTask::restoreSnapshot()
+{
+    // The state of a UE waking up from hibernation takes precedence over the snapshot file, it is the latest one
+    std::unique_ptr<UeHibernatedState> hibernated = std::move(base->hibernatedState);
+
+    std::optional<OctetString> record{};
+    if (hibernated != nullptr)
+        record = std::move(hibernated->record);
+    else if (base->config->snapshotFile != nullptr)
+        record = base->config->snapshotFile->load(static_cast<size_t>(base->config->snapshotSlot));
+
+    if (!record.has_value())
+        return;
+
+    OctetView stream{*record};
+    SnapshotRegistration registration{};
+    if (!DecodeRegistration(stream, base->config->getNodeName(), registration))
+        return;
+
+    auto rmState = registration.rmState;
+    auto uState = registration.uState;
+    auto &guti = registration.guti;
+    auto &taiList = registration.taiList;
+    auto &lastTai = registration.lastTai;
+
+    NetworkSlice allowedNssai;
+    int sliceCount = stream.readI();
+    for (int i = 0; i < sliceCount; i++)
+        allowedNssai.slices.push_back(DecodeSlice(stream));
+
+    std::unique_ptr<NasSecurityContext> nsCtx;
+    if (stream.read() != 0)
+        nsCtx = DecodeSecurityContext(stream);
+
+    std::vector<uint64_t> sqnArr(stream.readI());
+    for (auto &sqn : sqnArr)
+        sqn = stream.read8UL();
+
+    if (stream.hasError())
+        return;
+
+    // Only a registered UE with a valid GUTI and security context can be resumed, otherwise initial registration is
+    // performed as usual.
+    if (rmState != ERmState::RM_REGISTERED || uState != E5UState::U1_UPDATED ||
+        guti.type != nas::EIdentityType::GUTI || nsCtx == nullptr || !usim->isValid())
+        return;
+
+    if (!usim->m_sqnMng->restoreSqnArray(sqnArr))
+        return;
+
+    // The NAS security context is deleted upon leaving MM-DEREGISTERED, so switch the state before restoring it
+    mm->switchMmState(EMmSubState::MM_REGISTERED_PS);
+    mm->switchUState(uState);
+
+    mm->m_storage->storedGuti->set(guti);
+    mm->m_storage->taiList->set(taiList);
+    mm->m_storage->lastVisitedRegisteredTai->set(lastTai);
+    mm->m_storage->allowedNssai->set(allowedNssai);
+    usim->m_currentNsCtx = std::move(nsCtx);
+
+    int sessionCount = stream.readI();
+    for (int i = 0; i < sessionCount; i++)
+    {
+        int psi = stream.readI();
+        if (psi < PduSession::MIN_ID || psi > PduSession::MAX_ID)
+            break;
+
+        auto *ps = sm->m_pduSessions[psi];
+        DecodeSession(stream, *ps);
+        if (stream.hasError())
+            break;
+
+        ps->psState = EPsState::ACTIVE;
+
+        auto statusUpdate = std::make_unique<NmUeStatusUpdate>(NmUeStatusUpdate::SESSION_ESTABLISHMENT);
+        statusUpdate->pduSession = ps;
+        base->appTask->push(std::move(statusUpdate));
+    }
+
+    int t3512Interval = stream.read4I();
+    int64_t t3512End = static_cast<int64_t>(stream.read8UL());
+
+    if (hibernated != nullptr && hibernated->isIdle && !stream.hasError())
+    {
+        // The UE was in idle mode when hibernated, so it just camps on a cell again. The periodic registration is
+        // performed if T3512 expired meanwhile.
+        if (t3512End != 0)
+            timers.t3512.resume(t3512Interval, t3512End);
+
+        logger->debug("UE woke up from hibernation");
+        return;
+    }
+
+    logger->info("UE state restored from snapshot, resuming with the stored 5G-GUTI");
+
+    // The RRC connection is lost with the restart, so the registration is updated as in the connection recovery case.
+    // User plane of the restored sessions is then re-activated by the service request upon the first uplink data.
+    mm->mobilityUpdatingRequired(ERegUpdateCause::CONNECTION_RECOVERY);
+}
+
+} // namespace nr::ue
@@ -8,7 +8,8 @@
 
 #include "storage.hpp"
 
-static void BackupTaiListInSharedCtx(const std::vector<Tai> &buffer, size_t count, Locked<std::vector<Tai>> &target)
+static void BackupTaiListInSharedCtx(const std::vector<Tai> &buffer, size_t count,
+                                     Snapshot<std::vector<Tai>> &target)
 {
     target.mutate([count, &buffer](auto &value) {
         value.clear();
@@ -26,7 +27,13 @@ MmStorage::MmStorage(TaskBase *base) : m_base{base}
 
     storedSuci = std::make_unique<nas::NasSlot<nas::IE5gsMobileIdentity>>(0, std::nullopt);
 
-    storedGuti = std::make_unique<nas::NasSlot<nas::IE5gsMobileIdentity>>(0, std::nullopt);
+    storedGuti = std::make_unique<nas::NasSlot<nas::IE5gsMobileIdentity>>(
+        0, [this](const nas::IE5gsMobileIdentity &value) {
+            if (value.type == nas::EIdentityType::GUTI || value.type == nas::EIdentityType::TMSI)
+                m_base->shCtx.pagingTmsi.set(value.gutiOrTmsi);
+            else
+                m_base->shCtx.pagingTmsi.set({});
+        });
 
     lastVisitedRegisteredTai = std::make_unique<nas::NasSlot<Tai>>(0, std::nullopt);
 
@@ -76,4 +83,16 @@ MmStorage::MmStorage(TaskBase *base) : m_base{base}
     configuredNssai->set(m_base->config->configuredNssai);
 }
 
-} // namespace nr::ue
\ No newline at end of file
+size_t MmStorage::memoryUsage() const
+{
+    return sizeof(*this) + uState->memoryUsage() + storedSuci->memoryUsage() + storedGuti->memoryUsage() +
+           equivalentPlmnList->memoryUsage() + forbiddenPlmnList->memoryUsage() + taiList->memoryUsage() +
+           lastVisitedRegisteredTai->memoryUsage() + forbiddenTaiListRoaming->memoryUsage() +
+           forbiddenTaiListRps->memoryUsage() + serviceAreaList->memoryUsage() + defConfiguredNssai->memoryUsage() +
+           configuredNssai->memoryUsage() + allowedNssai->memoryUsage() + rejectedNssaiInPlmn->memoryUsage() +
+           rejectedNssaiInTa->memoryUsage() + networkFullName->memoryUsage() + networkShortName->memoryUsage() +
+           localTimeZone->memoryUsage() + universalTimeAndLocalTimeZone->memoryUsage() +
+           networkDaylightSavingTime->memoryUsage();
+}
+
+} // namespace nr::ue
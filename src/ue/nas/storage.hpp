@@ -48,6 +48,8 @@ class MmStorage
 
   public:
     explicit MmStorage(TaskBase *base);
+
+    [[nodiscard]] size_t memoryUsage() const;
 };
 
 } // namespace nr::ue
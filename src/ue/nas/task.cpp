@@ -8,16 +8,19 @@
 
 #include "task.hpp"
 #include <ue/nts.hpp>
+#include <utils/common.hpp>
 
-static const int NTS_TIMER_ID_NAS_TIMER_CYCLE = 1;
+// NAS timers (UeTimer) are armed with their timer code as the NTS timer ID, so these must not collide with them
 static const int NTS_TIMER_ID_MM_CYCLE = 2;
-static const int NTS_TIMER_INTERVAL_NAS_TIMER_CYCLE = 1000;
-static const int NTS_TIMER_INTERVAL_MM_CYCLE = 1100;
+static const int NTS_TIMER_ID_MM_RETRY = 3;
+static const int NTS_TIMER_ID_HIBERNATE = 4;
+static const int NTS_TIMER_INTERVAL_MM_RETRY = 1100;
 
 namespace nr::ue
 {
 
-NasTask::NasTask(TaskBase *base) : base{base}, timers{}
+NasTask::NasTask(TaskBase *base)
+    : base{base}, timers{this}, mmRetryArmed{}, snapshotTooLarge{}, idleSince{}, hibernationRequested{}
 {
     logger = base->logBase->makeUniqueLogger(base->config->getLoggerPrefix() + "nas");
 
@@ -33,12 +36,26 @@ void NasTask::onStart()
     sm->onStart(mm);
     mm->onStart(sm, usim);
 
-    setTimer(NTS_TIMER_ID_NAS_TIMER_CYCLE, NTS_TIMER_INTERVAL_NAS_TIMER_CYCLE);
-    setTimer(NTS_TIMER_ID_MM_CYCLE, NTS_TIMER_INTERVAL_MM_CYCLE);
+    restoreSnapshot();
+
+    if (base->config->safetyCycle.mm > 0)
+        setTimer(NTS_TIMER_ID_MM_CYCLE, base->config->safetyCycle.mm);
 }
 
 void NasTask::onQuit()
 {
+    // The other tasks of the UE are already stopped, so the state is final
+    if (base->isHibernating)
+    {
+        base->hibernatedState = std::make_unique<UeHibernatedState>();
+        base->hibernatedState->record = encodeSnapshot();
+        base->hibernatedState->wakeTime = timers.t3512.getEndMillis();
+        base->hibernatedState->t3512Interval = timers.t3512.getInterval();
+        base->hibernatedState->isIdle = canHibernate();
+        base->hibernatedState->mmSubState = mm->m_mmSubState;
+        base->hibernatedState->pagingTmsi = *base->shCtx.pagingTmsi.get();
+    }
+
     mm->onQuit();
     sm->onQuit();
 
@@ -66,6 +83,7 @@ void NasTask::onLoop()
         {
         case NmUeNasToNas::PERFORM_MM_CYCLE: {
             mm->handleNasEvent(w);
+            scheduleMmRetry();
             break;
         }
         case NmUeNasToNas::NAS_TIMER_EXPIRE: {
@@ -108,15 +126,25 @@ void NasTask::onLoop()
     case NtsMessageType::TIMER_EXPIRED: {
         auto &w = dynamic_cast<NmTimerExpired &>(*msg);
         int timerId = w.timerId;
-        if (timerId == NTS_TIMER_ID_NAS_TIMER_CYCLE)
+        if (timerId == NTS_TIMER_ID_MM_CYCLE)
         {
-            setTimer(NTS_TIMER_ID_NAS_TIMER_CYCLE, NTS_TIMER_INTERVAL_NAS_TIMER_CYCLE);
-            performTick();
+            setTimer(NTS_TIMER_ID_MM_CYCLE, base->config->safetyCycle.mm);
+            mm->handleNasEvent(NmUeNasToNas{NmUeNasToNas::PERFORM_MM_CYCLE});
+            scheduleMmRetry();
         }
-        if (timerId == NTS_TIMER_ID_MM_CYCLE)
+        else if (timerId == NTS_TIMER_ID_MM_RETRY)
         {
-            setTimer(NTS_TIMER_ID_MM_CYCLE, NTS_TIMER_INTERVAL_MM_CYCLE);
+            mmRetryArmed = false;
             mm->handleNasEvent(NmUeNasToNas{NmUeNasToNas::PERFORM_MM_CYCLE});
+            scheduleMmRetry();
+        }
+        else if (timerId == NTS_TIMER_ID_HIBERNATE)
+        {
+            onHibernationTimer();
+        }
+        else
+        {
+            onNasTimerExpire(timerId);
         }
         break;
     }
@@ -124,52 +152,170 @@ void NasTask::onLoop()
         logger->unhandledNts(*msg);
         break;
     }
+
+    // Forwarding entries of the user plane follow the state changes, downlink data is the only message that changes
+    // neither MM nor PDU session state. Uplink data may make the uplink pending.
+    if (msg->msgType != NtsMessageType::UE_RLS_TO_NAS)
+        sm->updateFastPath();
+
+    // User plane data does not change the NAS state, everything else may
+    if (msg->msgType != NtsMessageType::UE_APP_TO_NAS && msg->msgType != NtsMessageType::UE_RLS_TO_NAS)
+    {
+        storeSnapshot();
+        scheduleHibernation();
+    }
+}
+
+void NasTask::scheduleMmRetry()
+{
+    // A procedure may stay pending on a condition that produces no event (e.g. UAC barring), so the MM cycle is
+    // re-evaluated periodically only while there is something pending.
+    if (mmRetryArmed || !mm->hasPendingProcedure())
+        return;
+
+    mmRetryArmed = true;
+    setTimer(NTS_TIMER_ID_MM_RETRY, NTS_TIMER_INTERVAL_MM_RETRY);
+}
+
+bool NasTask::canHibernate()
+{
+    // Only a registered UE in idle mode with nothing going on but the periodic registration timer is hibernated
+    if (mm->m_rmState != ERmState::RM_REGISTERED || mm->m_cmState != ECmState::CM_IDLE ||
+        mm->m_mmSubState != EMmSubState::MM_REGISTERED_NORMAL_SERVICE ||
+        mm->m_storage->uState->getPure() != E5UState::U1_UPDATED || mm->hasPendingProcedure())
+        return false;
+
+    for (auto *timer : {&timers.t3346, &timers.t3396, &timers.t3444, &timers.t3445, &timers.t3502, &timers.t3510,
+                        &timers.t3511, &timers.t3516, &timers.t3517, &timers.t3519, &timers.t3520, &timers.t3521,
+                        &timers.t3525, &timers.t3540, &timers.t3584, &timers.t3585})
+        if (timer->isRunning())
+            return false;
+
+    for (int psi = PduSession::MIN_ID; psi <= PduSession::MAX_ID; psi++)
+        if (sm->m_pduSessions[psi]->psState != EPsState::INACTIVE)
+            return false;
+
+    for (auto &pt : sm->m_procedureTransactions)
+        if (pt.state != EPtState::INACTIVE)
+            return false;
+
+    return true;
+}
+
+void NasTask::scheduleHibernation()
+{
+    if (base->config->hibernateDelay <= 0 || hibernationRequested)
+        return;
+
+    if (!canHibernate())
+    {
+        idleSince = 0;
+        return;
+    }
+
+    if (idleSince == 0)
+    {
+        idleSince = utils::CurrentTimeMillis();
+        setTimer(NTS_TIMER_ID_HIBERNATE, base->config->hibernateDelay);
+    }
+}
+
+void NasTask::onHibernationTimer()
+{
+    // The timer may belong to an earlier idle period, so the current one is checked against the delay
+    if (idleSince == 0 || hibernationRequested || !canHibernate())
+        return;
+
+    int64_t remaining = idleSince + base->config->hibernateDelay - utils::CurrentTimeMillis();
+    if (remaining > 0)
+    {
+        setTimer(NTS_TIMER_ID_HIBERNATE, remaining);
+        return;
+    }
+
+    hibernationRequested = true;
+    logger->debug("UE is idle, hibernating");
+    base->ueController->performHibernation(base->ue);
 }
 
-void NasTask::performTick()
+void NasTask::onNasTimerExpire(int timerId)
 {
-    auto sendExpireMsg = [this](UeTimer *timer) {
-        auto m = std::make_unique<NmUeNasToNas>(NmUeNasToNas::NAS_TIMER_EXPIRE);
-        m->timer = timer;
-        push(std::move(m));
-    };
-
-    if (timers.t3346.performTick())
-        sendExpireMsg(&timers.t3346);
-    if (timers.t3396.performTick())
-        sendExpireMsg(&timers.t3396);
-    if (timers.t3444.performTick())
-        sendExpireMsg(&timers.t3444);
-    if (timers.t3445.performTick())
-        sendExpireMsg(&timers.t3445);
-    if (timers.t3502.performTick())
-        sendExpireMsg(&timers.t3502);
-    if (timers.t3510.performTick())
-        sendExpireMsg(&timers.t3510);
-    if (timers.t3511.performTick())
-        sendExpireMsg(&timers.t3511);
-    if (timers.t3512.performTick())
-        sendExpireMsg(&timers.t3512);
-    if (timers.t3516.performTick())
-        sendExpireMsg(&timers.t3516);
-    if (timers.t3517.performTick())
-        sendExpireMsg(&timers.t3517);
-    if (timers.t3519.performTick())
-        sendExpireMsg(&timers.t3519);
-    if (timers.t3520.performTick())
-        sendExpireMsg(&timers.t3520);
-    if (timers.t3521.performTick())
-        sendExpireMsg(&timers.t3521);
-    if (timers.t3525.performTick())
-        sendExpireMsg(&timers.t3525);
-    if (timers.t3540.performTick())
-        sendExpireMsg(&timers.t3540);
-    if (timers.t3584.performTick())
-        sendExpireMsg(&timers.t3584);
-    if (timers.t3585.performTick())
-        sendExpireMsg(&timers.t3585);
-
-    sm->onTimerTick();
+    UeTimer *timer = nullptr;
+
+    switch (timerId)
+    {
+    case 3346:
+        timer = &timers.t3346;
+        break;
+    case 3396:
+        timer = &timers.t3396;
+        break;
+    case 3444:
+        timer = &timers.t3444;
+        break;
+    case 3445:
+        timer = &timers.t3445;
+        break;
+    case 3502:
+        timer = &timers.t3502;
+        break;
+    case 3510:
+        timer = &timers.t3510;
+        break;
+    case 3511:
+        timer = &timers.t3511;
+        break;
+    case 3512:
+        timer = &timers.t3512;
+        break;
+    case 3516:
+        timer = &timers.t3516;
+        break;
+    case 3517:
+        timer = &timers.t3517;
+        break;
+    case 3519:
+        timer = &timers.t3519;
+        break;
+    case 3520:
+        timer = &timers.t3520;
+        break;
+    case 3521:
+        timer = &timers.t3521;
+        break;
+    case 3525:
+        timer = &timers.t3525;
+        break;
+    case 3540:
+        timer = &timers.t3540;
+        break;
+    case 3584:
+        timer = &timers.t3584;
+        break;
+    case 3585:
+        timer = &timers.t3585;
+        break;
+    case 3580:
+    case 3581:
+    case 3582:
+        // SM transaction timers are per PTI, they share the same NTS timer ID
+        sm->onTimerTick();
+        return;
+    default:
+        return;
+    }
+
+    // The NTS timer may belong to a previous run of a stopped or restarted timer
+    if (!timer->performTick())
+        return;
+
+    NmUeNasToNas msg{NmUeNasToNas::NAS_TIMER_EXPIRE};
+    msg.timer = timer;
+
+    if (timer->isMmTimer())
+        mm->handleNasEvent(msg);
+    else
+        sm->handleNasEvent(msg);
 }
 
 } // namespace nr::ue
\ No newline at end of file
@@ -30,6 +30,10 @@ class NasTask : public NtsTask
     NasMm *mm;
     NasSm *sm;
     Usim *usim;
+    bool mmRetryArmed;
+    bool snapshotTooLarge;
+    int64_t idleSince;
+    bool hibernationRequested;
 
     friend class UeCmdHandler;
 
@@ -43,7 +47,30 @@ class NasTask : public NtsTask
     void onQuit() override;
 
   private:
-    void performTick();
+    void scheduleMmRetry();
+    void onNasTimerExpire(int timerId);
+
+  private: /* Snapshot */
+    OctetString encodeSnapshot();
+    void storeSnapshot();
+    void restoreSnapshot();
+
+  private: /* Hibernation */
+    bool canHibernate();
+    void scheduleHibernation();
+    void onHibernationTimer();
+};
+
+/* Registration part of a NAS snapshot record, reported by the CLI for a hibernated UE without restoring it */
+struct SnapshotRegistration
+{
+    ERmState rmState{};
+    E5UState uState{};
+    nas::IE5gsMobileIdentity guti{};
+    nas::IE5gsTrackingAreaIdentityList taiList{};
+    Tai lastTai{};
 };
 
+std::optional<SnapshotRegistration> DecodeSnapshotRegistration(const OctetString &record, const std::string &nodeName);
+
 } // namespace nr::ue
\ No newline at end of file
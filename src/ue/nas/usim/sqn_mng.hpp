@@ -38,6 +38,9 @@ class SqnManager
   public:
     [[nodiscard]] OctetString getSqn() const;
     bool checkSqn(const OctetString &sqn);
+
+    [[nodiscard]] const std::vector<uint64_t> &getSqnArray() const;
+    bool restoreSqnArray(const std::vector<uint64_t> &sqnArr);
 };
 
 } // namespace nr::ue
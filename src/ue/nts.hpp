@@ -16,7 +16,6 @@
 #include <lib/app/cli_base.hpp>
 #include <lib/rls/rls_base.hpp>
 #include <lib/rrc/rrc.hpp>
-#include <utils/light_sync.hpp>
 #include <utils/network.hpp>
 #include <utils/nts.hpp>
 #include <utils/octet_string.hpp>
@@ -96,7 +95,7 @@ struct NmUeNasToRrc : NtsMessage
         LOCAL_RELEASE_CONNECTION,
         UPLINK_NAS_DELIVERY,
         RRC_NOTIFY,
-        PERFORM_UAC,
+        ESTABLISHMENT_CAUSE,
     } present;
 
     // UPLINK_NAS_DELIVERY
@@ -106,8 +105,8 @@ struct NmUeNasToRrc : NtsMessage
     // LOCAL_RELEASE_CONNECTION
     bool treatBarred{};
 
-    // PERFORM_UAC
-    std::shared_ptr<LightSync<UacInput, UacOutput>> uacCtl{};
+    // ESTABLISHMENT_CAUSE
+    int establishmentCause{};
 
     explicit NmUeNasToRrc(PR present) : NtsMessage(NtsMessageType::UE_NAS_TO_RRC), present(present)
     {
@@ -164,6 +163,7 @@ struct NmUeRlsToRrc : NtsMessage
     // DOWNLINK_RRC_DELIVERY
     rrc::RrcChannel channel{};
     OctetString pdu;
+    uint32_t pagingTag{};
 
     // SIGNAL_CHANGED
     int dbm{};
@@ -302,6 +302,9 @@ struct NmUeRlsToRls : NtsMessage
     // UPLINK_RRC
     uint32_t pduId{};
 
+    // DOWNLINK_RRC
+    uint32_t pagingTag{};
+
     // RADIO_LINK_FAILURE
     rls::ERlfCause rlfCause{};
 
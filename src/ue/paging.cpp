@@ -0,0 +1,96 @@
+//
+// This file is a part of UERANSIM project.
+// Copyright (c) 2023 ALİ GÜNGÖR.
+//
+// https://github.com/aligungr/UERANSIM/
+// See README, LICENSE, and CONTRIBUTING files for licensing details.
+//
+
+#include "paging.hpp"
+
+#include <lib/asn/utils.hpp>
+#include <lib/rrc/encode.hpp>
+#include <lib/rrc/rrc.hpp>
+#include <ue/rrc/task.hpp>
+#include <utils/common.hpp>
+#include <utils/random.hpp>
+
+#include <asn/rrc/ASN_RRC_PCCH-Message.h>
+
+static constexpr const int BUFFER_SIZE = 16384;
+static constexpr const int HEARTBEAT_PERIOD = 1000;
+static constexpr const int RECEIVE_TIMEOUT = 200;
+
+namespace nr::ue
+{
+
+UePagingListener::UePagingListener(std::vector<std::pair<InetAddress, Vector3>> cells,
+                                   app::IUeController *ueController)
+    : m_cells{std::move(cells)}, m_ueController{ueController}, m_server{}, m_sti{}, m_lastHeartbeat{}
+{
+    m_sti = Random::Mixed(std::string{"paging-listener"}).nextL();
+}
+
+void UePagingListener::onStart()
+{
+    m_server = new udp::UdpServer();
+}
+
+void UePagingListener::onLoop()
+{
+    auto current = utils::CurrentTimeMillis();
+    if (current - m_lastHeartbeat > HEARTBEAT_PERIOD)
+    {
+        m_lastHeartbeat = current;
+        for (auto &cell : m_cells)
+        {
+            rls::RlsHeartBeat msg{m_sti};
+            msg.simPos = cell.second;
+
+            OctetString stream;
+            rls::EncodeRlsMessage(msg, 0, stream);
+            m_server->Send(cell.first, stream.data(), static_cast<size_t>(stream.length()));
+        }
+    }
+
+    uint8_t buffer[BUFFER_SIZE];
+    InetAddress peerAddress;
+
+    int size = m_server->Receive(buffer, BUFFER_SIZE, RECEIVE_TIMEOUT, peerAddress);
+    if (size > 0)
+    {
+        auto rlsMsg = rls::DecodeRlsMessage(OctetView{buffer, static_cast<size_t>(size)});
+        if (rlsMsg != nullptr)
+            receiveRlsPdu(*rlsMsg);
+    }
+}
+
+void UePagingListener::onQuit()
+{
+    delete m_server;
+}
+
+void UePagingListener::receiveRlsPdu(const rls::RlsMessage &msg)
+{
+    if (msg.msgType != rls::EMessageType::PDU_TRANSMISSION)
+        return;
+
+    auto &m = (const rls::RlsPduTransmission &)msg;
+    if (m.pduType != rls::EPduType::RRC || static_cast<rrc::RrcChannel>(m.payload & 0xFF) != rrc::RrcChannel::PCCH)
+        return;
+
+    auto *pdu = rrc::encode::Decode<ASN_RRC_PCCH_Message>(asn_DEF_ASN_RRC_PCCH_Message, m.pdu);
+    if (pdu == nullptr)
+        return;
+
+    std::vector<GutiMobileIdentity> tmsiIds{};
+    if (pdu->message.present == ASN_RRC_PCCH_MessageType_PR_c1 &&
+        pdu->message.choice.c1->present == ASN_RRC_PCCH_MessageType__c1_PR_paging)
+        tmsiIds = PagingTmsiList(*pdu->message.choice.c1->choice.paging);
+    asn::Free(asn_DEF_ASN_RRC_PCCH_Message, pdu);
+
+    if (!tmsiIds.empty())
+        m_ueController->performPaging(std::move(tmsiIds));
+}
+
+} // namespace nr::ue
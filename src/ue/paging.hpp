@@ -0,0 +1,54 @@
+//
+// This file is a part of UERANSIM project.
+// Copyright (c) 2023 ALİ GÜNGÖR.
+//
+// https://github.com/aligungr/UERANSIM/
+// See README, LICENSE, and CONTRIBUTING files for licensing details.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <lib/app/ue_ctl.hpp>
+#include <lib/rls/rls_pdu.hpp>
+#include <lib/udp/server.hpp>
+#include <utils/common_types.hpp>
+#include <utils/network.hpp>
+#include <utils/nts.hpp>
+
+namespace nr::ue
+{
+
+/*
+ * Radio presence of the hibernated UEs of the process. It keeps a single radio link to each gNB of the search list, and
+ * reports the 5G-S-TMSIs in the received pagings to the controller, which wakes up the paged UEs. The paging occasions
+ * are not checked, since the pagings of all the hibernated UEs are received through the same link.
+ */
+class UePagingListener : public NtsTask
+{
+  private:
+    std::vector<std::pair<InetAddress, Vector3>> m_cells;
+    app::IUeController *m_ueController;
+    udp::UdpServer *m_server;
+    uint64_t m_sti;
+    int64_t m_lastHeartbeat;
+
+  public:
+    /* The position of each gNB is used as the simulated position, so that the gNB accepts the link */
+    UePagingListener(std::vector<std::pair<InetAddress, Vector3>> cells, app::IUeController *ueController);
+    ~UePagingListener() override = default;
+
+  protected:
+    void onStart() override;
+    void onLoop() override;
+    void onQuit() override;
+
+  private:
+    void receiveRlsPdu(const rls::RlsMessage &msg);
+};
+
+} // namespace nr::ue
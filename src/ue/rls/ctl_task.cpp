@@ -8,22 +8,23 @@
 
 #include "ctl_task.hpp"
 
+#include <ue/fast_path.hpp>
 #include <utils/common.hpp>
 
-static constexpr const size_t MAX_PDU_COUNT = 128;
 static constexpr const int MAX_PDU_TTL = 3000;
+static constexpr const int RETRANSMISSION_INTERVAL = 500;
 
-static constexpr const int TIMER_ID_ACK_CONTROL = 1;
+static constexpr const int TIMER_ID_RETRANSMISSION = 1;
 static constexpr const int TIMER_ID_ACK_SEND = 2;
 
-static constexpr const int TIMER_PERIOD_ACK_CONTROL = 1500;
-static constexpr const int TIMER_PERIOD_ACK_SEND = 2250;
+static constexpr const int TIMER_PERIOD_ACK_SEND = 40;
 
 namespace nr::ue
 {
 
 RlsControlTask::RlsControlTask(TaskBase *base, RlsSharedContext *shCtx)
-    : m_shCtx{shCtx}, m_servingCell{}, m_mainTask{}, m_udpTask{}, m_pduMap{}, m_pendingAck{}
+    : m_shCtx{shCtx}, m_fastPath{base->fastPath}, m_servingCell{}, m_mainTask{}, m_udpTask{},
+      m_sendWindows{}, m_receiveWindows{}, m_wheel{}, m_pendingAck{}, m_retransmissionTimerSet{}, m_ackTimerSet{}
 {
     m_logger = base->logBase->makeUniqueLogger(base->config->getLoggerPrefix() + "rls-ctl");
 }
@@ -36,8 +37,6 @@ void RlsControlTask::initialize(NtsTask *mainTask, RlsUdpTask *udpTask)
 
 void RlsControlTask::onStart()
 {
-    setTimer(TIMER_ID_ACK_CONTROL, TIMER_PERIOD_ACK_CONTROL);
-    setTimer(TIMER_ID_ACK_SEND, TIMER_PERIOD_ACK_SEND);
 }
 
 void RlsControlTask::onLoop()
@@ -66,6 +65,7 @@ void RlsControlTask::onLoop()
             break;
         case NmUeRlsToRls::ASSIGN_CURRENT_CELL:
             m_servingCell = w.cellId;
+            m_fastPath->setServingCell(w.cellId);
             break;
         default:
             m_logger->unhandledNts(*msg);
@@ -75,14 +75,14 @@ void RlsControlTask::onLoop()
     }
     case NtsMessageType::TIMER_EXPIRED: {
         auto &w = dynamic_cast<NmTimerExpired &>(*msg);
-        if (w.timerId == TIMER_ID_ACK_CONTROL)
+        if (w.timerId == TIMER_ID_RETRANSMISSION)
         {
-            setTimer(TIMER_ID_ACK_CONTROL, TIMER_PERIOD_ACK_CONTROL);
-            onAckControlTimerExpired();
+            m_retransmissionTimerSet = false;
+            onRetransmissionTimerExpired();
         }
         else if (w.timerId == TIMER_ID_ACK_SEND)
         {
-            setTimer(TIMER_ID_ACK_SEND, TIMER_PERIOD_ACK_SEND);
+            m_ackTimerSet = false;
             onAckSendTimerExpired();
         }
         break;
@@ -102,14 +102,25 @@ void RlsControlTask::handleRlsMessage(int cellId, rls::RlsMessage &msg)
     if (msg.msgType == rls::EMessageType::PDU_TRANSMISSION_ACK)
     {
         auto &m = (rls::RlsPduTransmissionAck &)msg;
-        for (auto pduId : m.pduIds)
-            m_pduMap.erase(pduId);
+        auto it = m_sendWindows.find(cellId);
+        if (it != m_sendWindows.end() && it->second.epoch() == m.epoch)
+            it->second.acknowledge(m.cumulative, m.bitmap);
     }
     else if (msg.msgType == rls::EMessageType::PDU_TRANSMISSION)
     {
         auto &m = (rls::RlsPduTransmission &)msg;
         if (m.pduId != 0)
-            m_pendingAck[cellId].push_back(m.pduId);
+        {
+            bool isNew = m_receiveWindows[cellId].receive(m.epoch, m.pduId);
+
+            // Duplicates are acknowledged again too, since the previous acknowledgement may be lost
+            m_pendingAck.insert(cellId);
+            if (!m_ackTimerSet)
+                m_ackTimerSet = setTimer(TIMER_ID_ACK_SEND, TIMER_PERIOD_ACK_SEND);
+
+            if (!isNew)
+                return;
+        }
 
         if (m.pduType == rls::EPduType::DATA)
         {
@@ -120,6 +131,9 @@ void RlsControlTask::handleRlsMessage(int cellId, rls::RlsMessage &msg)
                 return;
             }
 
+            if (m_fastPath->deliverDownlink(static_cast<int>(m.payload), m.pdu))
+                return;
+
             auto w = std::make_unique<NmUeRlsToRls>(NmUeRlsToRls::DOWNLINK_DATA);
             w->psi = static_cast<int>(m.payload);
             w->data = std::move(m.pdu);
@@ -129,7 +143,8 @@ void RlsControlTask::handleRlsMessage(int cellId, rls::RlsMessage &msg)
         {
             auto w = std::make_unique<NmUeRlsToRls>(NmUeRlsToRls::DOWNLINK_RRC);
             w->cellId = cellId;
-            w->rrcChannel = static_cast<rrc::RrcChannel>(m.payload);
+            w->rrcChannel = static_cast<rrc::RrcChannel>(m.payload & 0xFF);
+            w->pagingTag = m.payload >> 8;
             w->data = std::move(m.pdu);
             m_mainTask->push(std::move(w));
         }
@@ -146,6 +161,18 @@ void RlsControlTask::handleRlsMessage(int cellId, rls::RlsMessage &msg)
 
 void RlsControlTask::handleSignalChange(int cellId, int dbm)
 {
+    if (dbm == INT32_MIN)
+    {
+        auto it = m_sendWindows.find(cellId);
+        if (it != m_sendWindows.end())
+        {
+            declareTransmissionFailure(it->second.clear());
+            m_sendWindows.erase(it);
+        }
+        m_receiveWindows.erase(cellId);
+        m_pendingAck.erase(cellId);
+    }
+
     auto w = std::make_unique<NmUeRlsToRls>(NmUeRlsToRls::SIGNAL_CHANGED);
     w->cellId = cellId;
     w->dbm = dbm;
@@ -154,21 +181,14 @@ void RlsControlTask::handleSignalChange(int cellId, int dbm)
 
 void RlsControlTask::handleUplinkRrcDelivery(int cellId, uint32_t pduId, rrc::RrcChannel channel, OctetString &&data)
 {
+    uint32_t seq = 0;
+    uint32_t epoch = 0;
     if (pduId != 0)
     {
-        if (m_pduMap.count(pduId))
+        auto &window = m_sendWindows[cellId];
+        if (window.isFull())
         {
-            m_pduMap.clear();
-
-            auto w = std::make_unique<NmUeRlsToRls>(NmUeRlsToRls::RADIO_LINK_FAILURE);
-            w->rlfCause = rls::ERlfCause::PDU_ID_EXISTS;
-            m_mainTask->push(std::move(w));
-            return;
-        }
-
-        if (m_pduMap.size() > MAX_PDU_COUNT)
-        {
-            m_pduMap.clear();
+            declareTransmissionFailure(window.clear());
 
             auto w = std::make_unique<NmUeRlsToRls>(NmUeRlsToRls::RADIO_LINK_FAILURE);
             w->rlfCause = rls::ERlfCause::PDU_ID_FULL;
@@ -176,18 +196,25 @@ void RlsControlTask::handleUplinkRrcDelivery(int cellId, uint32_t pduId, rrc::Rr
             return;
         }
 
-        m_pduMap[pduId].endPointId = cellId;
-        m_pduMap[pduId].id = pduId;
-        m_pduMap[pduId].pdu = data.copy();
-        m_pduMap[pduId].rrcChannel = channel;
-        m_pduMap[pduId].sentTime = utils::CurrentTimeMillis();
+        rls::PduInfo info;
+        info.endPointId = cellId;
+        info.id = pduId;
+        info.pdu = data.copy();
+        info.rrcChannel = channel;
+        info.sentTime = utils::CurrentTimeMillis();
+
+        int64_t deadline = info.sentTime + RETRANSMISSION_INTERVAL;
+        seq = window.push(std::move(info), deadline);
+        epoch = window.epoch();
+        scheduleRetransmission(deadline, cellId, seq);
     }
 
     rls::RlsPduTransmission msg{m_shCtx->sti};
     msg.pduType = rls::EPduType::RRC;
     msg.pdu = std::move(data);
     msg.payload = static_cast<uint32_t>(channel);
-    msg.pduId = pduId;
+    msg.pduId = seq;
+    msg.epoch = epoch;
 
     m_udpTask->send(cellId, msg);
 }
@@ -203,49 +230,91 @@ void RlsControlTask::handleUplinkDataDelivery(int psi, OctetString &&data)
     m_udpTask->send(m_servingCell, msg);
 }
 
-void RlsControlTask::onAckControlTimerExpired()
+void RlsControlTask::scheduleRetransmission(int64_t deadline, int cellId, uint32_t seq)
+{
+    m_wheel.schedule(deadline, cellId, seq);
+    if (!m_retransmissionTimerSet)
+        m_retransmissionTimerSet = setTimer(TIMER_ID_RETRANSMISSION, rls::RetransmissionWheel::TICK);
+}
+
+void RlsControlTask::declareTransmissionFailure(std::vector<rls::PduInfo> &&pduList)
+{
+    if (pduList.empty())
+        return;
+
+    auto w = std::make_unique<NmUeRlsToRls>(NmUeRlsToRls::TRANSMISSION_FAILURE);
+    w->pduList = std::move(pduList);
+    m_mainTask->push(std::move(w));
+}
+
+void RlsControlTask::onRetransmissionTimerExpired()
 {
     int64_t current = utils::CurrentTimeMillis();
 
-    std::vector<uint32_t> transmissionFailureIds;
+    std::vector<rls::RetransmissionWheel::Entry> expired;
+    m_wheel.advance(current, expired);
+
     std::vector<rls::PduInfo> transmissionFailures;
 
-    for (auto &pdu : m_pduMap)
+    for (auto &item : expired)
     {
-        auto delta = current - pdu.second.sentTime;
-        if (delta > MAX_PDU_TTL)
+        auto it = m_sendWindows.find(item.endPointId);
+        if (it == m_sendWindows.end())
+            continue;
+
+        // Already acknowledged
+        auto *entry = it->second.find(item.seq);
+        if (entry == nullptr)
+            continue;
+
+        if (entry->deadline > current)
         {
-            transmissionFailureIds.push_back(pdu.first);
-            transmissionFailures.push_back(std::move(pdu.second));
+            m_wheel.schedule(entry->deadline, item.endPointId, item.seq);
+            continue;
         }
-    }
 
-    for (auto id : transmissionFailureIds)
-        m_pduMap.erase(id);
+        if (current - entry->info.sentTime >= MAX_PDU_TTL)
+        {
+            transmissionFailures.push_back(it->second.remove(item.seq));
+            continue;
+        }
 
-    if (!transmissionFailures.empty())
-    {
-        auto w = std::make_unique<NmUeRlsToRls>(NmUeRlsToRls::TRANSMISSION_FAILURE);
-        w->pduList = std::move(transmissionFailures);
-        m_mainTask->push(std::move(w));
+        entry->deadline = current + RETRANSMISSION_INTERVAL;
+        m_wheel.schedule(entry->deadline, item.endPointId, item.seq);
+
+        rls::RlsPduTransmission msg{m_shCtx->sti};
+        msg.pduType = rls::EPduType::RRC;
+        msg.pdu = entry->info.pdu.copy();
+        msg.payload = static_cast<uint32_t>(entry->info.rrcChannel);
+        msg.pduId = item.seq;
+        msg.epoch = it->second.epoch();
+
+        m_udpTask->send(item.endPointId, msg);
     }
+
+    declareTransmissionFailure(std::move(transmissionFailures));
+
+    if (!m_wheel.isEmpty())
+        m_retransmissionTimerSet = setTimer(TIMER_ID_RETRANSMISSION, rls::RetransmissionWheel::TICK);
 }
 
 void RlsControlTask::onAckSendTimerExpired()
 {
-    auto copy = m_pendingAck;
-    m_pendingAck.clear();
-
-    for (auto &item : copy)
+    for (int cellId : m_pendingAck)
     {
-        if (!item.second.empty())
+        auto it = m_receiveWindows.find(cellId);
+        if (it == m_receiveWindows.end())
             continue;
 
         rls::RlsPduTransmissionAck msg{m_shCtx->sti};
-        msg.pduIds = std::move(item.second);
+        msg.epoch = it->second.epoch();
+        msg.cumulative = it->second.cumulative();
+        msg.bitmap = it->second.bitmap();
 
-        m_udpTask->send(item.first, msg);
+        m_udpTask->send(cellId, msg);
     }
+
+    m_pendingAck.clear();
 }
 
 } // namespace nr::ue
@@ -11,6 +11,7 @@
 #include "udp_task.hpp"
 
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include <lib/rrc/rrc.hpp>
@@ -26,11 +27,16 @@ class RlsControlTask : public NtsTask
   private:
     std::unique_ptr<Logger> m_logger;
     RlsSharedContext *m_shCtx;
+    UserPlaneFastPath *m_fastPath;
     int m_servingCell;
     NtsTask *m_mainTask;
     RlsUdpTask *m_udpTask;
-    std::unordered_map<uint32_t, rls::PduInfo> m_pduMap;
-    std::unordered_map<int, std::vector<uint32_t>> m_pendingAck;
+    std::unordered_map<int, rls::SendWindow> m_sendWindows;
+    std::unordered_map<int, rls::ReceiveWindow> m_receiveWindows;
+    rls::RetransmissionWheel m_wheel;
+    std::unordered_set<int> m_pendingAck;
+    bool m_retransmissionTimerSet;
+    bool m_ackTimerSet;
 
   public:
     explicit RlsControlTask(TaskBase *base, RlsSharedContext *shCtx);
@@ -49,7 +55,9 @@ class RlsControlTask : public NtsTask
     void handleSignalChange(int cellId, int dbm);
     void handleUplinkRrcDelivery(int cellId, uint32_t pduId, rrc::RrcChannel channel, OctetString &&data);
     void handleUplinkDataDelivery(int psi, OctetString &&data);
-    void onAckControlTimerExpired();
+    void scheduleRetransmission(int64_t deadline, int cellId, uint32_t seq);
+    void declareTransmissionFailure(std::vector<rls::PduInfo> &&pduList);
+    void onRetransmissionTimerExpired();
     void onAckSendTimerExpired();
 };
 
@@ -68,6 +68,7 @@ void UeRlsTask::onLoop()
             m->cellId = w.cellId;
             m->channel = w.rrcChannel;
             m->pdu = std::move(w.data);
+            m->pagingTag = w.pagingTag;
             m_base->rrcTask->push(std::move(m));
             break;
         }
@@ -8,10 +8,13 @@
 
 #include "udp_task.hpp"
 
+#include <algorithm>
 #include <cstdint>
 #include <cstring>
 #include <set>
 
+#include <ue/fast_path.hpp>
+#include <ue/mobility.hpp>
 #include <ue/nts.hpp>
 #include <utils/common.hpp>
 #include <utils/constants.hpp>
@@ -25,15 +28,20 @@ namespace nr::ue
 {
 
 RlsUdpTask::RlsUdpTask(TaskBase *base, RlsSharedContext *shCtx, const std::vector<std::string> &searchSpace)
-    : m_server{}, m_ctlTask{}, m_shCtx{shCtx}, m_searchSpace{}, m_cells{}, m_cellIdToSti{}, m_lastLoop{},
-      m_cellIdCounter{}
+    : m_server{}, m_ctlTask{}, m_shCtx{shCtx}, m_fastPath{base->fastPath}, m_searchSpace{}, m_cells{}, m_cellIdToSti{}, m_lastLoop{},
+      m_cellIdCounter{}, m_mobility{base->config->mobilityTask}, m_mobilitySlot{base->config->mobilitySlot},
+      m_searchCells{}, m_nearbyCells{}
 {
     m_logger = base->logBase->makeUniqueLogger(base->config->getLoggerPrefix() + "rls-udp");
 
     m_server = new udp::UdpServer();
+    m_fastPath->attachRadioLink(m_server, m_shCtx);
 
     for (auto &ip : searchSpace)
+    {
         m_searchSpace.emplace_back(ip, cons::RadioLinkPort);
+        m_searchCells.push_back(m_mobility ? m_mobility->cellIndexOf(ip) : -1);
+    }
 
     m_simPos = Vector3{};
 }
@@ -48,6 +56,8 @@ void RlsUdpTask::onLoop()
     if (current - m_lastLoop > LOOP_PERIOD)
     {
         m_lastLoop = current;
+        if (m_mobility)
+            m_simPos = m_mobility->positionOf(m_mobilitySlot);
         heartbeatCycle(current, m_simPos);
     }
 
@@ -67,13 +77,14 @@ void RlsUdpTask::onLoop()
 
 void RlsUdpTask::onQuit()
 {
+    m_fastPath->attachRadioLink(nullptr, nullptr);
     delete m_server;
 }
 
-void RlsUdpTask::sendRlsPdu(const InetAddress &addr, const rls::RlsMessage &msg)
+void RlsUdpTask::sendRlsPdu(const InetAddress &addr, const rls::RlsMessage &msg, uint64_t targetSti)
 {
     OctetString stream;
-    rls::EncodeRlsMessage(msg, stream);
+    rls::EncodeRlsMessage(msg, targetSti, stream);
 
     m_server->Send(addr, stream.data(), static_cast<size_t>(stream.length()));
 }
@@ -83,7 +94,7 @@ void RlsUdpTask::send(int cellId, const rls::RlsMessage &msg)
     if (m_cellIdToSti.count(cellId))
     {
         auto sti = m_cellIdToSti[cellId];
-        sendRlsPdu(m_cells[sti].address, msg);
+        sendRlsPdu(m_cells[sti].address, msg, sti);
     }
 }
 
@@ -95,6 +106,7 @@ void RlsUdpTask::receiveRlsPdu(const InetAddress &addr, std::unique_ptr<rls::Rls
         {
             m_cells[msg->sti].cellId = ++m_cellIdCounter;
             m_cellIdToSti[m_cells[msg->sti].cellId] = msg->sti;
+            checkCellPosition(addr, ((const rls::RlsHeartBeatAck &)*msg).simPos);
         }
 
         int oldDbm = INT32_MIN;
@@ -103,6 +115,7 @@ void RlsUdpTask::receiveRlsPdu(const InetAddress &addr, std::unique_ptr<rls::Rls
 
         m_cells[msg->sti].address = addr;
         m_cells[msg->sti].lastSeen = utils::CurrentTimeMillis();
+        m_fastPath->setCellLink(m_cells[msg->sti].cellId, addr, msg->sti);
 
         int newDbm = ((const rls::RlsHeartBeatAck &)*msg).dbm;
         m_cells[msg->sti].dbm = newDbm;
@@ -139,6 +152,22 @@ void RlsUdpTask::onSignalChangeOrLost(int cellId)
     m_ctlTask->push(std::move(w));
 }
 
+void RlsUdpTask::checkCellPosition(const InetAddress &addr, const Vector3 &position)
+{
+    if (!m_mobility)
+        return;
+
+    auto address = addr.toString();
+    for (size_t i = 0; i < m_searchSpace.size(); i++)
+    {
+        if (m_searchSpace[i].toString() != address || m_mobility->checkCellPosition(m_searchCells[i], position))
+            continue;
+
+        m_logger->warn("Mobility cell position of %s does not match the gNB position %d, %d, %d", address.c_str(),
+                       position.x, position.y, position.z);
+    }
+}
+
 void RlsUdpTask::heartbeatCycle(uint64_t time, const Vector3 &simPos)
 {
     std::set<std::pair<uint64_t, int>> toRemove;
@@ -154,16 +183,25 @@ void RlsUdpTask::heartbeatCycle(uint64_t time, const Vector3 &simPos)
     {
         m_cells.erase(cell.first);
         m_cellIdToSti.erase(cell.second);
+        m_fastPath->removeCellLink(cell.second);
     }
 
     for (auto cell : toRemove)
         onSignalChangeOrLost(cell.second);
 
-    for (auto &addr : m_searchSpace)
+    if (m_mobility)
+        m_mobility->findNearbyCells(simPos, m_nearbyCells);
+
+    for (size_t i = 0; i < m_searchSpace.size(); i++)
     {
+        // The entries with known positions are searched only while the UE is in their range
+        int cell = m_searchCells[i];
+        if (cell >= 0 && std::find(m_nearbyCells.begin(), m_nearbyCells.end(), cell) == m_nearbyCells.end())
+            continue;
+
         rls::RlsHeartBeat msg{m_shCtx->sti};
         msg.simPos = simPos;
-        sendRlsPdu(addr, msg);
+        sendRlsPdu(m_searchSpace[i], msg, 0);
     }
 }
 
@@ -36,12 +36,17 @@ class RlsUdpTask : public NtsTask
     udp::UdpServer *m_server;
     NtsTask *m_ctlTask;
     RlsSharedContext* m_shCtx;
+    UserPlaneFastPath *m_fastPath;
     std::vector<InetAddress> m_searchSpace;
     std::unordered_map<uint64_t, CellInfo> m_cells;
     std::unordered_map<int, uint64_t> m_cellIdToSti;
     int64_t m_lastLoop;
     Vector3 m_simPos;
     int m_cellIdCounter;
+    UeMobilityTask *m_mobility;
+    int m_mobilitySlot;
+    std::vector<int> m_searchCells;
+    std::vector<int> m_nearbyCells;
 
     friend class UeCmdHandler;
 
@@ -55,10 +60,11 @@ class RlsUdpTask : public NtsTask
     void onQuit() override;
 
   private:
-    void sendRlsPdu(const InetAddress &addr, const rls::RlsMessage &msg);
+    void sendRlsPdu(const InetAddress &addr, const rls::RlsMessage &msg, uint64_t targetSti);
     void receiveRlsPdu(const InetAddress &addr, std::unique_ptr<rls::RlsMessage> &&msg);
     void onSignalChangeOrLost(int cellId);
     void heartbeatCycle(uint64_t time, const Vector3 &simPos);
+    void checkCellPosition(const InetAddress &addr, const Vector3 &position);
 
   public:
     void initialize(NtsTask *ctlTask);
@@ -27,8 +27,11 @@ void UeRrcTask::handleCellSignalChange(int cellId, int dbm)
     {
         if (considerLost)
             notifyCellLost(cellId);
-        else
+        else if (m_cellDesc[cellId].dbm != dbm)
+        {
             m_cellDesc[cellId].dbm = dbm;
+            triggerCycle();
+        }
     }
 }
 
@@ -66,6 +69,8 @@ void UeRrcTask::notifyCellLost(int cellId)
 
     if (isActiveCell)
     {
+        publishUacBarring();
+
         if (m_state != ERrcState::RRC_IDLE)
             declareRadioLinkFailure(rls::ERlfCause::SIGNAL_LOST_TO_CONNECTED_CELL);
         else
@@ -94,11 +99,14 @@ void UeRrcTask::updateAvailablePlmns()
     m_base->shCtx.availablePlmns.mutate([this](std::unordered_set<Plmn> &value) {
         value.clear();
         for (auto &cellDesc : m_cellDesc)
-            if (cellDesc.second.sib1.hasSib1)
-                value.insert(cellDesc.second.sib1.plmn);
+            if (cellDesc.second.sib1)
+                value.insert(cellDesc.second.sib1->plmn);
     });
 
     m_base->nasTask->push(std::make_unique<NmUeRrcToNas>(NmUeRrcToNas::NAS_NOTIFY));
+
+    // Cells in coverage or their system information changed, so cell selection is re-evaluated
+    triggerCycle();
 }
 
 } // namespace nr::ue
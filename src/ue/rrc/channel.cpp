@@ -19,7 +19,7 @@
 namespace nr::ue
 {
 
-void UeRrcTask::handleDownlinkRrc(int cellId, rrc::RrcChannel channel, const OctetString &rrcPdu)
+void UeRrcTask::handleDownlinkRrc(int cellId, rrc::RrcChannel channel, uint32_t pagingTag, const OctetString &rrcPdu)
 {
     if (!hasSignalToCell(cellId))
         return;
@@ -27,21 +27,11 @@ void UeRrcTask::handleDownlinkRrc(int cellId, rrc::RrcChannel channel, const Oct
     switch (channel)
     {
     case rrc::RrcChannel::BCCH_BCH: {
-        auto *pdu = rrc::encode::Decode<ASN_RRC_BCCH_BCH_Message>(asn_DEF_ASN_RRC_BCCH_BCH_Message, rrcPdu);
-        if (pdu == nullptr)
-            m_logger->err("RRC BCCH-BCH PDU decoding failed.");
-        else
-            receiveRrcMessage(cellId, pdu);
-        asn::Free(asn_DEF_ASN_RRC_BCCH_BCH_Message, pdu);
+        receiveBcchBch(cellId, rrcPdu);
         break;
     }
     case rrc::RrcChannel::BCCH_DL_SCH: {
-        auto *pdu = rrc::encode::Decode<ASN_RRC_BCCH_DL_SCH_Message>(asn_DEF_ASN_RRC_BCCH_DL_SCH_Message, rrcPdu);
-        if (pdu == nullptr)
-            m_logger->err("RRC BCCH-DL-SCH PDU decoding failed.");
-        else
-            receiveRrcMessage(cellId, pdu);
-        asn::Free(asn_DEF_ASN_RRC_BCCH_DL_SCH_Message, pdu);
+        receiveBcchDlSch(cellId, rrcPdu);
         break;
     }
     case rrc::RrcChannel::DL_CCCH: {
@@ -66,7 +56,7 @@ void UeRrcTask::handleDownlinkRrc(int cellId, rrc::RrcChannel channel, const Oct
         break;
     };
     case rrc::RrcChannel::PCCH: {
-        if (isActiveCell(cellId))
+        if (isActiveCell(cellId) && isOwnPagingOccasion(pagingTag))
         {
             auto *pdu = rrc::encode::Decode<ASN_RRC_PCCH_Message>(asn_DEF_ASN_RRC_PCCH_Message, rrcPdu);
             if (pdu == nullptr)
@@ -132,28 +122,6 @@ void UeRrcTask::sendRrcMessage(ASN_RRC_UL_DCCH_Message *msg)
     m_base->rlsTask->push(std::move(m));
 }
 
-void UeRrcTask::receiveRrcMessage(int cellId, ASN_RRC_BCCH_BCH_Message *msg)
-{
-    if (msg->message.present == ASN_RRC_BCCH_BCH_MessageType_PR_mib)
-        receiveMib(cellId, *msg->message.choice.mib);
-}
-
-void UeRrcTask::receiveRrcMessage(int cellId, ASN_RRC_BCCH_DL_SCH_Message *msg)
-{
-    if (msg->message.present != ASN_RRC_BCCH_DL_SCH_MessageType_PR_c1)
-        return;
-
-    auto &c1 = msg->message.choice.c1;
-    switch (c1->present)
-    {
-    case ASN_RRC_BCCH_DL_SCH_MessageType__c1_PR_systemInformationBlockType1:
-        receiveSib1(cellId, *c1->choice.systemInformationBlockType1);
-        break;
-    default:
-        break;
-    }
-}
-
 void UeRrcTask::receiveRrcMessage(int cellId, ASN_RRC_DL_CCCH_Message *msg)
 {
     if (msg->message.present != ASN_RRC_DL_CCCH_MessageType_PR_c1)
@@ -59,9 +59,9 @@ void UeRrcTask::startConnectionEstablishment(OctetString &&nasPdu)
     }
 
     /* Handle Initial UE Identity (S-TMSI or 39-bit random value) */
-    std::optional<GutiMobileIdentity> gutiOrTmsi = m_base->shCtx.providedGuti.get();
+    std::optional<GutiMobileIdentity> gutiOrTmsi = *m_base->shCtx.providedGuti.get();
     if (!gutiOrTmsi)
-        gutiOrTmsi = m_base->shCtx.providedTmsi.get();
+        gutiOrTmsi = *m_base->shCtx.providedTmsi.get();
 
     if (gutiOrTmsi)
     {
@@ -113,9 +113,9 @@ void UeRrcTask::receiveRrcSetup(int cellId, const ASN_RRC_RRCSetup &msg)
     asn::SetOctetString(ies->dedicatedNAS_Message, m_initialNasPdu);
 
     /* Send S-TMSI if available */
-    std::optional<GutiMobileIdentity> gutiOrTmsi = m_base->shCtx.providedGuti.get();
+    std::optional<GutiMobileIdentity> gutiOrTmsi = *m_base->shCtx.providedGuti.get();
     if (!gutiOrTmsi)
-        gutiOrTmsi = m_base->shCtx.providedTmsi.get();
+        gutiOrTmsi = *m_base->shCtx.providedTmsi.get();
     if (gutiOrTmsi)
     {
         auto &sTmsi = setupComplete->criticalExtensions.choice.rrcSetupComplete->ng_5G_S_TMSI_Value =
@@ -32,9 +32,29 @@
 namespace nr::ue
 {
 
-void UeRrcTask::receivePaging(const ASN_RRC_Paging &msg)
+bool UeRrcTask::isOwnPagingOccasion(uint32_t pagingTag)
+{
+    // Paging occasions are only monitored in RRC-IDLE and RRC-INACTIVE
+    if (m_state == ERrcState::RRC_CONNECTED)
+        return true;
+
+    auto occasion = rrc::PagingOccasion::FromTag(pagingTag);
+    if (!occasion.has_value())
+        return true;
+
+    // Paging is by 5G-S-TMSI only, the UE cannot be paged without a 5G-GUTI
+    auto tmsi = m_base->shCtx.pagingTmsi.get();
+    if (!tmsi->has_value())
+        return false;
+
+    return rrc::PagingOccasion::Of(static_cast<uint32_t>((*tmsi)->tmsi), occasion->cycle).frame == occasion->frame;
+}
+
+std::vector<GutiMobileIdentity> PagingTmsiList(const ASN_RRC_Paging &msg)
 {
     std::vector<GutiMobileIdentity> tmsiIds{};
+    if (msg.pagingRecordList == nullptr)
+        return tmsiIds;
 
     asn::ForeachItem(*msg.pagingRecordList, [&tmsiIds](auto &pagingRecord) {
         if (pagingRecord.ue_Identity.present == ASN_RRC_PagingUE_Identity_PR_ng_5G_S_TMSI)
@@ -50,9 +70,13 @@ void UeRrcTask::receivePaging(const ASN_RRC_Paging &msg)
             tmsiIds.push_back(tmsi);
         }
     });
+    return tmsiIds;
+}
 
+void UeRrcTask::receivePaging(const ASN_RRC_Paging &msg)
+{
     auto w = std::make_unique<NmUeRrcToNas>(NmUeRrcToNas::PAGING);
-    w->pagingTmsi = std::move(tmsiIds);
+    w->pagingTmsi = PagingTmsiList(msg);
     m_base->nasTask->push(std::move(w));
 }
 
@@ -26,18 +26,18 @@ void UeRrcTask::performCellSelection()
 
     if (currentTime - m_startedTime <= 1000LL && m_cellDesc.empty())
         return;
-    if (currentTime - m_startedTime <= 4000LL && !m_base->shCtx.selectedPlmn.get().hasValue())
+    if (currentTime - m_startedTime <= 4000LL && !m_base->shCtx.selectedPlmn.get()->hasValue())
         return;
 
     auto lastCell = m_base->shCtx.currentCell.get();
 
-    bool shouldLogErrors = lastCell.cellId != 0 || (currentTime - m_lastTimePlmnSearchFailureLogged >= 30'000LL);
+    bool shouldLogErrors = lastCell->cellId != 0 || (currentTime - m_lastTimePlmnSearchFailureLogged >= 30'000LL);
 
     ActiveCellInfo cellInfo;
     CellSelectionReport report;
 
     bool cellFound = false;
-    if (m_base->shCtx.selectedPlmn.get().hasValue())
+    if (m_base->shCtx.selectedPlmn.get()->hasValue())
     {
         cellFound = lookForSuitableCell(cellInfo, report);
         if (!cellFound)
@@ -93,26 +93,27 @@ void UeRrcTask::performCellSelection()
 
     int selectedCell = cellInfo.cellId;
     m_base->shCtx.currentCell.set(cellInfo);
+    publishUacBarring();
 
-    if (selectedCell != 0 && selectedCell != lastCell.cellId)
+    if (selectedCell != 0 && selectedCell != lastCell->cellId)
         m_logger->info("Selected cell plmn[%s] tac[%d] category[%s]", ToJson(cellInfo.plmn).str().c_str(), cellInfo.tac,
                        ToJson(cellInfo.category).str().c_str());
 
-    if (selectedCell != lastCell.cellId)
+    if (selectedCell != lastCell->cellId)
     {
         auto w1 = std::make_unique<NmUeRrcToRls>(NmUeRrcToRls::ASSIGN_CURRENT_CELL);
         w1->cellId = selectedCell;
         m_base->rlsTask->push(std::move(w1));
 
         auto w2 = std::make_unique<NmUeRrcToNas>(NmUeRrcToNas::ACTIVE_CELL_CHANGED);
-        w2->previousTai = Tai{lastCell.plmn, lastCell.tac};
+        w2->previousTai = Tai{lastCell->plmn, lastCell->tac};
         m_base->nasTask->push(std::move(w2));
     }
 }
 
 bool UeRrcTask::lookForSuitableCell(ActiveCellInfo &cellInfo, CellSelectionReport &report)
 {
-    Plmn selectedPlmn = m_base->shCtx.selectedPlmn.get();
+    Plmn selectedPlmn = *m_base->shCtx.selectedPlmn.get();
     if (!selectedPlmn.hasValue())
         return false;
 
@@ -122,37 +123,37 @@ bool UeRrcTask::lookForSuitableCell(ActiveCellInfo &cellInfo, CellSelectionRepor
     {
         auto &cell = item.second;
 
-        if (!cell.sib1.hasSib1)
+        if (!cell.sib1)
         {
             report.siMissingCells++;
             continue;
         }
 
-        if (!cell.mib.hasMib)
+        if (!cell.mib)
         {
             report.siMissingCells++;
             continue;
         }
 
-        if (cell.sib1.plmn != selectedPlmn)
+        if (cell.sib1->plmn != selectedPlmn)
         {
             report.outOfPlmnCells++;
             continue;
         }
 
-        if (cell.mib.isBarred)
+        if (cell.mib->isBarred)
         {
             report.barredCells++;
             continue;
         }
 
-        if (cell.sib1.isReserved)
+        if (cell.sib1->isReserved)
         {
             report.reservedCells++;
             continue;
         }
 
-        Tai tai{cell.sib1.plmn, cell.sib1.tac};
+        Tai tai{cell.sib1->plmn, cell.sib1->tac};
 
         if (m_base->shCtx.forbiddenTaiRoaming.get<bool>([&tai](auto &item) {
                 return std::any_of(item.begin(), item.end(), [&tai](auto &element) { return element == tai; });
@@ -189,8 +190,8 @@ bool UeRrcTask::lookForSuitableCell(ActiveCellInfo &cellInfo, CellSelectionRepor
 
     cellInfo = {};
     cellInfo.cellId = selectedId;
-    cellInfo.plmn = selectedCell.sib1.plmn;
-    cellInfo.tac = selectedCell.sib1.tac;
+    cellInfo.plmn = selectedCell.sib1->plmn;
+    cellInfo.tac = selectedCell.sib1->tac;
     cellInfo.category = ECellCategory::SUITABLE_CELL;
 
     return true;
@@ -204,31 +205,31 @@ bool UeRrcTask::lookForAcceptableCell(ActiveCellInfo &cellInfo, CellSelectionRep
     {
         auto &cell = item.second;
 
-        if (!cell.sib1.hasSib1)
+        if (!cell.sib1)
         {
             report.siMissingCells++;
             continue;
         }
 
-        if (!cell.mib.hasMib)
+        if (!cell.mib)
         {
             report.siMissingCells++;
             continue;
         }
 
-        if (cell.mib.isBarred)
+        if (cell.mib->isBarred)
         {
             report.barredCells++;
             continue;
         }
 
-        if (cell.sib1.isReserved)
+        if (cell.sib1->isReserved)
         {
             report.reservedCells++;
             continue;
         }
 
-        Tai tai{cell.sib1.plmn, cell.sib1.tac};
+        Tai tai{cell.sib1->plmn, cell.sib1->tac};
 
         if (m_base->shCtx.forbiddenTaiRoaming.get<bool>([&tai](auto &item) {
                 return std::any_of(item.begin(), item.end(), [&tai](auto &element) { return element == tai; });
@@ -261,7 +262,7 @@ bool UeRrcTask::lookForAcceptableCell(ActiveCellInfo &cellInfo, CellSelectionRep
     });
 
     // Then order candidates by PLMN priority if we have a selected PLMN
-    Plmn selectedPlmn = m_base->shCtx.selectedPlmn.get();
+    Plmn selectedPlmn = *m_base->shCtx.selectedPlmn.get();
     if (selectedPlmn.hasValue())
     {
         // Using stable-sort here
@@ -269,8 +270,8 @@ bool UeRrcTask::lookForAcceptableCell(ActiveCellInfo &cellInfo, CellSelectionRep
             auto &cellA = m_cellDesc[a];
             auto &cellB = m_cellDesc[b];
 
-            bool matchesA = cellA.sib1.hasSib1 && cellA.sib1.plmn == selectedPlmn;
-            bool matchesB = cellB.sib1.hasSib1 && cellB.sib1.plmn == selectedPlmn;
+            bool matchesA = cellA.sib1 && cellA.sib1->plmn == selectedPlmn;
+            bool matchesB = cellB.sib1 && cellB.sib1->plmn == selectedPlmn;
 
             return matchesB < matchesA;
         });
@@ -281,8 +282,8 @@ bool UeRrcTask::lookForAcceptableCell(ActiveCellInfo &cellInfo, CellSelectionRep
 
     cellInfo = {};
     cellInfo.cellId = selectedId;
-    cellInfo.plmn = selectedCell.sib1.plmn;
-    cellInfo.tac = selectedCell.sib1.tac;
+    cellInfo.plmn = selectedCell.sib1->plmn;
+    cellInfo.tac = selectedCell.sib1->tac;
     cellInfo.category = ECellCategory::ACCEPTABLE_CELL;
 
     return true;
@@ -25,7 +25,7 @@ void UeRrcTask::handleRlsSapMessage(NmUeRlsToRrc &msg)
         break;
     }
     case NmUeRlsToRrc::DOWNLINK_RRC_DELIVERY: {
-        handleDownlinkRrc(msg.cellId, msg.channel, msg.pdu);
+        handleDownlinkRrc(msg.cellId, msg.channel, msg.pagingTag, msg.pdu);
         break;
     }
     case NmUeRlsToRrc::RADIO_LINK_FAILURE: {
@@ -56,9 +56,8 @@ void UeRrcTask::handleNasSapMessage(NmUeNasToRrc &msg)
         triggerCycle();
         break;
     }
-    case NmUeNasToRrc::PERFORM_UAC: {
-        if (!msg.uacCtl->isExpiredForProducer())
-            performUac(msg.uacCtl);
+    case NmUeNasToRrc::ESTABLISHMENT_CAUSE: {
+        m_establishmentCause = msg.establishmentCause;
         break;
     }
     }
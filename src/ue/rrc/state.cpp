@@ -18,11 +18,18 @@ namespace nr::ue
 
 void UeRrcTask::triggerCycle()
 {
+    // Coalesce the triggers, one pending cycle already evaluates the latest state
+    if (m_cyclePending)
+        return;
+    m_cyclePending = true;
+
     push(std::make_unique<NmUeRrcToRrc>(NmUeRrcToRrc::TRIGGER_CYCLE));
 }
 
 void UeRrcTask::performCycle()
 {
+    m_cyclePending = false;
+
     if (m_state == ERrcState::RRC_CONNECTED)
     {
     }
@@ -54,6 +61,8 @@ void UeRrcTask::switchState(ERrcState state)
 
 void UeRrcTask::onSwitchState(ERrcState oldState, ERrcState newState)
 {
+    if (newState != ERrcState::RRC_CONNECTED)
+        triggerCycle();
 }
 
 } // namespace nr::ue
\ No newline at end of file
@@ -12,6 +12,7 @@
 #include <lib/asn/utils.hpp>
 #include <lib/rrc/encode.hpp>
 #include <ue/nas/task.hpp>
+#include <ue/sysinfo_cache.hpp>
 
 #include <asn/rrc/ASN_RRC_MIB.h>
 #include <asn/rrc/ASN_RRC_PLMN-IdentityInfo.h>
@@ -19,52 +20,122 @@
 #include <asn/rrc/ASN_RRC_SIB1.h>
 #include <asn/rrc/ASN_RRC_UAC-BarringInfoSet.h>
 
-namespace nr::ue
-{
-
-void UeRrcTask::receiveMib(int cellId, const ASN_RRC_MIB &msg)
+static std::shared_ptr<const nr::ue::UeMibInfo> DecodeMib(const ASN_RRC_MIB &msg)
 {
-    auto &desc = m_cellDesc[cellId];
-
-    desc.mib.isBarred = msg.cellBarred == ASN_RRC_MIB__cellBarred_barred;
-    desc.mib.isIntraFreqReselectAllowed = msg.intraFreqReselection == ASN_RRC_MIB__intraFreqReselection_allowed;
-
-    desc.mib.hasMib = true;
-
-    updateAvailablePlmns();
+    auto mib = std::make_shared<nr::ue::UeMibInfo>();
+    mib->isBarred = msg.cellBarred == ASN_RRC_MIB__cellBarred_barred;
+    mib->isIntraFreqReselectAllowed = msg.intraFreqReselection == ASN_RRC_MIB__intraFreqReselection_allowed;
+    return mib;
 }
 
-void UeRrcTask::receiveSib1(int cellId, const ASN_RRC_SIB1 &msg)
+static std::shared_ptr<const nr::ue::UeSib1Info> DecodeSib1(const ASN_RRC_SIB1 &msg)
 {
-    auto &desc = m_cellDesc[cellId];
+    auto sib1 = std::make_shared<nr::ue::UeSib1Info>();
 
-    desc.sib1.isReserved = msg.cellAccessRelatedInfo.cellReservedForOtherUse != nullptr;
+    sib1->isReserved = msg.cellAccessRelatedInfo.cellReservedForOtherUse != nullptr;
 
     auto *plmnIdentityInfo = msg.cellAccessRelatedInfo.plmn_IdentityList.list.array[0];
-    desc.sib1.nci = asn::GetBitStringLong<36>(plmnIdentityInfo->cellIdentity);
+    sib1->nci = asn::GetBitStringLong<36>(plmnIdentityInfo->cellIdentity);
 
-    desc.sib1.isReserved &=
+    sib1->isReserved &=
         plmnIdentityInfo->cellReservedForOperatorUse == ASN_RRC_PLMN_IdentityInfo__cellReservedForOperatorUse_reserved;
 
-    desc.sib1.tac = asn::GetBitStringInt<24>(*plmnIdentityInfo->trackingAreaCode);
+    sib1->tac = asn::GetBitStringInt<24>(*plmnIdentityInfo->trackingAreaCode);
 
     auto plmnIdentity = plmnIdentityInfo->plmn_IdentityList.list.array[0];
-    desc.sib1.plmn = asn::rrc::GetPlmnId(*plmnIdentity);
+    sib1->plmn = asn::rrc::GetPlmnId(*plmnIdentity);
 
     auto *barringInfo = msg.uac_BarringInfo->uac_BarringInfoSetList.list.array[0];
 
     int barringBits = asn::GetBitStringInt<7>(barringInfo->uac_BarringForAccessIdentity);
-    desc.sib1.aiBarringSet.ai15 = bits::BitAt<0>(barringBits);
-    desc.sib1.aiBarringSet.ai14 = bits::BitAt<1>(barringBits);
-    desc.sib1.aiBarringSet.ai13 = bits::BitAt<2>(barringBits);
-    desc.sib1.aiBarringSet.ai12 = bits::BitAt<3>(barringBits);
-    desc.sib1.aiBarringSet.ai11 = bits::BitAt<4>(barringBits);
-    desc.sib1.aiBarringSet.ai2 = bits::BitAt<5>(barringBits);
-    desc.sib1.aiBarringSet.ai1 = bits::BitAt<6>(barringBits);
+    sib1->aiBarringSet.ai15 = bits::BitAt<0>(barringBits);
+    sib1->aiBarringSet.ai14 = bits::BitAt<1>(barringBits);
+    sib1->aiBarringSet.ai13 = bits::BitAt<2>(barringBits);
+    sib1->aiBarringSet.ai12 = bits::BitAt<3>(barringBits);
+    sib1->aiBarringSet.ai11 = bits::BitAt<4>(barringBits);
+    sib1->aiBarringSet.ai2 = bits::BitAt<5>(barringBits);
+    sib1->aiBarringSet.ai1 = bits::BitAt<6>(barringBits);
+
+    return sib1;
+}
+
+namespace nr::ue
+{
+
+void UeRrcTask::receiveBcchBch(int cellId, const OctetString &pdu)
+{
+    auto *cache = m_base->config->siCache;
+
+    std::shared_ptr<const UeMibInfo> mib = cache ? cache->findMib(pdu) : nullptr;
+    if (mib == nullptr)
+    {
+        auto *msg = rrc::encode::Decode<ASN_RRC_BCCH_BCH_Message>(asn_DEF_ASN_RRC_BCCH_BCH_Message, pdu);
+        if (msg == nullptr)
+        {
+            m_logger->err("RRC BCCH-BCH PDU decoding failed.");
+            return;
+        }
+
+        if (msg->message.present == ASN_RRC_BCCH_BCH_MessageType_PR_mib)
+            mib = DecodeMib(*msg->message.choice.mib);
+        asn::Free(asn_DEF_ASN_RRC_BCCH_BCH_Message, msg);
+
+        if (mib == nullptr)
+            return;
+        if (cache)
+            cache->storeMib(pdu, mib);
+    }
+
+    receiveMib(cellId, std::move(mib));
+}
+
+void UeRrcTask::receiveBcchDlSch(int cellId, const OctetString &pdu)
+{
+    auto *cache = m_base->config->siCache;
+
+    std::shared_ptr<const UeSib1Info> sib1 = cache ? cache->findSib1(pdu) : nullptr;
+    if (sib1 == nullptr)
+    {
+        auto *msg = rrc::encode::Decode<ASN_RRC_BCCH_DL_SCH_Message>(asn_DEF_ASN_RRC_BCCH_DL_SCH_Message, pdu);
+        if (msg == nullptr)
+        {
+            m_logger->err("RRC BCCH-DL-SCH PDU decoding failed.");
+            return;
+        }
+
+        // Other system information blocks are not used
+        if (msg->message.present == ASN_RRC_BCCH_DL_SCH_MessageType_PR_c1 &&
+            msg->message.choice.c1->present == ASN_RRC_BCCH_DL_SCH_MessageType__c1_PR_systemInformationBlockType1)
+            sib1 = DecodeSib1(*msg->message.choice.c1->choice.systemInformationBlockType1);
+        asn::Free(asn_DEF_ASN_RRC_BCCH_DL_SCH_Message, msg);
+
+        if (sib1 == nullptr)
+            return;
+        if (cache)
+            cache->storeSib1(pdu, sib1);
+    }
+
+    receiveSib1(cellId, std::move(sib1));
+}
+
+void UeRrcTask::receiveMib(int cellId, std::shared_ptr<const UeMibInfo> &&mib)
+{
+    m_cellDesc[cellId].mib = std::move(mib);
+
+    if (isActiveCell(cellId))
+        publishUacBarring();
+
+    updateAvailablePlmns();
+}
+
+void UeRrcTask::receiveSib1(int cellId, std::shared_ptr<const UeSib1Info> &&sib1)
+{
+    m_cellDesc[cellId].sib1 = std::move(sib1);
 
-    desc.sib1.hasSib1 = true;
+    if (isActiveCell(cellId))
+        publishUacBarring();
 
     updateAvailablePlmns();
 }
 
-} // namespace nr::ue
\ No newline at end of file
+} // namespace nr::ue
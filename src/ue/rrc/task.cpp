@@ -18,7 +18,10 @@
 #include <utils/common.hpp>
 
 static constexpr const int TIMER_ID_MACHINE_CYCLE = 1;
-static constexpr const int TIMER_PERIOD_MACHINE_CYCLE = 2500;
+static constexpr const int TIMER_ID_STARTUP_CYCLE = 2;
+
+// Cell selection waits up to 4 seconds after startup for a PLMN to be selected, re-evaluate once it has passed
+static constexpr const int TIMER_PERIOD_STARTUP_CYCLE = 4100;
 
 namespace nr::ue
 {
@@ -36,7 +39,9 @@ void UeRrcTask::onStart()
 {
     triggerCycle();
 
-    setTimer(TIMER_ID_MACHINE_CYCLE, TIMER_PERIOD_MACHINE_CYCLE);
+    setTimer(TIMER_ID_STARTUP_CYCLE, TIMER_PERIOD_STARTUP_CYCLE);
+    if (m_base->config->safetyCycle.rrc > 0)
+        setTimer(TIMER_ID_MACHINE_CYCLE, m_base->config->safetyCycle.rrc);
 }
 
 void UeRrcTask::onQuit()
@@ -74,7 +79,11 @@ void UeRrcTask::onLoop()
         auto &w = dynamic_cast<NmTimerExpired &>(*msg);
         if (w.timerId == TIMER_ID_MACHINE_CYCLE)
         {
-            setTimer(TIMER_ID_MACHINE_CYCLE, TIMER_PERIOD_MACHINE_CYCLE);
+            setTimer(TIMER_ID_MACHINE_CYCLE, m_base->config->safetyCycle.rrc);
+            performCycle();
+        }
+        else if (w.timerId == TIMER_ID_STARTUP_CYCLE)
+        {
             performCycle();
         }
         break;
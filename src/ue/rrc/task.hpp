@@ -22,8 +22,6 @@
 
 extern "C"
 {
-    struct ASN_RRC_BCCH_BCH_Message;
-    struct ASN_RRC_BCCH_DL_SCH_Message;
     struct ASN_RRC_DL_CCCH_Message;
     struct ASN_RRC_DL_DCCH_Message;
     struct ASN_RRC_PCCH_Message;
@@ -38,8 +36,6 @@ extern "C"
     struct ASN_RRC_RRCReject;
     struct ASN_RRC_RRCRelease;
     struct ASN_RRC_Paging;
-    struct ASN_RRC_MIB;
-    struct ASN_RRC_SIB1;
 }
 
 namespace nr::ue
@@ -54,6 +50,7 @@ class UeRrcTask : public NtsTask
     int64_t m_startedTime;
     ERrcState m_state;
     RrcTimers m_timers;
+    bool m_cyclePending{};
 
     /* Cell and PLMN related */
     std::unordered_map<int, UeCellDesc> m_cellDesc{};
@@ -81,14 +78,13 @@ class UeRrcTask : public NtsTask
   private:
     /* Handlers */
     void receivePaging(const ASN_RRC_Paging &msg);
+    bool isOwnPagingOccasion(uint32_t pagingTag);
 
     /* RRC Message Transmission and Receive */
-    void handleDownlinkRrc(int cellId, rrc::RrcChannel channel, const OctetString &pdu);
+    void handleDownlinkRrc(int cellId, rrc::RrcChannel channel, uint32_t pagingTag, const OctetString &pdu);
     void sendRrcMessage(int cellId, ASN_RRC_UL_CCCH_Message *msg);
     void sendRrcMessage(int cellId, ASN_RRC_UL_CCCH1_Message *msg);
     void sendRrcMessage(ASN_RRC_UL_DCCH_Message *msg);
-    void receiveRrcMessage(int cellId, ASN_RRC_BCCH_BCH_Message *msg);
-    void receiveRrcMessage(int cellId, ASN_RRC_BCCH_DL_SCH_Message *msg);
     void receiveRrcMessage(int cellId, ASN_RRC_DL_CCCH_Message *msg);
     void receiveRrcMessage(ASN_RRC_DL_DCCH_Message *msg);
     void receiveRrcMessage(ASN_RRC_PCCH_Message *msg);
@@ -117,8 +113,10 @@ class UeRrcTask : public NtsTask
     void updateAvailablePlmns();
 
     /* System Information and Broadcast */
-    void receiveMib(int cellId, const ASN_RRC_MIB &msg);
-    void receiveSib1(int cellId, const ASN_RRC_SIB1 &msg);
+    void receiveBcchBch(int cellId, const OctetString &pdu);
+    void receiveBcchDlSch(int cellId, const OctetString &pdu);
+    void receiveMib(int cellId, std::shared_ptr<const UeMibInfo> &&mib);
+    void receiveSib1(int cellId, std::shared_ptr<const UeSib1Info> &&sib1);
 
     /* NAS Transport */
     void deliverUplinkNas(uint32_t pduId, OctetString &&nasPdu);
@@ -136,7 +134,10 @@ class UeRrcTask : public NtsTask
     void handleRadioLinkFailure(rls::ERlfCause cause);
 
     /* Access Control */
-    void performUac(std::shared_ptr<LightSync<UacInput, UacOutput>> &uacCtl);
+    void publishUacBarring();
 };
 
+/* 5G-S-TMSIs of the paging records, the records with other identities are skipped */
+std::vector<GutiMobileIdentity> PagingTmsiList(const ASN_RRC_Paging &msg);
+
 } // namespace nr::ue
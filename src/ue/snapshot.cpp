@@ -0,0 +1,141 @@
+//
+// This file is a part of UERANSIM project.
+// Copyright (c) 2023 ALİ GÜNGÖR.
+//
+// https://github.com/aligungr/UERANSIM/
+// See README, LICENSE, and CONTRIBUTING files for licensing details.
+//
+
+#include "snapshot.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <utils/libc_error.hpp>
+
+static const char FILE_MAGIC[8] = {'U', 'E', 'S', 'N', 'A', 'P', 0, 1};
+static const size_t FILE_HEADER_SIZE = 64;
+
+struct FileHeader
+{
+    char magic[8];
+    uint32_t slotSize;
+    uint32_t slotCount;
+};
+
+struct SlotHeader
+{
+    // Odd while the slot is being written
+    volatile uint32_t sequence;
+    uint32_t length;
+};
+
+static_assert(sizeof(FileHeader) <= FILE_HEADER_SIZE);
+
+static const size_t SLOT_CAPACITY = nr::ue::UeSnapshotFile::SLOT_SIZE - sizeof(SlotHeader);
+
+namespace nr::ue
+{
+
+UeSnapshotFile::UeSnapshotFile(const std::string &path, size_t slotCount) : m_fd{}, m_data{}, m_size{}, m_slotCount{}
+{
+    m_fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0600);
+    if (m_fd < 0)
+        throw LibError("Snapshot file '" + path + "' could not be opened:", errno);
+
+    struct stat st = {};
+    if (::fstat(m_fd, &st) != 0)
+    {
+        ::close(m_fd);
+        throw LibError("Unable to get stats for '" + path + "':", errno);
+    }
+
+    FileHeader header{};
+    bool compatible = static_cast<size_t>(st.st_size) >= FILE_HEADER_SIZE &&
+                      ::pread(m_fd, &header, sizeof(header), 0) == static_cast<ssize_t>(sizeof(header)) &&
+                      std::memcmp(header.magic, FILE_MAGIC, sizeof(FILE_MAGIC)) == 0 && header.slotSize == SLOT_SIZE;
+
+    // An incompatible file is discarded, the UEs then simply start from scratch
+    if (!compatible)
+        header.slotCount = 0;
+
+    m_slotCount = std::max<size_t>(slotCount, header.slotCount);
+    m_size = FILE_HEADER_SIZE + m_slotCount * SLOT_SIZE;
+
+    if ((!compatible && ::ftruncate(m_fd, 0) != 0) || ::ftruncate(m_fd, static_cast<off_t>(m_size)) != 0)
+    {
+        ::close(m_fd);
+        throw LibError("Snapshot file '" + path + "' could not be resized:", errno);
+    }
+
+    void *data = ::mmap(nullptr, m_size, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+    if (data == MAP_FAILED)
+    {
+        ::close(m_fd);
+        throw LibError("Snapshot file '" + path + "' could not be mapped:", errno);
+    }
+    m_data = reinterpret_cast<uint8_t *>(data);
+
+    auto *fileHeader = reinterpret_cast<FileHeader *>(m_data);
+    std::memcpy(fileHeader->magic, FILE_MAGIC, sizeof(FILE_MAGIC));
+    fileHeader->slotSize = SLOT_SIZE;
+    fileHeader->slotCount = static_cast<uint32_t>(m_slotCount);
+}
+
+UeSnapshotFile::~UeSnapshotFile()
+{
+    ::munmap(m_data, m_size);
+    ::close(m_fd);
+}
+
+bool UeSnapshotFile::store(size_t slot, const OctetString &record)
+{
+    if (slot >= m_slotCount || static_cast<size_t>(record.length()) > SLOT_CAPACITY)
+        return false;
+
+    uint8_t *base = m_data + FILE_HEADER_SIZE + slot * SLOT_SIZE;
+    auto *header = reinterpret_cast<SlotHeader *>(base);
+
+    uint32_t sequence = header->sequence | 1u;
+    header->sequence = sequence;
+    std::atomic_thread_fence(std::memory_order_release);
+
+    header->length = static_cast<uint32_t>(record.length());
+    std::memcpy(base + sizeof(SlotHeader), record.data(), record.length());
+
+    std::atomic_thread_fence(std::memory_order_release);
+    header->sequence = sequence + 1;
+    return true;
+}
+
+std::optional<OctetString> UeSnapshotFile::load(size_t slot) const
+{
+    if (slot >= m_slotCount)
+        return std::nullopt;
+
+    const uint8_t *base = m_data + FILE_HEADER_SIZE + slot * SLOT_SIZE;
+    auto *header = reinterpret_cast<const SlotHeader *>(base);
+
+    // Never written, or the writer has died in the middle of the write
+    if (header->sequence == 0 || (header->sequence & 1u) != 0)
+        return std::nullopt;
+    if (header->length == 0 || header->length > SLOT_CAPACITY)
+        return std::nullopt;
+
+    const uint8_t *payload = base + sizeof(SlotHeader);
+    return OctetString::FromArray(payload, header->length);
+}
+
+void UeSnapshotFile::sync()
+{
+    ::msync(m_data, m_size, MS_SYNC);
+}
+
+} // namespace nr::ue
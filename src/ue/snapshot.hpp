@@ -0,0 +1,51 @@
+//
+// This file is a part of UERANSIM project.
+// Copyright (c) 2023 ALİ GÜNGÖR.
+//
+// https://github.com/aligungr/UERANSIM/
+// See README, LICENSE, and CONTRIBUTING files for licensing details.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+
+#include <utils/octet_string.hpp>
+
+namespace nr::ue
+{
+
+/*
+ * Memory-mapped file of fixed-size slots, one slot per UE of the process. Each UE writes its state into its own slot
+ * whenever the state changes, so nothing has to be serialized at shutdown, and the page cache keeps the state even if
+ * the process is killed. A slot that was being written when the process died is recognized and ignored.
+ */
+class UeSnapshotFile
+{
+  public:
+    static constexpr const size_t SLOT_SIZE = 4096;
+
+  private:
+    int m_fd;
+    uint8_t *m_data;
+    size_t m_size;
+    size_t m_slotCount;
+
+  public:
+    UeSnapshotFile(const std::string &path, size_t slotCount);
+    ~UeSnapshotFile();
+
+    UeSnapshotFile(const UeSnapshotFile &) = delete;
+    UeSnapshotFile &operator=(const UeSnapshotFile &) = delete;
+
+  public:
+    // Not thread-safe per slot, each slot must be owned by a single writer
+    bool store(size_t slot, const OctetString &record);
+    [[nodiscard]] std::optional<OctetString> load(size_t slot) const;
+    void sync();
+};
+
+} // namespace nr::ue
@@ -0,0 +1,69 @@
+//
+// This file is a part of UERANSIM project.
+// Copyright (c) 2023 ALİ GÜNGÖR.
+//
+// https://github.com/aligungr/UERANSIM/
+// See README, LICENSE, and CONTRIBUTING files for licensing details.
+//
+
+#include "sysinfo_cache.hpp"
+
+#include <mutex>
+#include <string_view>
+
+// Only a few distinct broadcasts are expected, the limit just guards against the ever-changing ones
+static const size_t MAX_ENTRIES = 256;
+
+static uint64_t ContentHash(const OctetString &pdu)
+{
+    return std::hash<std::string_view>{}(
+        std::string_view{reinterpret_cast<const char *>(pdu.data()), static_cast<size_t>(pdu.length())});
+}
+
+template <typename T, typename TEntry>
+static std::shared_ptr<const T> Find(std::shared_mutex &mutex, const std::unordered_map<uint64_t, TEntry> &map,
+                                     const OctetString &pdu)
+{
+    std::shared_lock lk(mutex);
+
+    auto it = map.find(ContentHash(pdu));
+    if (it == map.end() || !(it->second.pdu == pdu))
+        return nullptr;
+    return it->second.info;
+}
+
+template <typename T, typename TEntry>
+static void Store(std::shared_mutex &mutex, std::unordered_map<uint64_t, TEntry> &map, const OctetString &pdu,
+                  std::shared_ptr<const T> &&info)
+{
+    std::unique_lock lk(mutex);
+
+    if (map.size() >= MAX_ENTRIES)
+        map.clear();
+    map[ContentHash(pdu)] = TEntry{pdu.copy(), std::move(info)};
+}
+
+namespace nr::ue
+{
+
+std::shared_ptr<const UeMibInfo> UeSystemInfoCache::findMib(const OctetString &pdu)
+{
+    return Find<UeMibInfo>(m_mutex, m_mibs, pdu);
+}
+
+std::shared_ptr<const UeSib1Info> UeSystemInfoCache::findSib1(const OctetString &pdu)
+{
+    return Find<UeSib1Info>(m_mutex, m_sib1s, pdu);
+}
+
+void UeSystemInfoCache::storeMib(const OctetString &pdu, std::shared_ptr<const UeMibInfo> info)
+{
+    Store(m_mutex, m_mibs, pdu, std::move(info));
+}
+
+void UeSystemInfoCache::storeSib1(const OctetString &pdu, std::shared_ptr<const UeSib1Info> info)
+{
+    Store(m_mutex, m_sib1s, pdu, std::move(info));
+}
+
+} // namespace nr::ue
@@ -0,0 +1,55 @@
+//
+// This file is a part of UERANSIM project.
+// Copyright (c) 2023 ALİ GÜNGÖR.
+//
+// https://github.com/aligungr/UERANSIM/
+// See README, LICENSE, and CONTRIBUTING files for licensing details.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <shared_mutex>
+#include <unordered_map>
+
+#include <ue/types.hpp>
+#include <utils/octet_string.hpp>
+
+namespace nr::ue
+{
+
+/*
+ * Decoded system information of the cells, shared by all the UEs of the process. The UEs in the coverage of a cell
+ * receive the same MIB and SIB1 broadcast, so the broadcast is decoded once and then looked up by its content.
+ */
+class UeSystemInfoCache
+{
+  private:
+    template <typename T>
+    struct Entry
+    {
+        OctetString pdu;
+        std::shared_ptr<const T> info;
+    };
+
+    std::shared_mutex m_mutex;
+    std::unordered_map<uint64_t, Entry<UeMibInfo>> m_mibs;
+    std::unordered_map<uint64_t, Entry<UeSib1Info>> m_sib1s;
+
+  public:
+    UeSystemInfoCache() = default;
+
+    UeSystemInfoCache(const UeSystemInfoCache &) = delete;
+    UeSystemInfoCache &operator=(const UeSystemInfoCache &) = delete;
+
+  public:
+    /* Returns null if the given PDU is not decoded before */
+    std::shared_ptr<const UeMibInfo> findMib(const OctetString &pdu);
+    std::shared_ptr<const UeSib1Info> findSib1(const OctetString &pdu);
+
+    void storeMib(const OctetString &pdu, std::shared_ptr<const UeMibInfo> info);
+    void storeSib1(const OctetString &pdu, std::shared_ptr<const UeSib1Info> info);
+};
+
+} // namespace nr::ue
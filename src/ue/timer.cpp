@@ -12,9 +12,9 @@
 
 #include <utils/common.hpp>
 
-UeTimer::UeTimer(int timerCode, bool isMmTimer, int defaultInterval)
-    : m_code(timerCode), m_isMm(isMmTimer), m_interval(defaultInterval), m_startMillis(0), m_isRunning(false),
-      m_expiryCount(0), m_lastDebugPrintMs(0)
+UeTimer::UeTimer(int timerCode, bool isMmTimer, int defaultInterval, NtsTask *task)
+    : m_code(timerCode), m_isMm(isMmTimer), m_task(task), m_interval(defaultInterval), m_startMillis(0),
+      m_endMillis(0), m_isRunning(false), m_expiryCount(0)
 {
 }
 
@@ -37,8 +37,7 @@ void UeTimer::start(bool clearExpiryCount)
 {
     if (clearExpiryCount)
         resetExpiryCount();
-    m_startMillis = utils::CurrentTimeMillis();
-    m_isRunning = true;
+    arm();
 }
 
 void UeTimer::start(const nas::IEGprsTimer2 &v, bool clearExpiryCount)
@@ -46,8 +45,7 @@ void UeTimer::start(const nas::IEGprsTimer2 &v, bool clearExpiryCount)
     if (clearExpiryCount)
         resetExpiryCount();
     m_interval = v.value;
-    m_startMillis = utils::CurrentTimeMillis();
-    m_isRunning = true;
+    arm();
 }
 
 void UeTimer::start(const nas::IEGprsTimer3 &v, bool clearExpiryCount)
@@ -74,8 +72,7 @@ void UeTimer::start(const nas::IEGprsTimer3 &v, bool clearExpiryCount)
         secs = val * 60 * 60 * 320;
 
     m_interval = secs;
-    m_startMillis = utils::CurrentTimeMillis();
-    m_isRunning = true;
+    arm();
 }
 
 void UeTimer::stop(bool clearExpiryCount)
@@ -87,26 +84,48 @@ void UeTimer::stop(bool clearExpiryCount)
     {
         m_startMillis = utils::CurrentTimeMillis();
         m_isRunning = false;
+
+        if (m_task)
+            m_task->cancelTimer(m_code);
+    }
+}
+
+void UeTimer::resume(int interval, int64_t endMillis)
+{
+    // Restarts a timer that was running in a previous run of the UE, the deadline may already be in the past
+    m_interval = interval;
+    m_startMillis = utils::CurrentTimeMillis();
+    m_endMillis = endMillis;
+    m_isRunning = true;
+
+    if (m_task)
+    {
+        m_task->cancelTimer(m_code);
+        m_task->setTimerAbsolute(m_code, m_endMillis);
+    }
+}
+
+void UeTimer::arm()
+{
+    m_startMillis = utils::CurrentTimeMillis();
+    m_endMillis = m_startMillis + static_cast<int64_t>(m_interval) * 1000LL;
+    m_isRunning = true;
+
+    // The previous deadline is dropped on a restart, so that at most one NTS timer is pending per UE timer
+    if (m_task)
+    {
+        m_task->cancelTimer(m_code);
+        m_task->setTimerAbsolute(m_code, m_endMillis);
     }
 }
 
 bool UeTimer::performTick()
 {
-    if (m_isRunning)
+    if (m_isRunning && utils::CurrentTimeMillis() >= m_endMillis)
     {
-        int64_t currentMs = utils::CurrentTimeMillis();
-        int64_t deltaSec = (currentMs - m_startMillis) / 1000LL;
-        int64_t remainingSec = m_interval - deltaSec;
-
-        if (currentMs - m_lastDebugPrintMs > 10LL * 1000LL)
-            m_lastDebugPrintMs = currentMs;
-
-        if (remainingSec <= 0LL)
-        {
-            stop(false);
-            m_expiryCount++;
-            return true;
-        }
+        stop(false);
+        m_expiryCount++;
+        return true;
     }
     return false;
 }
@@ -121,8 +140,13 @@ int UeTimer::getRemaining() const
     if (!m_isRunning)
         return 0;
 
-    int elapsed = static_cast<int>((utils::CurrentTimeMillis() - m_startMillis) / 1000LL);
-    return std::max(m_interval - elapsed, 0);
+    int64_t remaining = (m_endMillis - utils::CurrentTimeMillis() + 999LL) / 1000LL;
+    return static_cast<int>(std::max<int64_t>(remaining, 0));
+}
+
+int64_t UeTimer::getEndMillis() const
+{
+    return m_isRunning ? m_endMillis : 0;
 }
 
 void UeTimer::resetExpiryCount()
@@ -10,28 +10,35 @@
 
 #include <lib/nas/ie4.hpp>
 #include <utils/json.hpp>
+#include <utils/nts.hpp>
 
+/*
+ * If an owner task is given, the timer is event-driven: start() arms an NTS timer on the owner task with the timer
+ * code as NTS timer ID, and the owner calls performTick() when that NTS timer expires. stop() and restarts cancel the
+ * pending NTS timer, so the owner task is not woken up while the timer is not running.
+ */
 class UeTimer
 {
   private:
     const int m_code;
     const bool m_isMm;
+    NtsTask *const m_task;
 
     int m_interval;
     int64_t m_startMillis;
+    int64_t m_endMillis;
     bool m_isRunning;
     int m_expiryCount;
 
-    int64_t m_lastDebugPrintMs;
-
   public:
-    UeTimer(int timerCode, bool isMmTimer, int defaultInterval);
+    UeTimer(int timerCode, bool isMmTimer, int defaultInterval, NtsTask *task = nullptr);
 
   public:
     void start(bool clearExpiryCount = true);
     void start(const nas::IEGprsTimer2 &v, bool clearExpiryCount = true);
     void start(const nas::IEGprsTimer3 &v, bool clearExpiryCount = true);
     void stop(bool clearExpiryCount = true);
+    void resume(int interval, int64_t endMillis);
     void resetExpiryCount();
     bool performTick();
     [[nodiscard]] bool isRunning() const;
@@ -39,7 +46,11 @@ class UeTimer
     [[nodiscard]] bool isMmTimer() const;
     [[nodiscard]] int getInterval() const;
     [[nodiscard]] int getRemaining() const;
+    [[nodiscard]] int64_t getEndMillis() const;
     [[nodiscard]] int getExpiryCount() const;
+
+  private:
+    void arm();
 };
 
 Json ToJson(const UeTimer &v);
@@ -7,6 +7,7 @@
 //
 
 #include "config.hpp"
+#include "netlink.hpp"
 
 #include <arpa/inet.h>
 #include <array>
@@ -20,9 +21,11 @@
 #include <ifaddrs.h>
 #include <iostream>
 #include <linux/if_tun.h>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <net/if.h>
+#include <netinet/in.h>
 #include <set>
 #include <sstream>
 #include <string>
@@ -32,7 +35,6 @@
 #include <sys/stat.h>
 #include <sys/time.h>
 #include <sys/types.h>
-#include <sys/wait.h>
 #include <unistd.h>
 #include <vector>
 
@@ -40,46 +42,33 @@
 
 #define ROUTING_TABLE_PREFIX "rt_"
 #define MAX_INTERFACE_COUNT 1024
+#define RT_TABLES_FILE "/etc/iproute2/rt_tables"
 
-static std::mutex configMutex;
-
-static int ExecOutput(const char *cmd, std::string &output)
+struct TunRequest
 {
-    char buffer[128];
-    std::string result;
-    FILE *pipe = popen(cmd, "r");
-    if (!pipe)
-    {
-        output = "popen() failed!";
-        return -1;
-    }
-    try
-    {
-        while (fgets(buffer, sizeof buffer, pipe) != nullptr)
-            result += buffer;
-    }
-    catch (...)
-    {
-        pclose(pipe);
-        output = "";
-        return -1;
-    }
-    output = result;
+    const char *tunName;
+    const char *ipAddr;
+    int mtu;
+    bool configureRoute;
 
-    int status = pclose(pipe);
-    return WEXITSTATUS(status);
-}
+    int ifIndex{};
+    uint32_t address{};
+    uint32_t table{};
 
-static std::string ExecStrict(const std::string &cmd)
-{
-    std::string output;
-    if (ExecOutput(cmd.c_str(), output))
-    {
-        throw LibError("Command execution failed. The command was: " + cmd + ". The output is: '" + output +
-                       "Command execution failure");
-    }
-    return output;
-}
+    bool done{};
+    std::string error{};
+};
+
+static std::mutex configMutex;
+
+// Requests that wait for the configuration lock, whichever thread acquires the lock applies all of them at once
+static std::mutex pendingMutex;
+static std::vector<TunRequest *> pendingRequests;
+
+// Cached contents of the rt_tables file, guarded by the configuration lock
+static bool rtTablesLoaded = false;
+static std::map<std::string, uint32_t> rtTables;
+static std::set<uint32_t> usedTableIds;
 
 static const char *NextInterfaceName(const std::string &prefix)
 {
@@ -109,57 +98,31 @@ static const char *NextInterfaceName(const std::string &prefix)
     return nullptr;
 }
 
-static void TunSetIpAndUp(const char *ifName, const char *ipAddr, int mtu)
+static int ClassfulPrefixLength(uint32_t address)
 {
-    ifreq ifr{};
-    memset(&ifr, 0, sizeof(struct ifreq));
-
-    sockaddr_in sai{};
-    memset(&sai, 0, sizeof(struct sockaddr));
-
-    int sockFd;
-    char *p;
-
-    sockFd = socket(AF_INET, SOCK_DGRAM, 0);
-
-    strcpy(ifr.ifr_name, ifName);
-
-    sai.sin_family = AF_INET;
-    sai.sin_port = 0;
-
-    sai.sin_addr.s_addr = inet_addr(ipAddr);
-
-    p = (char *)&sai;
-    memcpy((((char *)&ifr + offsetof(struct ifreq, ifr_addr))), p, sizeof(struct sockaddr));
-
-    if (ioctl(sockFd, SIOCSIFADDR, &ifr) < 0)
-        throw LibError("ioctl(SIOCSIFADDR)", errno);
-    if (ioctl(sockFd, SIOCGIFFLAGS, &ifr) < 0)
-        throw LibError("ioctl(SIOCGIFFLAGS)", errno);
-
-    ifr.ifr_mtu = mtu;
-    if (ioctl(sockFd, SIOCSIFMTU, &ifr) < 0)
-        throw LibError("ioctl(SIOCSIFMTU)", errno);
-
-    ifr.ifr_flags |= IFF_UP | IFF_RUNNING;
-    if (ioctl(sockFd, SIOCSIFFLAGS, &ifr) < 0)
-        throw LibError("ioctl(SIOCSIFFLAGS)", errno);
-
-    close(sockFd);
+    // The prefix length is the one the kernel derives from the address class for SIOCSIFADDR, which was used before,
+    // so the resulting connected routes stay the same.
+    address = ntohl(address);
+    if (IN_CLASSA(address))
+        return 8;
+    if (IN_CLASSB(address))
+        return 16;
+    if (IN_CLASSC(address))
+        return 24;
+    return 32;
 }
 
-static void ConfigureRtTables(const std::string &table_name)
+static void LoadRtTables()
 {
     std::ifstream ifs;
-    ifs.open("/etc/iproute2/rt_tables");
+    ifs.open(RT_TABLES_FILE);
     if (!ifs.is_open() || !ifs.good())
-        throw LibError("Could not open '/etc/iproute2/rt_tables'");
-
-    std::string line;
+        throw LibError("Could not open '" RT_TABLES_FILE "'");
 
-    bool found = false;
-    std::set<int> nums;
+    rtTables.clear();
+    usedTableIds.clear();
 
+    std::string line;
     while (std::getline(ifs, line))
     {
         auto pos = line.find('#');
@@ -171,142 +134,129 @@ static void ConfigureRtTables(const std::string &table_name)
         std::stringstream ss;
         ss << line;
 
-        int num;
-        ss >> num >> line;
-
-        nums.insert(num);
+        uint32_t num;
+        std::string name;
+        if (!(ss >> num >> name))
+            continue;
 
-        if (line == table_name)
-            found = true;
+        usedTableIds.insert(num);
+        rtTables[name] = num;
     }
 
     ifs.close();
-
-    if (!found)
-    {
-        int availableId = 1000;
-        while (nums.count(availableId))
-            availableId++;
-
-        std::ofstream ofs;
-
-        ofs.open("/etc/iproute2/rt_tables", std::ios_base::app);
-        if (!ofs.is_open() || !ofs.good())
-            throw LibError("Could not open '/etc/iproute2/rt_tables'");
-
-        ofs << "\n" << availableId << "\t" << table_name << std::endl;
-        ofs.close();
-    }
+    rtTablesLoaded = true;
 }
 
-static void RemoveExistingIpRules(const std::string &ip_addr)
+static void AppendRtTables(const std::vector<std::string> &tableNames)
 {
-    std::string list_command = "ip rule list from " + ip_addr;
-    std::string output = ExecStrict(list_command);
-
-    std::stringstream ss;
-    ss << output;
-
-    std::vector<std::string> lines;
-    std::vector<std::string> will_remove;
-
-    std::string s;
-    while (std::getline(ss, s))
-        lines.push_back(s);
+    std::ofstream ofs;
+    ofs.open(RT_TABLES_FILE, std::ios_base::app);
+    if (!ofs.is_open() || !ofs.good())
+        throw LibError("Could not open '" RT_TABLES_FILE "'");
 
-    for (auto &line : lines)
+    uint32_t availableId = 1000;
+    for (auto &name : tableNames)
     {
-        int num = 0;
-        char from_ip[512] = {0};
-        char table_name[512] = {0};
-
-        if (sscanf(line.c_str(), "%d: from %s lookup %s", &num, from_ip, table_name) != 3)
-            throw LibError("ip rule list lookup command could not parsed");
+        while (usedTableIds.count(availableId))
+            availableId++;
 
-        if (!strcmp(from_ip, ip_addr.c_str()))
-        {
-            std::stringstream rule;
-            rule << "from " << from_ip << " lookup " << table_name;
-            will_remove.push_back(rule.str());
-        }
+        ofs << "\n" << availableId << "\t" << name;
+        usedTableIds.insert(availableId);
+        rtTables[name] = availableId;
     }
 
-    for (auto &line : will_remove)
-        ExecStrict("ip rule del " + line);
+    ofs << std::endl;
+    ofs.close();
 }
 
-static void AddNewIpRules(const std::string &ip_addr, const std::string &table_name)
+static uint32_t ResolveRtTable(const std::string &tableName)
 {
-    std::stringstream cmd;
-    cmd << "ip rule add from " << ip_addr << " table " << table_name;
-    ExecStrict(cmd.str());
+    if (rtTablesLoaded && rtTables.count(tableName))
+        return rtTables[tableName];
+
+    // The file is read again on a miss, since other UERANSIM processes may have added tables in the meantime
+    LoadRtTables();
+    if (!rtTables.count(tableName))
+        AppendRtTables({tableName});
+    return rtTables[tableName];
 }
 
-static bool IsFibTableExists(const std::string &table_name)
+static void ApplyRequests(const std::vector<TunRequest *> &requests)
 {
-    std::string output = ExecStrict("ip route show table all");
-
-    std::stringstream ss;
-    ss << output;
+    nr::ue::tun::NetlinkBatch batch{};
+    std::vector<std::pair<TunRequest *, const char *>> issued{};
 
-    std::string token;
-    while (ss >> token)
+    std::vector<TunRequest *> valid{};
+    for (auto *req : requests)
     {
-        if (token == "table")
+        try
         {
-            ss >> token;
-            if (token == table_name)
-                return true;
+            req->ifIndex = static_cast<int>(if_nametoindex(req->tunName));
+            if (req->ifIndex == 0)
+                throw LibError("TUN interface '" + std::string{req->tunName} + "' could not be found", errno);
+            if (inet_pton(AF_INET, req->ipAddr, &req->address) != 1)
+                throw LibError("Invalid IPv4 address '" + std::string{req->ipAddr} + "'");
+            if (req->configureRoute)
+                req->table = ResolveRtTable(ROUTING_TABLE_PREFIX + std::string(req->tunName));
+            valid.push_back(req);
+        }
+        catch (const LibError &e)
+        {
+            req->error = e.what();
         }
     }
 
-    return false;
-}
-
-static void RemoveExistingIpRoutes(const std::string &interface_name, const std::string &table_name)
-{
-    if (!IsFibTableExists(table_name))
-        return;
-
-    std::string list_command = "ip route list table " + table_name;
+    // Stale rules of the same source address are removed first. Usually there is none or a single one, a request is
+    // repeated as long as it removes a rule.
+    std::vector<TunRequest *> pendingRules{};
+    for (auto *req : valid)
+        if (req->configureRoute)
+            pendingRules.push_back(req);
 
-    std::string output = ExecStrict(list_command);
-
-    std::stringstream ss;
-    ss << output;
+    while (!pendingRules.empty())
+    {
+        for (auto *req : pendingRules)
+            batch.deleteRule(req->address);
 
-    std::vector<std::string> lines;
-    std::vector<std::string> will_remove;
+        auto results = batch.commit();
 
-    std::string s;
-    while (std::getline(ss, s))
-        lines.push_back(s);
+        std::vector<TunRequest *> next{};
+        for (size_t i = 0; i < results.size(); i++)
+        {
+            if (results[i] == 0)
+                next.push_back(pendingRules[i]);
+            else if (results[i] != ENOENT)
+                pendingRules[i]->error = std::string{"RTM_DELRULE failed: "} + strerror(results[i]);
+        }
+        pendingRules = std::move(next);
+    }
 
-    for (auto &line : lines)
+    for (auto *req : valid)
     {
-        char if_name[IF_NAMESIZE + 8] = {0};
+        if (!req->error.empty())
+            continue;
 
-        if (sscanf(line.c_str(), "default dev %s scope link", if_name) != 1)
-            throw LibError("ip route list command could not parsed");
+        batch.addAddress(req->ifIndex, req->address, ClassfulPrefixLength(req->address));
+        issued.emplace_back(req, "RTM_NEWADDR");
+        batch.setLinkUp(req->ifIndex, req->mtu);
+        issued.emplace_back(req, "RTM_NEWLINK");
 
-        if (!strcmp(if_name, interface_name.c_str()))
+        if (req->configureRoute)
         {
-            std::stringstream rule;
-            rule << "ip route del default dev " << interface_name << " table " << table_name;
-            will_remove.push_back(rule.str());
+            batch.addRule(req->address, req->table);
+            issued.emplace_back(req, "RTM_NEWRULE");
+            batch.replaceDefaultRoute(req->ifIndex, req->table);
+            issued.emplace_back(req, "RTM_NEWROUTE");
         }
     }
 
-    for (auto &line : will_remove)
-        ExecStrict(line);
-}
-
-static void AddIpRoutes(const std::string &if_name, const std::string &table_name)
-{
-    std::stringstream cmd;
-    cmd << "ip route add default dev " << if_name << " table " << table_name;
-
-    std::string output = ExecStrict(cmd.str());
+    auto results = batch.commit();
+    for (size_t i = 0; i < results.size(); i++)
+    {
+        auto *req = issued[i].first;
+        if (results[i] != 0 && req->error.empty())
+            req->error = std::string{issued[i].second} + " failed: " + strerror(results[i]);
+    }
 }
 
 namespace nr::ue::tun
@@ -352,20 +302,60 @@ int AllocateTun(const char *ifPrefix, char **allocatedName)
 
 void ConfigureTun(const char *tunName, const char *ipAddr, int mtu, bool configureRoute)
 {
+    TunRequest request{tunName, ipAddr, mtu, configureRoute};
+    {
+        const std::lock_guard<std::mutex> lock(pendingMutex);
+        pendingRequests.push_back(&request);
+    }
+
     // acquire the configuration lock
     const std::lock_guard<std::mutex> lock(configMutex);
 
-    TunSetIpAndUp(tunName, ipAddr, mtu);
-    if (configureRoute)
+    // The request may have been already applied together with others by the previous lock owner
+    if (!request.done)
     {
-        std::string table_name = ROUTING_TABLE_PREFIX + std::string(tunName);
+        std::vector<TunRequest *> requests{};
+        {
+            const std::lock_guard<std::mutex> pendingLock(pendingMutex);
+            std::swap(requests, pendingRequests);
+        }
+
+        try
+        {
+            ApplyRequests(requests);
+        }
+        catch (const LibError &e)
+        {
+            for (auto *req : requests)
+                if (req->error.empty())
+                    req->error = e.what();
+        }
 
-        ConfigureRtTables(table_name);
-        RemoveExistingIpRules(ipAddr);
-        AddNewIpRules(ipAddr, table_name);
-        RemoveExistingIpRoutes(tunName, table_name);
-        AddIpRoutes(tunName, table_name);
+        for (auto *req : requests)
+            req->done = true;
     }
+
+    if (!request.error.empty())
+        throw LibError(request.error);
+}
+
+void PrepareRoutingTables(const std::string &ifPrefix, int count)
+{
+    // acquire the configuration lock
+    const std::lock_guard<std::mutex> lock(configMutex);
+
+    LoadRtTables();
+
+    std::vector<std::string> missing{};
+    for (int i = 0; i < count && i < MAX_INTERFACE_COUNT; i++)
+    {
+        std::string tableName = ROUTING_TABLE_PREFIX + ifPrefix + std::to_string(i);
+        if (!rtTables.count(tableName))
+            missing.push_back(tableName);
+    }
+
+    if (!missing.empty())
+        AppendRtTables(missing);
 }
 
 } // namespace nr::ue::tun
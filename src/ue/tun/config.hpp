@@ -17,5 +17,6 @@ namespace nr::ue::tun
 
 int AllocateTun(const char *ifPrefix, char **allocatedName);
 void ConfigureTun(const char *tunName, const char *ipAddr, int mtu, bool configureRoute);
+void PrepareRoutingTables(const std::string &ifPrefix, int count);
 
 } // namespace nr::ue::tun
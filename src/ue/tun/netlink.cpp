@@ -0,0 +1,235 @@
+//
+// This file is a part of UERANSIM project.
+// Copyright (c) 2023 ALİ GÜNGÖR.
+//
+// https://github.com/aligungr/UERANSIM/
+// See README, LICENSE, and CONTRIBUTING files for licensing details.
+//
+
+#include "netlink.hpp"
+
+#include <cerrno>
+#include <cstring>
+
+#include <linux/fib_rules.h>
+#include <linux/if_addr.h>
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+#include <net/if.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <utils/libc_error.hpp>
+
+// Requests are sent in segments of at most this size so that the acknowledgements fit into the socket buffer
+#define MAX_SEGMENT_SIZE 32768
+#define RECEIVE_BUFFER_SIZE 65536
+
+static int g_netlinkFd = -1;
+static uint32_t g_sequence = 0;
+
+static int NetlinkSocket()
+{
+    if (g_netlinkFd >= 0)
+        return g_netlinkFd;
+
+    int fd = socket(AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC, NETLINK_ROUTE);
+    if (fd < 0)
+        throw LibError("Netlink socket could not be created:", errno);
+
+    sockaddr_nl local{};
+    local.nl_family = AF_NETLINK;
+    if (bind(fd, reinterpret_cast<sockaddr *>(&local), sizeof(local)) < 0)
+    {
+        int err = errno;
+        close(fd);
+        throw LibError("Netlink socket could not be bound:", err);
+    }
+
+    // Acknowledgements of failed requests need not to carry the request itself
+    int one = 1;
+    setsockopt(fd, SOL_NETLINK, NETLINK_CAP_ACK, &one, sizeof(one));
+
+    g_netlinkFd = fd;
+    return fd;
+}
+
+static void ReceiveAcks(int fd, uint32_t firstSeq, size_t count, std::vector<int> &results, size_t firstIndex)
+{
+    std::vector<uint8_t> buffer(RECEIVE_BUFFER_SIZE);
+    size_t remaining = count;
+
+    while (remaining > 0)
+    {
+        ssize_t n = recv(fd, buffer.data(), buffer.size(), 0);
+        if (n < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            throw LibError("Netlink acknowledgement could not be received:", errno);
+        }
+
+        int length = static_cast<int>(n);
+        for (auto *hdr = reinterpret_cast<nlmsghdr *>(buffer.data()); NLMSG_OK(hdr, length);
+             hdr = NLMSG_NEXT(hdr, length))
+        {
+            if (hdr->nlmsg_type != NLMSG_ERROR)
+                continue;
+
+            uint32_t offset = hdr->nlmsg_seq - firstSeq;
+            if (offset >= count)
+                continue;
+
+            auto *err = reinterpret_cast<nlmsgerr *>(NLMSG_DATA(hdr));
+            results[firstIndex + offset] = -err->error;
+            remaining--;
+        }
+    }
+}
+
+namespace nr::ue::tun
+{
+
+size_t NetlinkBatch::beginRequest(int type, int flags, const void *header, size_t headerLength)
+{
+    size_t offset = m_buffer.size();
+    m_buffer.resize(offset + NLMSG_HDRLEN + NLMSG_ALIGN(headerLength));
+
+    auto *hdr = reinterpret_cast<nlmsghdr *>(m_buffer.data() + offset);
+    hdr->nlmsg_len = static_cast<uint32_t>(m_buffer.size() - offset);
+    hdr->nlmsg_type = static_cast<uint16_t>(type);
+    hdr->nlmsg_flags = static_cast<uint16_t>(NLM_F_REQUEST | NLM_F_ACK | flags);
+    std::memcpy(m_buffer.data() + offset + NLMSG_HDRLEN, header, headerLength);
+
+    m_offsets.push_back(offset);
+    return m_offsets.size() - 1;
+}
+
+void NetlinkBatch::appendAttribute(int type, const void *data, size_t length)
+{
+    size_t offset = m_buffer.size();
+    m_buffer.resize(offset + RTA_SPACE(length));
+
+    auto *rta = reinterpret_cast<rtattr *>(m_buffer.data() + offset);
+    rta->rta_len = static_cast<uint16_t>(RTA_LENGTH(length));
+    rta->rta_type = static_cast<uint16_t>(type);
+    std::memcpy(RTA_DATA(rta), data, length);
+
+    auto *hdr = reinterpret_cast<nlmsghdr *>(m_buffer.data() + m_offsets.back());
+    hdr->nlmsg_len = static_cast<uint32_t>(m_buffer.size() - m_offsets.back());
+}
+
+size_t NetlinkBatch::addAddress(int ifIndex, uint32_t address, int prefixLength)
+{
+    ifaddrmsg ifa{};
+    ifa.ifa_family = AF_INET;
+    ifa.ifa_prefixlen = static_cast<uint8_t>(prefixLength);
+    ifa.ifa_scope = RT_SCOPE_UNIVERSE;
+    ifa.ifa_index = static_cast<uint32_t>(ifIndex);
+
+    size_t index = beginRequest(RTM_NEWADDR, NLM_F_CREATE | NLM_F_REPLACE, &ifa, sizeof(ifa));
+    appendAttribute(IFA_LOCAL, &address, sizeof(address));
+    appendAttribute(IFA_ADDRESS, &address, sizeof(address));
+    return index;
+}
+
+size_t NetlinkBatch::setLinkUp(int ifIndex, int mtu)
+{
+    ifinfomsg ifi{};
+    ifi.ifi_family = AF_UNSPEC;
+    ifi.ifi_index = ifIndex;
+    ifi.ifi_flags = IFF_UP;
+    ifi.ifi_change = IFF_UP;
+
+    auto mtuValue = static_cast<uint32_t>(mtu);
+
+    size_t index = beginRequest(RTM_NEWLINK, 0, &ifi, sizeof(ifi));
+    appendAttribute(IFLA_MTU, &mtuValue, sizeof(mtuValue));
+    return index;
+}
+
+size_t NetlinkBatch::addRule(uint32_t source, uint32_t table)
+{
+    fib_rule_hdr frh{};
+    frh.family = AF_INET;
+    frh.src_len = 32;
+    frh.table = static_cast<uint8_t>(table < 256 ? table : static_cast<uint32_t>(RT_TABLE_UNSPEC));
+    frh.action = FR_ACT_TO_TBL;
+
+    size_t index = beginRequest(RTM_NEWRULE, NLM_F_CREATE | NLM_F_EXCL, &frh, sizeof(frh));
+    appendAttribute(FRA_SRC, &source, sizeof(source));
+    appendAttribute(FRA_TABLE, &table, sizeof(table));
+    return index;
+}
+
+size_t NetlinkBatch::deleteRule(uint32_t source)
+{
+    // Neither the table nor the action is given, so that a rule from this source is removed regardless of its table
+    fib_rule_hdr frh{};
+    frh.family = AF_INET;
+    frh.src_len = 32;
+
+    size_t index = beginRequest(RTM_DELRULE, 0, &frh, sizeof(frh));
+    appendAttribute(FRA_SRC, &source, sizeof(source));
+    return index;
+}
+
+size_t NetlinkBatch::replaceDefaultRoute(int ifIndex, uint32_t table)
+{
+    rtmsg rtm{};
+    rtm.rtm_family = AF_INET;
+    rtm.rtm_table = static_cast<uint8_t>(table < 256 ? table : static_cast<uint32_t>(RT_TABLE_UNSPEC));
+    rtm.rtm_protocol = RTPROT_BOOT;
+    rtm.rtm_scope = RT_SCOPE_LINK;
+    rtm.rtm_type = RTN_UNICAST;
+
+    auto oif = static_cast<uint32_t>(ifIndex);
+
+    size_t index = beginRequest(RTM_NEWROUTE, NLM_F_CREATE | NLM_F_REPLACE, &rtm, sizeof(rtm));
+    appendAttribute(RTA_TABLE, &table, sizeof(table));
+    appendAttribute(RTA_OIF, &oif, sizeof(oif));
+    return index;
+}
+
+size_t NetlinkBatch::size() const
+{
+    return m_offsets.size();
+}
+
+std::vector<int> NetlinkBatch::commit()
+{
+    std::vector<int> results(m_offsets.size(), 0);
+    if (m_offsets.empty())
+        return results;
+
+    int fd = NetlinkSocket();
+
+    uint32_t firstSeq = g_sequence;
+    g_sequence += static_cast<uint32_t>(m_offsets.size());
+
+    for (size_t i = 0; i < m_offsets.size(); i++)
+        reinterpret_cast<nlmsghdr *>(m_buffer.data() + m_offsets[i])->nlmsg_seq = firstSeq + static_cast<uint32_t>(i);
+
+    size_t first = 0;
+    while (first < m_offsets.size())
+    {
+        size_t last = first + 1;
+        while (last < m_offsets.size() && m_offsets[last] - m_offsets[first] < MAX_SEGMENT_SIZE)
+            last++;
+
+        size_t begin = m_offsets[first];
+        size_t end = last < m_offsets.size() ? m_offsets[last] : m_buffer.size();
+
+        if (send(fd, m_buffer.data() + begin, end - begin, 0) < 0)
+            throw LibError("Netlink request could not be sent:", errno);
+
+        ReceiveAcks(fd, firstSeq + static_cast<uint32_t>(first), last - first, results, first);
+        first = last;
+    }
+
+    m_buffer.clear();
+    m_offsets.clear();
+    return results;
+}
+
+} // namespace nr::ue::tun
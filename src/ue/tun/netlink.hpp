@@ -0,0 +1,49 @@
+//
+// This file is a part of UERANSIM project.
+// Copyright (c) 2023 ALİ GÜNGÖR.
+//
+// https://github.com/aligungr/UERANSIM/
+// See README, LICENSE, and CONTRIBUTING files for licensing details.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace nr::ue::tun
+{
+
+/*
+ * A sequence of rtnetlink requests that are sent to the kernel together. Each request is acknowledged separately, so
+ * that a single failing request does not affect the others. IPv4 addresses are given in network byte order.
+ */
+class NetlinkBatch
+{
+  private:
+    std::vector<uint8_t> m_buffer;
+    std::vector<size_t> m_offsets;
+
+  public:
+    NetlinkBatch() = default;
+
+  public:
+    /* Each method returns the index of the request in the batch */
+    size_t addAddress(int ifIndex, uint32_t address, int prefixLength);
+    size_t setLinkUp(int ifIndex, int mtu);
+    size_t addRule(uint32_t source, uint32_t table);
+    size_t deleteRule(uint32_t source);
+    size_t replaceDefaultRoute(int ifIndex, uint32_t table);
+
+    [[nodiscard]] size_t size() const;
+
+    /* Sends the batch and returns the result of each request, 0 on success, errno otherwise */
+    std::vector<int> commit();
+
+  private:
+    size_t beginRequest(int type, int flags, const void *header, size_t headerLength);
+    void appendAttribute(int type, const void *data, size_t length);
+};
+
+} // namespace nr::ue::tun
@@ -9,6 +9,7 @@
 #include "task.hpp"
 #include <cstring>
 #include <ue/app/task.hpp>
+#include <ue/fast_path.hpp>
 #include <ue/nts.hpp>
 #include <unistd.h>
 #include <utils/libc_error.hpp>
@@ -22,6 +23,7 @@ struct ReceiverArgs
     int fd{};
     int psi{};
     NtsTask *targetTask{};
+    nr::ue::UserPlaneFastPath *fastPath{};
 };
 
 static std::string GetErrorMessage(const std::string &cause)
@@ -47,6 +49,7 @@ static void ReceiverThread(ReceiverArgs *args)
     int fd = args->fd;
     int psi = args->psi;
     NtsTask *targetTask = args->targetTask;
+    nr::ue::UserPlaneFastPath *fastPath = args->fastPath;
 
     delete args;
 
@@ -63,6 +66,9 @@ static void ReceiverThread(ReceiverArgs *args)
 
         if (n > 0)
         {
+            if (fastPath->sendUplink(psi, buffer, static_cast<size_t>(n)))
+                continue;
+
             auto m = std::make_unique<nr::ue::NmUeTunToApp>(nr::ue::NmUeTunToApp::DATA_PDU_DELIVERY);
             m->psi = psi;
             m->data = OctetString::FromArray(buffer, static_cast<size_t>(n));
@@ -84,6 +90,7 @@ void TunTask::onStart()
     receiverArgs->fd = m_fd;
     receiverArgs->targetTask = this;
     receiverArgs->psi = m_psi;
+    receiverArgs->fastPath = m_base->fastPath;
     m_receiver =
         new ScopedThread([](void *args) { ReceiverThread(reinterpret_cast<ReceiverArgs *>(args)); }, receiverArgs);
 }
@@ -47,4 +47,19 @@ bool TunConfigure(const std::string &tunName, const std::string &ipAddress, int
     return true;
 }
 
+bool TunPrepareRouting(const std::string &namePrefix, int count, std::string &error)
+{
+    try
+    {
+        tun::PrepareRoutingTables(namePrefix, count);
+    }
+    catch (const LibError &e)
+    {
+        error = e.what();
+        return false;
+    }
+
+    return true;
+}
+
 } // namespace nr::ue::tun
\ No newline at end of file
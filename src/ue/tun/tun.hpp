@@ -14,6 +14,7 @@ namespace nr::ue::tun
 {
 
 int TunAllocate(const char *namePrefix, std::string &allocatedName, std::string &error);
+bool TunPrepareRouting(const std::string &namePrefix, int count, std::string &error);
 bool TunConfigure(const std::string &tunName, const std::string &ipAddress, int mtu, bool configureRouting, std::string &error);
 
 } // namespace nr::ue::tun
\ No newline at end of file
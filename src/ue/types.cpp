@@ -12,12 +12,13 @@
 namespace nr::ue
 {
 
-NasTimers::NasTimers()
-    : t3346(3346, true, INT32_MAX), t3396(3396, false, INT32_MAX), t3444(3444, true, 12 * 60 * 60),
-      t3445(3445, true, 12 * 60 * 60), t3502(3502, true, 12 * 60), t3510(3510, true, 15), t3511(3511, true, 10),
-      t3512(3512, true, 54 * 60), t3516(3516, true, 30), t3517(3517, true, 15), t3519(3519, true, 60),
-      t3520(3520, true, 15), t3521(3521, true, 15), t3525(3525, true, 60), t3540(3540, true, 10),
-      t3584(3584, false, INT32_MAX), t3585(3585, false, INT32_MAX)
+NasTimers::NasTimers(NtsTask *task)
+    : t3346(3346, true, INT32_MAX, task), t3396(3396, false, INT32_MAX, task),
+      t3444(3444, true, 12 * 60 * 60, task), t3445(3445, true, 12 * 60 * 60, task), t3502(3502, true, 12 * 60, task),
+      t3510(3510, true, 15, task), t3511(3511, true, 10, task), t3512(3512, true, 54 * 60, task),
+      t3516(3516, true, 30, task), t3517(3517, true, 15, task), t3519(3519, true, 60, task),
+      t3520(3520, true, 15, task), t3521(3521, true, 15, task), t3525(3525, true, 60, task),
+      t3540(3540, true, 10, task), t3584(3584, false, INT32_MAX, task), t3585(3585, false, INT32_MAX, task)
 {
 }
 
@@ -23,10 +23,10 @@
 #include <lib/nas/nas.hpp>
 #include <utils/common_types.hpp>
 #include <utils/json.hpp>
-#include <utils/locked.hpp>
 #include <utils/logger.hpp>
 #include <utils/nts.hpp>
 #include <utils/octet_string.hpp>
+#include <utils/snapshot.hpp>
 
 namespace nr::ue
 {
@@ -36,27 +36,33 @@ class NasTask;
 class UeRrcTask;
 class UeRlsTask;
 class UserEquipment;
+class UeSnapshotFile;
+class UeSystemInfoCache;
+class UeMobilityTask;
+class UserPlaneFastPath;
+
+struct UeMibInfo
+{
+    bool isBarred = true;
+    bool isIntraFreqReselectAllowed = true;
+};
+
+struct UeSib1Info
+{
+    bool isReserved = false;
+    int64_t nci = 0;
+    int tac = 0;
+    Plmn plmn;
+    UacAiBarringSet aiBarringSet;
+};
 
 struct UeCellDesc
 {
     int dbm{};
 
-    struct
-    {
-        bool hasMib = false;
-        bool isBarred = true;
-        bool isIntraFreqReselectAllowed = true;
-    } mib{};
-
-    struct
-    {
-        bool hasSib1 = false;
-        bool isReserved = false;
-        int64_t nci = 0;
-        int tac = 0;
-        Plmn plmn;
-        UacAiBarringSet aiBarringSet;
-    } sib1{};
+    // Null until received. Immutable and shared with the other UEs of the process that receive the same broadcast.
+    std::shared_ptr<const UeMibInfo> mib{};
+    std::shared_ptr<const UeSib1Info> sib1{};
 };
 
 struct SupportedAlgs
@@ -89,6 +95,47 @@ struct IntegrityMaxDataRateConfig
     bool downlinkFull{};
 };
 
+enum class EMobilityModel
+{
+    STATIC,
+    RANDOM_WAYPOINT,
+    HIGHWAY,
+    TRACE,
+};
+
+struct MobilityCell
+{
+    std::string address{};
+    Vector3 position{};
+};
+
+/* Simulated movement of the UEs of the process, positions are in meters */
+struct MobilityConfig
+{
+    EMobilityModel model{};
+    int updatePeriod = 100; // ms
+
+    // The UEs are placed and moved within this rectangle, except for the trace model
+    int minX{};
+    int maxX{};
+    int minY{};
+    int maxY{};
+
+    double minSpeed = 1.0; // m/s
+    double maxSpeed = 1.0; // m/s
+    int pause{};           // ms, RANDOM_WAYPOINT only
+    int lanes = 1;         // HIGHWAY only, lanes are along the x-axis starting from minY
+    int laneSpacing = 5;   // HIGHWAY only
+    std::string traceFile{};
+    std::optional<uint32_t> seed{}; // Same seed gives the same placement and motion, otherwise a random one is used
+
+    // Positions of the gNB search list entries, so that only the cells within the range are searched by the UEs.
+    // The range should be where the path loss of the gNBs falls below the minimum signal strength. 0 searches all.
+    // They must be the same as the positions in the gNB configurations, which are checked once the gNBs respond.
+    std::vector<MobilityCell> cells{};
+    int cellRange{};
+};
+
 struct UeConfig
 {
     /* Read from config file */
@@ -114,6 +161,7 @@ struct UeConfig
     std::string caCertificate{};
     std::string clientCertificate{};
     std::string clientPrivateKey{};
+    std::optional<MobilityConfig> mobility{};
 
     struct
     {
@@ -131,9 +179,22 @@ struct UeConfig
         bool cls15{};
     } uacAcc;
 
+    /* Periods (ms) of the safety-net state machine cycles, 0 disables. State changes are event-driven regardless. */
+    struct
+    {
+        int mm = 10'000;
+        int rrc = 10'000;
+    } safetyCycle;
+
     /* Assigned by program */
     bool configureRouting{};
     bool prefixLogger{};
+    UeSnapshotFile *snapshotFile{};
+    UeSystemInfoCache *siCache{};
+    UeMobilityTask *mobilityTask{};
+    int mobilitySlot{};
+    int snapshotSlot{};
+    int hibernateDelay{}; // ms, 0 disables
 
     [[nodiscard]] std::string getNodeName() const
     {
@@ -179,15 +240,25 @@ struct ActiveCellInfo
     [[nodiscard]] bool hasValue() const;
 };
 
+/* UAC related system information of the current cell, published by RRC for the access checks in NAS */
+struct UacBarringInfo
+{
+    // Also set if there is no current cell, or its MIB or SIB1 is not received yet
+    bool isBarred = true;
+    UacAiBarringSet aiBarringSet{};
+};
+
 struct UeSharedContext
 {
-    Locked<std::unordered_set<Plmn>> availablePlmns;
-    Locked<Plmn> selectedPlmn;
-    Locked<ActiveCellInfo> currentCell;
-    Locked<std::vector<Tai>> forbiddenTaiRoaming;
-    Locked<std::vector<Tai>> forbiddenTaiRps;
-    Locked<std::optional<GutiMobileIdentity>> providedGuti;
-    Locked<std::optional<GutiMobileIdentity>> providedTmsi;
+    Snapshot<std::unordered_set<Plmn>> availablePlmns;
+    Snapshot<Plmn> selectedPlmn;
+    Snapshot<ActiveCellInfo> currentCell;
+    Snapshot<UacBarringInfo> uacBarring;
+    Snapshot<std::vector<Tai>> forbiddenTaiRoaming;
+    Snapshot<std::vector<Tai>> forbiddenTaiRps;
+    Snapshot<std::optional<GutiMobileIdentity>> providedGuti;
+    Snapshot<std::optional<GutiMobileIdentity>> providedTmsi;
+    Snapshot<std::optional<GutiMobileIdentity>> pagingTmsi; // 5G-S-TMSI part of the stored 5G-GUTI, if any
 
     Plmn getCurrentPlmn();
     Tai getCurrentTai();
@@ -199,6 +270,8 @@ struct RlsSharedContext
     std::atomic<uint64_t> sti{};
 };
 
+struct UeHibernatedState;
+
 struct TaskBase
 {
     UserEquipment *ue{};
@@ -209,11 +282,17 @@ struct TaskBase
     NtsTask *cliCallbackTask{};
 
     UeSharedContext shCtx{};
+    UserPlaneFastPath *fastPath{};
 
     UeAppTask *appTask{};
     NasTask *nasTask{};
     UeRrcTask *rrcTask{};
     UeRlsTask *rlsTask{};
+
+    // Set before the tasks are stopped for hibernation, the NAS task leaves its state in hibernatedState upon quit.
+    // Upon waking up, hibernatedState is given to the NAS task to resume from.
+    bool isHibernating{};
+    std::unique_ptr<UeHibernatedState> hibernatedState{};
 };
 
 struct RrcTimers
@@ -246,7 +325,7 @@ struct NasTimers
     UeTimer t3584; /* SM - ... */
     UeTimer t3585; /* SM - ... */
 
-    NasTimers();
+    explicit NasTimers(NtsTask *task);
 };
 
 enum class ERmState
@@ -610,13 +689,6 @@ struct ProcControl
     std::optional<EDeregCause> deregistration{};
 };
 
-struct UacInput
-{
-    std::bitset<16> identities;
-    int category{};
-    int establishmentCause{};
-};
-
 enum class EUacResult
 {
     ALLOWED,
@@ -624,11 +696,6 @@ enum class EUacResult
     BARRING_APPLICABLE_EXCEPT_0_2,
 };
 
-struct UacOutput
-{
-    EUacResult res{};
-};
-
 enum class ENasTransportHint
 {
     PDU_SESSION_ESTABLISHMENT_REQUEST,
@@ -653,6 +720,19 @@ enum class ENasTransportHint
     FIVEG_SM_STATUS
 };
 
+/* Everything that is kept for a hibernated UE, apart from its config */
+struct UeHibernatedState
+{
+    OctetString record{};     // NAS snapshot record
+    int64_t wakeTime{};       // Expiry of T3512, 0 if not running
+    int t3512Interval{};      // Seconds
+    bool isIdle{};            // False if the UE left the idle state before its tasks were stopped
+    EMmSubState mmSubState{}; // When the tasks were stopped
+
+    // 5G-S-TMSI part of the stored 5G-GUTI, the controller wakes the UE up when it is paged with it
+    std::optional<GutiMobileIdentity> pagingTmsi{};
+};
+
 Json ToJson(const ECmState &state);
 Json ToJson(const ERmState &state);
 Json ToJson(const EMmState &state);
@@ -8,16 +8,34 @@
 
 #include "ue.hpp"
 
+#include "fast_path.hpp"
+#include "app/cmd_handler.hpp"
 #include "app/task.hpp"
 #include "nas/task.hpp"
+#include "nts.hpp"
 #include "rls/task.hpp"
 #include "rrc/task.hpp"
 
+#include <lib/app/cli_base.hpp>
+
 namespace nr::ue
 {
 
 UserEquipment::UserEquipment(UeConfig *config, app::IUeController *ueController, app::INodeListener *nodeListener,
                              NtsTask *cliCallbackTask)
+    : config{config}, ueController{ueController}, nodeListener{nodeListener}, cliCallbackTask{cliCallbackTask},
+      mutex{}, taskBase{}, hibernatedState{}
+{
+    createTasks();
+}
+
+UserEquipment::~UserEquipment()
+{
+    if (taskBase)
+        destroyTasks();
+}
+
+void UserEquipment::createTasks()
 {
     auto *base = new TaskBase();
     base->ue = this;
@@ -26,6 +44,7 @@ UserEquipment::UserEquipment(UeConfig *config, app::IUeController *ueController,
     base->ueController = ueController;
     base->nodeListener = nodeListener;
     base->cliCallbackTask = cliCallbackTask;
+    base->fastPath = new UserPlaneFastPath();
 
     base->nasTask = new NasTask(base);
     base->rrcTask = new UeRrcTask(base);
@@ -35,25 +54,33 @@ UserEquipment::UserEquipment(UeConfig *config, app::IUeController *ueController,
     taskBase = base;
 }
 
-UserEquipment::~UserEquipment()
+void UserEquipment::destroyTasks()
 {
-    taskBase->nasTask->quit();
-    taskBase->rrcTask->quit();
+    // The radio side is stopped first, so that the NAS state is not changed further while the tasks are stopping
     taskBase->rlsTask->quit();
+    taskBase->rrcTask->quit();
     taskBase->appTask->quit();
+    taskBase->nasTask->quit();
+
+    // Left by the NAS task upon quit, if hibernating
+    hibernatedState = std::move(taskBase->hibernatedState);
 
     delete taskBase->nasTask;
     delete taskBase->rrcTask;
     delete taskBase->rlsTask;
     delete taskBase->appTask;
 
+    delete taskBase->fastPath;
     delete taskBase->logBase;
 
     delete taskBase;
+    taskBase = nullptr;
 }
 
 void UserEquipment::start()
 {
+    std::lock_guard lk(mutex);
+
     taskBase->nasTask->start();
     taskBase->rrcTask->start();
     taskBase->rlsTask->start();
@@ -62,7 +89,81 @@ void UserEquipment::start()
 
 void UserEquipment::pushCommand(std::unique_ptr<app::UeCliCommand> cmd, const InetAddress &address)
 {
-    taskBase->appTask->push(std::make_unique<NmUeCliCommand>(std::move(cmd), address));
+    {
+        std::lock_guard lk(mutex);
+        std::string output{};
+        if (taskBase == nullptr && hibernatedState && HandleHibernatedCmd(*config, *hibernatedState, *cmd, output))
+        {
+            cliCallbackTask->push(std::make_unique<app::NwCliSendResponse>(address, output, false, getNodeName()));
+            return;
+        }
+    }
+
+    wakeUp();
+
+    std::lock_guard lk(mutex);
+    if (taskBase)
+        taskBase->appTask->push(std::make_unique<NmUeCliCommand>(std::move(cmd), address));
+}
+
+std::string UserEquipment::getNodeName() const
+{
+    return config->getNodeName();
+}
+
+int64_t UserEquipment::hibernate()
+{
+    std::lock_guard lk(mutex);
+    if (taskBase == nullptr)
+        return 0;
+
+    taskBase->isHibernating = true;
+    destroyTasks();
+
+    return hibernatedState ? hibernatedState->wakeTime : 0;
+}
+
+void UserEquipment::wakeUp()
+{
+    std::lock_guard lk(mutex);
+    if (taskBase != nullptr)
+        return;
+
+    createTasks();
+    taskBase->hibernatedState = std::move(hibernatedState);
+
+    taskBase->nasTask->start();
+    taskBase->rrcTask->start();
+    taskBase->rlsTask->start();
+    taskBase->appTask->start();
+}
+
+int64_t UserEquipment::wakeTime()
+{
+    std::lock_guard lk(mutex);
+    return taskBase == nullptr && hibernatedState ? hibernatedState->wakeTime : 0;
+}
+
+std::optional<GutiMobileIdentity> UserEquipment::pagingTmsi()
+{
+    std::lock_guard lk(mutex);
+    if (taskBase != nullptr || hibernatedState == nullptr)
+        return std::nullopt;
+    return hibernatedState->pagingTmsi;
+}
+
+void UserEquipment::page(std::vector<GutiMobileIdentity> tmsiIds)
+{
+    wakeUp();
+
+    // The paging occasion has passed by the time the UE is woken up, so the paging is given to the NAS directly
+    std::lock_guard lk(mutex);
+    if (taskBase == nullptr)
+        return;
+
+    auto w = std::make_unique<NmUeRrcToNas>(NmUeRrcToNas::PAGING);
+    w->pagingTmsi = std::move(tmsiIds);
+    taskBase->nasTask->push(std::move(w));
 }
 
 } // namespace nr::ue
@@ -11,16 +11,31 @@
 #include "types.hpp"
 #include <lib/app/cli_cmd.hpp>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
 #include <utils/network.hpp>
 #include <utils/nts.hpp>
 
 namespace nr::ue
 {
 
+/*
+ * A UE is either active, running its tasks on their own threads, or hibernated. A hibernated UE keeps nothing but its
+ * config and NAS state record. It is woken up by the controller when its periodic registration is due or when it is
+ * paged, or upon a CLI command that cannot be answered from the hibernated state.
+ */
 class UserEquipment
 {
   private:
+    UeConfig *config;
+    app::IUeController *ueController;
+    app::INodeListener *nodeListener;
+    NtsTask *cliCallbackTask;
+
+    std::mutex mutex;
     TaskBase *taskBase;
+    std::unique_ptr<UeHibernatedState> hibernatedState;
 
   public:
     UserEquipment(UeConfig *config, app::IUeController *ueController, app::INodeListener *nodeListener,
@@ -30,6 +45,21 @@ class UserEquipment
   public:
     void start();
     void pushCommand(std::unique_ptr<app::UeCliCommand> cmd, const InetAddress &address);
+    [[nodiscard]] std::string getNodeName() const;
+
+    /* Must not be called from the tasks of the UE itself. Returns the time to wake up at, 0 if not scheduled. */
+    int64_t hibernate();
+    void wakeUp();
+    [[nodiscard]] int64_t wakeTime();
+
+    /* 5G-S-TMSI to page the UE with while it is hibernated */
+    [[nodiscard]] std::optional<GutiMobileIdentity> pagingTmsi();
+    /* Wakes the UE up if needed and delivers the paging to it */
+    void page(std::vector<GutiMobileIdentity> tmsiIds);
+
+  private:
+    void createTasks();
+    void destroyTasks();
 };
 
-} // namespace nr::ue
\ No newline at end of file
+} // namespace nr::ue
@@ -156,6 +156,14 @@ int64_t utils::CurrentTimeMillis()
     return now;
 }
 
+int64_t utils::CurrentTimeMicros()
+{
+    auto time = std::chrono::system_clock::now();
+    auto sinceEpoch = time.time_since_epoch();
+    auto micros = std::chrono::duration_cast<std::chrono::microseconds>(sinceEpoch);
+    return micros.count();
+}
+
 TimeStamp utils::CurrentTimeStamp()
 {
     int64_t tms = CurrentTimeMillis();
@@ -187,20 +195,17 @@ OctetString utils::IpToOctetString(const std::string &address)
         std::stringstream ss(address);
         ss >> bytes[0] >> dot >> bytes[1] >> dot >> bytes[2] >> dot >> bytes[3] >> dot;
 
-        std::vector<uint8_t> data(4);
-        data[0] = bytes[0];
-        data[1] = bytes[1];
-        data[2] = bytes[2];
-        data[3] = bytes[3];
-
-        return OctetString(std::move(data));
+        OctetString data;
+        for (int byte : bytes)
+            data.appendOctet(byte);
+        return data;
     }
     else if (ipVersion == 6)
     {
-        std::vector<uint8_t> data(16);
+        OctetString data = OctetString::FromSpare(16);
         if (!IPv6FromString(address.c_str(), data.data()))
             return {};
-        return OctetString(std::move(data));
+        return data;
     }
     else
         return {};
@@ -11,6 +11,8 @@
 #include <sstream>
 #include <utility>
 
+static constexpr const size_t KEY_INDEX_THRESHOLD = 32;
+
 static std::string EscapeJson(const std::string &str)
 {
     std::string output;
@@ -161,6 +163,25 @@ Json::Json() : m_type{Type::NULL_TYPE}
 {
 }
 
+Json::Json(const Json &other)
+    : m_type{other.m_type}, m_strVal{other.m_strVal}, m_intVal{other.m_intVal}, m_children{other.m_children},
+      m_keyIndex{}
+{
+}
+
+Json &Json::operator=(const Json &other)
+{
+    if (this != &other)
+    {
+        m_type = other.m_type;
+        m_strVal = other.m_strVal;
+        m_intVal = other.m_intVal;
+        m_children = other.m_children;
+        m_keyIndex = nullptr;
+    }
+    return *this;
+}
+
 Json::Json(std::nullptr_t) : m_type{Type::NULL_TYPE}
 {
 }
@@ -206,6 +227,17 @@ Json::Type Json::type() const
     return m_type;
 }
 
+bool Json::operator==(const Json &other) const
+{
+    return m_type == other.m_type && m_intVal == other.m_intVal && m_strVal == other.m_strVal &&
+           m_children == other.m_children;
+}
+
+bool Json::operator!=(const Json &other) const
+{
+    return !(*this == other);
+}
+
 bool Json::isString() const
 {
     return m_type == Type::STRING;
@@ -350,18 +382,68 @@ void Json::put(std::string key, Json value)
         return;
 
     // Replace if the key is already present
-    for (auto &item : m_children)
+    if (m_children.size() < KEY_INDEX_THRESHOLD)
     {
-        if (item.first == key)
+        for (auto &item : m_children)
         {
-            item.second = std::move(value);
-            return;
+            if (item.first == key)
+            {
+                item.second = std::move(value);
+                return;
+            }
         }
+
+        m_children.emplace_back(std::move(key), std::move(value));
+        return;
     }
 
+    if (m_keyIndex == nullptr)
+    {
+        m_keyIndex = std::make_unique<std::unordered_map<std::string, size_t>>();
+        m_keyIndex->reserve(m_children.size() * 2);
+        for (size_t i = 0; i < m_children.size(); i++)
+            m_keyIndex->emplace(m_children[i].first, i);
+    }
+
+    auto it = m_keyIndex->find(key);
+    if (it != m_keyIndex->end())
+    {
+        m_children[it->second].second = std::move(value);
+        return;
+    }
+
+    m_keyIndex->emplace(key, m_children.size());
     m_children.emplace_back(std::move(key), std::move(value));
 }
 
+void YamlSequenceWriter::beginItem()
+{
+    if (m_hasItem)
+        m_output += "\n";
+    m_output += "- ";
+
+    m_hasItem = true;
+    m_hasField = false;
+}
+
+void YamlSequenceWriter::field(const std::string &key, const Json &value)
+{
+    if (m_hasField)
+        m_output += "\n  ";
+    m_output += key;
+    m_output += ": ";
+    m_output += value.isNull() ? "null" : value.str();
+
+    m_hasField = true;
+}
+
+std::string YamlSequenceWriter::take()
+{
+    m_hasItem = false;
+    m_hasField = false;
+    return std::move(m_output);
+}
+
 Json ToJson(std::nullptr_t)
 {
     return nullptr;
@@ -13,6 +13,7 @@
 #include <memory>
 #include <optional>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -35,18 +36,28 @@ class Json
     int64_t m_intVal{};
 
     // - Holding children via vector instead of map/unordered_map (because insertion order is needed to be preserved).
-    //   Therefore add/remove operation is O(n), but performance is not a concern for JSONs. (Add operation is also
-    //   O(n) since we compare to check the key is already present)
+    //   Therefore remove operation is O(n). Add operation checks whether the key is already present, which is a linear
+    //   search for small objects and a lookup in m_keyIndex for the large ones.
     // - NOTE: We're using Json type itself here which is incomplete herein. But C++17 allows std::vector, std::list,
     //   and std::forward_list to have incomplete types. For older versions we would need pointer etc.
     std::vector<std::pair<std::string, Json>> m_children{};
 
+    // Positions of the keys in m_children, built by put() once the object is large. It is not copied along with the
+    // object, but rebuilt by the next put() of the copy.
+    std::unique_ptr<std::unordered_map<std::string, size_t>> m_keyIndex{};
+
   private:
     typedef decltype(m_children.begin()) iterator;
     typedef decltype(const_cast<const std::vector<std::pair<std::string, Json>> &>(m_children).begin()) const_iterator;
 
   public:
     Json();
+    Json(const Json &other);
+    Json(Json &&other) noexcept = default;
+    Json &operator=(const Json &other);
+    Json &operator=(Json &&other) noexcept = default;
+    ~Json() = default;
+
     /* no-explicit */ Json(std::nullptr_t v);
     /* no-explicit */ Json(std::string str);
     /* no-explicit */ Json(bool v);
@@ -84,6 +95,10 @@ class Json
     [[nodiscard]] bool isPrimitive() const;
     [[nodiscard]] int itemCount() const;
 
+  public:
+    bool operator==(const Json &other) const;
+    bool operator!=(const Json &other) const;
+
   public:
     [[nodiscard]] std::string str() const;
     [[nodiscard]] int int32() const;
@@ -105,6 +120,25 @@ class Json
     [[nodiscard]] std::string dumpYaml() const;
 };
 
+/*
+ * Writes a YAML sequence of flat objects directly into a string, in the same format as Json::dumpYaml() does. No
+ * intermediate Json tree is built, therefore large tables (e.g. UE contexts of a gNB) are serialized in linear time.
+ */
+class YamlSequenceWriter
+{
+  private:
+    std::string m_output{};
+    bool m_hasItem{};
+    bool m_hasField{};
+
+  public:
+    void beginItem();
+    // The value must be primitive
+    void field(const std::string &key, const Json &value);
+
+    [[nodiscard]] std::string take();
+};
+
 Json ToJson(std::nullptr_t);
 Json ToJson(bool v);
 Json ToJson(const std::string &v);
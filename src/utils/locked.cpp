@@ -1,9 +0,0 @@
-//
-// This file is a part of UERANSIM project.
-// Copyright (c) 2023 ALİ GÜNGÖR.
-//
-// https://github.com/aligungr/UERANSIM/
-// See README, LICENSE, and CONTRIBUTING files for licensing details.
-//
-
-#include "locked.hpp"
\ No newline at end of file
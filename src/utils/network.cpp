@@ -9,16 +9,32 @@
 #include "network.hpp"
 #include "libc_error.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <cstring>
 
 #include <arpa/inet.h>
 #include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/udp.h>
+#include <poll.h>
 #include <random>
 #include <stdexcept>
 #include <sys/socket.h>
 #include <sys/types.h>
 #include <unistd.h>
 
+// Not defined by older C libraries, see linux/udp.h
+#ifndef UDP_SEGMENT
+#define UDP_SEGMENT 103
+#endif
+#ifndef UDP_GRO
+#define UDP_GRO 104
+#endif
+
+// Time to wait for the socket buffer before a segmented send falls back to sending the datagrams one by one
+static constexpr const int SEGMENTED_SEND_TIMEOUT = 10;
+
 static std::string OctetStringToIpString(const OctetString &address)
 {
     if (address.length() != 4 && address.length() != 16 && address.length() != 20)
@@ -112,6 +128,35 @@ uint16_t InetAddress::getPort() const
     return 0;
 }
 
+std::string InetAddress::toString() const
+{
+    char str[INET6_ADDRSTRLEN] = {0};
+
+    if (storage.ss_family == AF_INET)
+    {
+        auto &sin = reinterpret_cast<const sockaddr_in &>(storage);
+        inet_ntop(AF_INET, &sin.sin_addr, str, sizeof(str));
+        return std::string{str} + ":" + std::to_string(getPort());
+    }
+    if (storage.ss_family == AF_INET6)
+    {
+        auto &sin6 = reinterpret_cast<const sockaddr_in6 &>(storage);
+        inet_ntop(AF_INET6, &sin6.sin6_addr, str, sizeof(str));
+        return "[" + std::string{str} + "]:" + std::to_string(getPort());
+    }
+    return "";
+}
+
+bool InetAddress::operator==(const InetAddress &other) const
+{
+    return len == other.len && std::memcmp(&storage, &other.storage, len) == 0;
+}
+
+bool InetAddress::operator!=(const InetAddress &other) const
+{
+    return !(*this == other);
+}
+
 Socket::Socket(int domain, int type, int protocol)
 {
     int sd = socket(domain, type, protocol);
@@ -119,6 +164,7 @@ Socket::Socket(int domain, int type, int protocol)
         throw LibError("Socket could not be created:", errno);
     this->fd = sd;
     this->domain = domain;
+    this->segmentationUnsupported = std::make_shared<std::atomic<bool>>(false);
 }
 
 Socket Socket::CreateUdp4()
@@ -131,7 +177,7 @@ Socket Socket::CreateUdp6()
     return {AF_INET6, SOCK_DGRAM, IPPROTO_UDP};
 }
 
-Socket::Socket() : fd(-1), domain(0)
+Socket::Socket() : fd(-1), domain(0), segmentationUnsupported{}
 {
 }
 
@@ -143,6 +189,13 @@ void Socket::bind(const InetAddress &address) const
 }
 
 int Socket::receive(uint8_t *buffer, size_t bufferSize, int timeoutMs, InetAddress &outAddress) const
+{
+    size_t segmentSize = 0;
+    return receive(buffer, bufferSize, timeoutMs, outAddress, segmentSize);
+}
+
+int Socket::receive(uint8_t *buffer, size_t bufferSize, int timeoutMs, InetAddress &outAddress,
+                    size_t &outSegmentSize) const
 {
     fd_set s1;
     FD_ZERO(&s1);
@@ -167,13 +220,35 @@ int Socket::receive(uint8_t *buffer, size_t bufferSize, int timeoutMs, InetAddre
     if (rc > 0 && FD_ISSET(fd, &s1))
     {
         sockaddr_storage peerAddr{};
-        socklen_t peerAddrLen = sizeof(struct sockaddr_storage);
 
-        auto r = recvfrom(fd, buffer, bufferSize, 0, (struct sockaddr *)&peerAddr, &peerAddrLen);
-        if (r == -1)
-            throw LibError("recvfrom recv failed: ", errno);
+        iovec iov{buffer, bufferSize};
+        alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int))];
+
+        msghdr msg{};
+        msg.msg_name = &peerAddr;
+        msg.msg_namelen = sizeof(struct sockaddr_storage);
+        msg.msg_iov = &iov;
+        msg.msg_iovlen = 1;
+        msg.msg_control = control;
+        msg.msg_controllen = sizeof(control);
 
-        outAddress = InetAddress{peerAddr, peerAddrLen};
+        auto r = recvmsg(fd, &msg, 0);
+        if (r == -1)
+            throw LibError("recvmsg recv failed: ", errno);
+
+        // With receive offload, the datagrams of a flow may be coalesced and the size of each is given separately
+        outSegmentSize = 0;
+        for (auto *cmsg = CMSG_FIRSTHDR(&msg); cmsg != nullptr; cmsg = CMSG_NXTHDR(&msg, cmsg))
+        {
+            if (cmsg->cmsg_level == SOL_UDP && cmsg->cmsg_type == UDP_GRO)
+            {
+                int segmentSize;
+                std::memcpy(&segmentSize, CMSG_DATA(cmsg), sizeof(segmentSize));
+                outSegmentSize = static_cast<size_t>(segmentSize);
+            }
+        }
+
+        outAddress = InetAddress{peerAddr, msg.msg_namelen};
         return static_cast<int>(r);
     }
 
@@ -191,6 +266,53 @@ void Socket::send(const InetAddress &address, const uint8_t *buffer, size_t size
     }
 }
 
+void Socket::sendSegments(const InetAddress &address, const uint8_t *buffer, size_t size, size_t segmentSize) const
+{
+    if (size > segmentSize && segmentationUnsupported && !*segmentationUnsupported)
+    {
+        iovec iov{const_cast<uint8_t *>(buffer), size};
+        alignas(cmsghdr) char control[CMSG_SPACE(sizeof(uint16_t))] = {};
+
+        msghdr msg{};
+        msg.msg_name = const_cast<sockaddr *>(address.getSockAddr());
+        msg.msg_namelen = address.getSockLen();
+        msg.msg_iov = &iov;
+        msg.msg_iovlen = 1;
+        msg.msg_control = control;
+        msg.msg_controllen = sizeof(control);
+
+        auto *cmsg = CMSG_FIRSTHDR(&msg);
+        cmsg->cmsg_level = SOL_UDP;
+        cmsg->cmsg_type = UDP_SEGMENT;
+        cmsg->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+        auto segment = static_cast<uint16_t>(segmentSize);
+        std::memcpy(CMSG_DATA(cmsg), &segment, sizeof(segment));
+
+        if (sendmsg(fd, &msg, MSG_DONTWAIT) != -1)
+            return;
+
+        int err = errno;
+        if (err == EAGAIN)
+        {
+            // The whole batch is a single send, so it is retried once there is room instead of being dropped
+            pollfd pfd{fd, POLLOUT, 0};
+            if (poll(&pfd, 1, SEGMENTED_SEND_TIMEOUT) > 0 && sendmsg(fd, &msg, MSG_DONTWAIT) != -1)
+                return;
+            err = errno;
+        }
+
+        // EIO: the device cannot offload the checksums, ENOPROTOOPT/EOPNOTSUPP: the kernel has no UDP_SEGMENT.
+        // Other errors, such as EINVAL for a batch the kernel does not accept, only affect this batch.
+        if (err == EIO || err == ENOPROTOOPT || err == EOPNOTSUPP)
+            *segmentationUnsupported = true;
+        else if (err != EAGAIN && err != EINVAL)
+            throw LibError("sendmsg failed: ", err);
+    }
+
+    for (size_t offset = 0; offset < size; offset += segmentSize)
+        send(address, buffer + offset, std::min(segmentSize, size - offset));
+}
+
 bool Socket::hasFd() const
 {
     return fd >= 0;
@@ -284,6 +406,18 @@ void Socket::setReuseAddress() const
         throw LibError("setsockopt SO_REUSEADDR failed: ", errno);
 }
 
+void Socket::setReceiveBufferSize(int size) const
+{
+    if (setsockopt(fd, SOL_SOCKET, SO_RCVBUF, (const char *)&size, sizeof(size)) < 0)
+        throw LibError("setsockopt SO_RCVBUF failed: ", errno);
+}
+
+bool Socket::setReceiveOffload() const
+{
+    int enable = 1;
+    return setsockopt(fd, SOL_UDP, UDP_GRO, &enable, sizeof(enable)) == 0;
+}
+
 InetAddress Socket::getAddress() const
 {
     struct sockaddr_storage storage = {};
@@ -10,7 +10,9 @@
 
 #include "octet_string.hpp"
 
+#include <atomic>
 #include <cstdint>
+#include <memory>
 #include <string>
 
 #include <sys/socket.h>
@@ -40,6 +42,12 @@ struct InetAddress
 
     [[nodiscard]] int getIpVersion() const;
     [[nodiscard]] uint16_t getPort() const;
+
+    /* Address and port, e.g. "127.0.0.1:4997" or "[::1]:4997" */
+    [[nodiscard]] std::string toString() const;
+
+    bool operator==(const InetAddress &other) const;
+    bool operator!=(const InetAddress &other) const;
 };
 
 class Socket
@@ -47,6 +55,8 @@ class Socket
   private:
     int fd;
     int domain;
+    // Set once the kernel has refused segmentation offload for this socket, shared by the copies of the socket
+    std::shared_ptr<std::atomic<bool>> segmentationUnsupported;
 
   public:
     Socket();
@@ -55,7 +65,10 @@ class Socket
   public:
     void bind(const InetAddress &address) const;
     int receive(uint8_t *buffer, size_t bufferSize, int timeoutMs, InetAddress &outAddress) const;
+    int receive(uint8_t *buffer, size_t bufferSize, int timeoutMs, InetAddress &outAddress,
+                size_t &outSegmentSize) const;
     void send(const InetAddress &address, const uint8_t *buffer, size_t size) const;
+    void sendSegments(const InetAddress &address, const uint8_t *buffer, size_t size, size_t segmentSize) const;
     void close();
     [[nodiscard]] bool hasFd() const;
     [[nodiscard]] InetAddress getAddress() const;
@@ -63,6 +76,8 @@ class Socket
 
     /* Socket options */
     void setReuseAddress() const;
+    void setReceiveBufferSize(int size) const;
+    bool setReceiveOffload() const;
 
   public:
     static Socket CreateAndBindUdp(const InetAddress &address);
@@ -29,6 +29,23 @@ void TimerBase::setTimerAbsolute(int timerId, int64_t timeMs)
     timerQueue.push(timerInfo);
 }
 
+void TimerBase::cancelTimer(int timerId)
+{
+    std::vector<TimerInfo *> remaining{};
+    while (!timerQueue.empty())
+    {
+        auto *timer = timerQueue.top();
+        timerQueue.pop();
+        if (timer->timerId == timerId)
+            delete timer;
+        else
+            remaining.push_back(timer);
+    }
+
+    for (auto *timer : remaining)
+        timerQueue.push(timer);
+}
+
 int64_t TimerBase::getNextWaitTime()
 {
     if (timerQueue.empty())
@@ -109,6 +126,12 @@ bool NtsTask::setTimerAbsolute(int timerId, int64_t timeMs)
     return true;
 }
 
+void NtsTask::cancelTimer(int timerId)
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    timerBase.cancelTimer(timerId);
+}
+
 std::unique_ptr<NtsMessage> NtsTask::poll()
 {
     {
@@ -196,6 +219,7 @@ void NtsTask::start()
 
     if (!isQuiting)
     {
+        isStarted = true;
         thread = std::thread{[this]() {
             while (true)
             {
@@ -237,6 +261,11 @@ void NtsTask::quit()
     onQuit();
 }
 
+bool NtsTask::isRunning() const
+{
+    return isStarted && !isQuiting;
+}
+
 void NtsTask::requestPause()
 {
     if (++pauseReqCount < 0)
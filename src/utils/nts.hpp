@@ -35,6 +35,7 @@ enum class NtsMessageType
 
     UDP_SERVER_RECEIVE,
     CLI_SEND_RESPONSE,
+    CLI_BULK_BEGIN,
 
     GNB_RLS_TO_RRC,
     GNB_RLS_TO_GTP,
@@ -44,7 +45,11 @@ enum class NtsMessageType
     GNB_NGAP_TO_RRC,
     GNB_RRC_TO_NGAP,
     GNB_NGAP_TO_GTP,
+    GNB_GTP_TO_NGAP,
     GNB_SCTP,
+    GNB_NGAP_DECODE,
+    GNB_NGAP_TO_NGAP,
+    GNB_APP_TO_NGAP,
 
     UE_APP_TO_TUN,
     UE_APP_TO_NAS,
@@ -105,6 +110,8 @@ class TimerBase
 
     void setTimerAbsolute(int timerId, int64_t timeMs);
 
+    void cancelTimer(int timerId);
+
     TimerInfo *getAndRemoveExpiredTimer();
 
     int64_t getNextWaitTime();
@@ -120,6 +127,7 @@ class NtsTask
     std::mutex mutex{};
     std::condition_variable cv{};
     std::atomic_bool isQuiting{};
+    std::atomic_bool isStarted{};
     std::atomic_int pauseReqCount{};
     std::atomic_bool pauseConfirmed{};
     std::thread thread;
@@ -133,6 +141,8 @@ class NtsTask
     bool pushFront(std::unique_ptr<NtsMessage> &&msg);
     bool setTimer(int timerId, int64_t delayMs);
     bool setTimerAbsolute(int timerId, int64_t timeMs);
+    // Removes all the pending timers with the given ID, it is no-op if there is none
+    void cancelTimer(int timerId);
 
   protected:
     std::unique_ptr<NtsMessage> poll();
@@ -174,4 +184,7 @@ class NtsTask
 
     // - Returns true iff pause was requested and now is confirmed.
     bool isPauseConfirmed();
+
+    // - Returns true iff the task has its own thread running, i.e. it is started and not quit yet.
+    bool isRunning() const;
 };
\ No newline at end of file
@@ -11,36 +11,145 @@
 
 #include <cstring>
 
+// At most this many unused encode buffers are kept per thread
+static const size_t MAX_POOLED_BUFFERS = 32;
+
+namespace
+{
+
+struct EncodeBufferPool
+{
+    std::vector<uint8_t *> buffers{};
+
+    ~EncodeBufferPool();
+};
+
+} // namespace
+
+static thread_local EncodeBufferPool g_bufferPool{};
+static thread_local bool g_bufferPoolDestroyed = false;
+
+EncodeBufferPool::~EncodeBufferPool()
+{
+    g_bufferPoolDestroyed = true;
+    for (auto *buffer : buffers)
+        delete[] buffer;
+}
+
+static uint8_t *AllocateBuffer(int capacity)
+{
+    if (capacity == OctetString::ENCODE_BUFFER_SIZE && !g_bufferPoolDestroyed && !g_bufferPool.buffers.empty())
+    {
+        uint8_t *buffer = g_bufferPool.buffers.back();
+        g_bufferPool.buffers.pop_back();
+        return buffer;
+    }
+    return new uint8_t[capacity];
+}
+
+static void ReleaseBuffer(uint8_t *buffer, int capacity)
+{
+    // Buffers are returned to the pool of the releasing thread, which is usually the receiver of the encoded message
+    if (capacity == OctetString::ENCODE_BUFFER_SIZE && !g_bufferPoolDestroyed &&
+        g_bufferPool.buffers.size() < MAX_POOLED_BUFFERS)
+    {
+        g_bufferPool.buffers.push_back(buffer);
+        return;
+    }
+    delete[] buffer;
+}
+
+OctetString::OctetString(OctetString &&octetString) noexcept : OctetString()
+{
+    *this = std::move(octetString);
+}
+
+OctetString::~OctetString()
+{
+    if (m_data != m_inline)
+        ReleaseBuffer(m_data, m_capacity);
+}
+
+OctetString &OctetString::operator=(OctetString &&other) noexcept
+{
+    if (this == &other)
+        return *this;
+
+    if (m_data != m_inline)
+        ReleaseBuffer(m_data, m_capacity);
+
+    if (other.m_data == other.m_inline)
+    {
+        std::memcpy(m_inline, other.m_inline, other.m_length);
+        m_data = m_inline;
+        m_capacity = INLINE_CAPACITY;
+    }
+    else
+    {
+        m_data = other.m_data;
+        m_capacity = other.m_capacity;
+    }
+    m_length = other.m_length;
+
+    other.m_data = other.m_inline;
+    other.m_length = 0;
+    other.m_capacity = INLINE_CAPACITY;
+    return *this;
+}
+
+bool OctetString::operator==(const OctetString &other) const
+{
+    return m_length == other.m_length && (m_length == 0 || std::memcmp(m_data, other.m_data, m_length) == 0);
+}
+
+bool OctetString::operator!=(const OctetString &other) const
+{
+    return !(*this == other);
+}
+
+void OctetString::grow(int capacity)
+{
+    // Grows geometrically so that appending octet by octet is amortized
+    reserve(capacity < 2 * m_capacity ? 2 * m_capacity : capacity);
+}
+
 void OctetString::append(const OctetString &v)
 {
-    m_data.insert(m_data.end(), v.m_data.begin(), v.m_data.end());
+    // The string may also be appended to itself, so the source is taken after extending
+    int length = v.m_length;
+    uint8_t *p = extend(length);
+    if (length > 0)
+        std::memcpy(p, v.m_data, length);
 }
 
 void OctetString::appendUtf8(const std::string &v)
 {
-    m_data.insert(m_data.end(), v.begin(), v.end());
+    if (!v.empty())
+        std::memcpy(extend(static_cast<int>(v.size())), v.data(), v.size());
 }
 
 void OctetString::appendOctet(uint8_t v)
 {
-    m_data.push_back(v);
+    *extend(1) = v;
 }
 
 void OctetString::appendOctet(int v)
 {
-    m_data.push_back(v & 0xFF);
+    *extend(1) = static_cast<uint8_t>(v & 0xFF);
 }
 
 void OctetString::appendOctet2(octet2 v)
 {
-    m_data.push_back(v[0]);
-    m_data.push_back(v[1]);
+    uint8_t *p = extend(2);
+    p[0] = v[0];
+    p[1] = v[1];
 }
 
 void OctetString::appendOctet2(uint16_t v)
 {
-    appendOctet(static_cast<uint8_t>(v >> 8 & 0xFF));
-    appendOctet(static_cast<uint8_t>(v & 0xFF));
+    uint8_t *p = extend(2);
+    p[0] = static_cast<uint8_t>(v >> 8 & 0xFF);
+    p[1] = static_cast<uint8_t>(v & 0xFF);
 }
 
 void OctetString::appendOctet2(int v)
@@ -50,9 +159,10 @@ void OctetString::appendOctet2(int v)
 
 void OctetString::appendOctet3(octet3 v)
 {
-    m_data.push_back(v[0]);
-    m_data.push_back(v[1]);
-    m_data.push_back(v[2]);
+    uint8_t *p = extend(3);
+    p[0] = v[0];
+    p[1] = v[1];
+    p[2] = v[2];
 }
 
 void OctetString::appendOctet3(int v)
@@ -62,22 +172,16 @@ void OctetString::appendOctet3(int v)
 
 void OctetString::appendOctet4(octet4 v)
 {
-    m_data.push_back(v[0]);
-    m_data.push_back(v[1]);
-    m_data.push_back(v[2]);
-    m_data.push_back(v[3]);
+    uint8_t *p = extend(4);
+    for (int i = 0; i < 4; i++)
+        p[i] = v[i];
 }
 
 void OctetString::appendOctet8(octet8 v)
 {
-    m_data.push_back(v[0]);
-    m_data.push_back(v[1]);
-    m_data.push_back(v[2]);
-    m_data.push_back(v[3]);
-    m_data.push_back(v[4]);
-    m_data.push_back(v[5]);
-    m_data.push_back(v[6]);
-    m_data.push_back(v[7]);
+    uint8_t *p = extend(8);
+    for (int i = 0; i < 8; i++)
+        p[i] = v[i];
 }
 
 void OctetString::appendOctet8(int64_t v)
@@ -102,7 +206,12 @@ void OctetString::appendOctet4(uint32_t v)
 
 int OctetString::length() const
 {
-    return static_cast<int>(m_data.size());
+    return m_length;
+}
+
+size_t OctetString::heapUsage() const
+{
+    return m_data == m_inline ? 0 : static_cast<size_t>(m_capacity);
 }
 
 void OctetString::appendOctet(int bigHalf, int littleHalf)
@@ -114,28 +223,50 @@ void OctetString::appendOctet(int bigHalf, int littleHalf)
 
 const uint8_t *OctetString::data() const
 {
-    return m_data.data();
+    return m_data;
 }
 
 uint8_t *OctetString::data()
 {
-    return m_data.data();
+    return m_data;
 }
 
 void OctetString::appendPadding(int length)
 {
-    for (int i = 0; i < length; i++)
-        appendOctet(0);
+    if (length > 0)
+        std::memset(extend(length), 0, length);
+}
+
+void OctetString::reserve(int capacity)
+{
+    if (capacity <= m_capacity)
+        return;
+
+    uint8_t *data = AllocateBuffer(capacity);
+    if (m_length > 0)
+        std::memcpy(data, m_data, m_length);
+    if (m_data != m_inline)
+        ReleaseBuffer(m_data, m_capacity);
+
+    m_data = data;
+    m_capacity = capacity;
+}
+
+void OctetString::reserveEncodeBuffer()
+{
+    if (m_capacity < ENCODE_BUFFER_SIZE && m_length <= ENCODE_BUFFER_SIZE)
+        reserve(ENCODE_BUFFER_SIZE);
 }
 
 OctetString OctetString::FromHex(const std::string &hex)
 {
-    return OctetString{utils::HexStringToVector(hex)};
+    auto v = utils::HexStringToVector(hex);
+    return FromArray(v.data(), v.size());
 }
 
 std::string OctetString::toHexString() const
 {
-    return utils::VectorToHexString(m_data);
+    return utils::VectorToHexString(std::vector<uint8_t>{m_data, m_data + m_length});
 }
 
 OctetString OctetString::subCopy(int index) const
@@ -145,7 +276,7 @@ OctetString OctetString::subCopy(int index) const
 
 OctetString OctetString::subCopy(int index, int length) const
 {
-    return OctetString{std::vector<uint8_t>{m_data.data() + index, m_data.data() + index + length}};
+    return FromArray(m_data + index, static_cast<size_t>(length));
 }
 
 octet OctetString::get(int index) const
@@ -211,22 +342,18 @@ uint64_t OctetString::get8UL(int index) const
 
 OctetString OctetString::Concat(const OctetString &a, const OctetString &b)
 {
-    std::vector<uint8_t> v1 = a.m_data;
-    std::vector<uint8_t> v2 = b.m_data;
-    std::vector<uint8_t> v3;
-
-    v3.reserve(v1.size() + v2.size());
-    v3.insert(v3.end(), v1.begin(), v1.end());
-    v3.insert(v3.end(), v2.begin(), v2.end());
-
-    return OctetString{std::move(v3)};
+    OctetString res;
+    res.reserve(a.length() + b.length());
+    res.append(a);
+    res.append(b);
+    return res;
 }
 
 OctetString OctetString::FromOctet(uint8_t value)
 {
-    std::vector<uint8_t> v(1);
-    v[0] = value;
-    return OctetString{std::move(v)};
+    OctetString res;
+    res.appendOctet(value);
+    return res;
 }
 
 OctetString OctetString::FromOctet(int value)
@@ -236,10 +363,9 @@ OctetString OctetString::FromOctet(int value)
 
 OctetString OctetString::FromOctet2(octet2 value)
 {
-    std::vector<uint8_t> v(2);
-    v[0] = value[0];
-    v[1] = value[1];
-    return OctetString{std::move(v)};
+    OctetString res;
+    res.appendOctet2(value);
+    return res;
 }
 
 OctetString OctetString::FromOctet2(int value)
@@ -249,12 +375,9 @@ OctetString OctetString::FromOctet2(int value)
 
 OctetString OctetString::FromOctet4(octet4 value)
 {
-    std::vector<uint8_t> v(4);
-    v[0] = value[0];
-    v[1] = value[1];
-    v[2] = value[2];
-    v[3] = value[3];
-    return OctetString{std::move(v)};
+    OctetString res;
+    res.appendOctet4(value);
+    return res;
 }
 
 OctetString OctetString::FromOctet4(int value)
@@ -269,16 +392,9 @@ OctetString OctetString::FromOctet4(uint32_t value)
 
 OctetString OctetString::FromOctet8(octet8 value)
 {
-    std::vector<uint8_t> v(8);
-    v[0] = value[0];
-    v[1] = value[1];
-    v[2] = value[2];
-    v[3] = value[3];
-    v[4] = value[4];
-    v[5] = value[5];
-    v[6] = value[6];
-    v[7] = value[7];
-    return OctetString{std::move(v)};
+    OctetString res;
+    res.appendOctet8(value);
+    return res;
 }
 
 OctetString OctetString::FromOctet8(int64_t value)
@@ -298,12 +414,16 @@ OctetString OctetString::copy() const
 
 OctetString OctetString::FromAscii(const std::string &ascii)
 {
-    return OctetString{std::vector<uint8_t>{ascii.c_str(), ascii.c_str() + ascii.length()}};
+    OctetString res;
+    res.appendUtf8(ascii);
+    return res;
 }
 
 OctetString OctetString::FromSpare(int length)
 {
-    return OctetString{std::vector<uint8_t>(length)};
+    OctetString res;
+    res.appendPadding(length);
+    return res;
 }
 
 OctetString OctetString::Xor(const OctetString &a, const OctetString &b)
@@ -324,7 +444,8 @@ OctetString OctetString::Empty()
 
 OctetString OctetString::FromArray(const uint8_t *arr, size_t len)
 {
-    std::vector<uint8_t> v(len);
-    std::memcpy(v.data(), arr, len);
-    return OctetString(std::move(v));
+    OctetString res;
+    if (len > 0)
+        std::memcpy(res.extend(static_cast<int>(len)), arr, len);
+    return res;
 }
@@ -15,23 +15,32 @@
 #include <memory>
 #include <vector>
 
+/*
+ * Values of at most INLINE_CAPACITY octets, such as counters and keys, are stored inline without a heap allocation.
+ * Larger values are stored on the heap, and encoders may obtain a reusable buffer with reserveEncodeBuffer().
+ *
+ * 32 octets is the largest key the UE and gNB handle (K_AUSF, K_SEAF, K_AMF, K_gNB are 256-bit), so every key, MAC,
+ * RAND and AUTN fits inline. This makes the object 48 octets instead of the 24 octets of a std::vector.
+ */
 class OctetString
 {
+  public:
+    static constexpr int INLINE_CAPACITY = 32;
+    static constexpr int ENCODE_BUFFER_SIZE = 4096;
+
   private:
-    std::vector<uint8_t> m_data;
+    uint8_t *m_data;
+    int m_length;
+    int m_capacity;
+    uint8_t m_inline[INLINE_CAPACITY];
 
   public:
-    OctetString() : m_data()
+    OctetString() noexcept : m_data(m_inline), m_length(0), m_capacity(INLINE_CAPACITY)
     {
     }
 
-    explicit OctetString(std::vector<uint8_t> &&data) : m_data(std::move(data))
-    {
-    }
-
-    OctetString(OctetString &&octetString) noexcept : m_data(std::move(octetString.m_data))
-    {
-    }
+    OctetString(OctetString &&octetString) noexcept;
+    ~OctetString();
 
   public:
     void append(const OctetString &v);
@@ -51,10 +60,15 @@ class OctetString
     void appendOctet8(int64_t v);
     void appendOctet8(uint64_t v);
     void appendPadding(int length);
+    void reserve(int capacity);
+
+    /* Reserves a buffer of ENCODE_BUFFER_SIZE from the thread-local pool, unless the capacity is already larger */
+    void reserveEncodeBuffer();
 
   public:
     [[nodiscard]] const uint8_t *data() const;
     [[nodiscard]] int length() const;
+    [[nodiscard]] size_t heapUsage() const;
     uint8_t *data();
 
   public:
@@ -78,20 +92,21 @@ class OctetString
     [[nodiscard]] OctetString subCopy(int index, int length) const;
 
   public:
-    inline OctetString &operator=(OctetString &&other) noexcept
-    {
-        m_data = std::move(other.m_data);
-        return *this;
-    }
+    OctetString &operator=(OctetString &&other) noexcept;
 
-    inline bool operator==(const OctetString &other)
-    {
-        return m_data == other.m_data;
-    }
+    bool operator==(const OctetString &other) const;
+    bool operator!=(const OctetString &other) const;
+
+  private:
+    void grow(int capacity);
 
-    inline bool operator!=(const OctetString &other)
+    inline uint8_t *extend(int length)
     {
-        return m_data != other.m_data;
+        if (m_length + length > m_capacity)
+            grow(m_length + length);
+        uint8_t *p = m_data + m_length;
+        m_length += length;
+        return p;
     }
 
   public:
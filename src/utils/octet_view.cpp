@@ -9,26 +9,50 @@
 #include "octet_view.hpp"
 #include "octet_string.hpp"
 
-#include <stdexcept>
+OctetView::OctetView(const OctetString &data)
+    : data(data.data()), index(0), size(data.length()), failed(false), parent(nullptr)
+{
+}
 
-OctetView::OctetView(const OctetString &data) : data(data.data()), index(0), size(data.length())
+OctetView::OctetView(const uint8_t *data, size_t size)
+    : data(data), index(0), size(size), failed(false), parent(nullptr)
 {
 }
 
-OctetView::OctetView(const uint8_t *data, size_t size) : data(data), index(0), size(size)
+OctetView::OctetView(const uint8_t *data, size_t size, const OctetView *parent)
+    : data(data), index(0), size(size), failed(false), parent(parent)
 {
 }
 
+OctetView OctetView::readView(int length) const
+{
+    if (length < 0 || !available(static_cast<size_t>(length)))
+    {
+        fail();
+        return OctetView{data + index, 0, this};
+    }
+
+    index += length;
+    return OctetView{data + index - length, static_cast<size_t>(length), this};
+}
+
+OctetView OctetView::readView(size_t length) const
+{
+    return readView(static_cast<int>(length));
+}
+
 OctetString OctetView::readOctetString(int length) const
 {
-    if (length == 0)
+    if (length <= 0 || !available(static_cast<size_t>(length)))
+    {
+        if (length < 0)
+            fail();
         return {};
-    else if (index + length > size)
-        throw std::out_of_range("Invalid arguments for readOctetString");
+    }
 
-    std::vector<uint8_t> v{data + index, data + index + length};
+    auto res = OctetString::FromArray(data + index, static_cast<size_t>(length));
     index += length;
-    return OctetString(std::move(v));
+    return res;
 }
 
 OctetString OctetView::readOctetString(size_t length) const
@@ -43,6 +67,13 @@ OctetString OctetView::readOctetString() const
 
 std::string OctetView::readUtf8String(int length) const
 {
+    if (length <= 0 || !available(static_cast<size_t>(length)))
+    {
+        if (length < 0)
+            fail();
+        return {};
+    }
+
     auto res = std::string(data + index, data + index + length);
     index += length;
     return res;
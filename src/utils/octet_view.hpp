@@ -17,25 +17,52 @@
 
 class OctetString;
 
-// TODO: add bound check
+/*
+ * Every read is checked against the bounds of the view. Reading past the end does not throw, instead the view is marked
+ * as failed, further reads return zero and hasNext() returns false. Hence decoders read the fields without checking,
+ * and the result is validated only once by calling hasError() at the end of the message.
+ */
 class OctetView
 {
     const uint8_t *data;
     mutable size_t index;
     size_t size;
+    mutable bool failed;
+    const OctetView *parent;
 
   public:
     OctetView(const uint8_t *data, size_t size);
     explicit OctetView(const OctetString &data);
 
+  private:
+    OctetView(const uint8_t *data, size_t size, const OctetView *parent);
+
+    inline void fail() const
+    {
+        // A malformed sub-view also makes the enclosing message malformed
+        failed = true;
+        index = size;
+        if (parent != nullptr)
+            parent->fail();
+    }
+
+    inline bool available(size_t length) const
+    {
+        if (length <= size - index)
+            return true;
+        fail();
+        return false;
+    }
+
+  public:
     inline octet peek() const
     {
-        return data[index];
+        return index < size ? octet{data[index]} : octet{0};
     }
 
     inline octet peek(int offset) const
     {
-        return data[index + offset];
+        return offset >= 0 && static_cast<size_t>(offset) < size - index ? octet{data[index + offset]} : octet{0};
     }
 
     inline int peekI() const
@@ -50,7 +77,7 @@ class OctetView
 
     inline octet read() const
     {
-        return data[index++];
+        return available(1) ? octet{data[index++]} : octet{0};
     }
 
     inline int readI() const
@@ -60,7 +87,10 @@ class OctetView
 
     inline octet2 read2() const
     {
-        return octet2{read(), read()};
+        if (!available(2))
+            return octet2{};
+        index += 2;
+        return octet2{data[index - 2], data[index - 1]};
     }
 
     inline uint16_t read2US() const
@@ -75,7 +105,10 @@ class OctetView
 
     inline octet3 read3() const
     {
-        return {read(), read(), read()};
+        if (!available(3))
+            return octet3{};
+        index += 3;
+        return {data[index - 3], data[index - 2], data[index - 1]};
     }
 
     inline int read3I() const
@@ -85,7 +118,10 @@ class OctetView
 
     inline octet4 read4() const
     {
-        return {read(), read(), read(), read()};
+        if (!available(4))
+            return octet4{};
+        index += 4;
+        return {data[index - 4], data[index - 3], data[index - 2], data[index - 1]};
     }
 
     inline int read4I() const
@@ -100,7 +136,11 @@ class OctetView
 
     inline octet8 read8() const
     {
-        return {read(), read(), read(), read(), read(), read(), read(), read()};
+        if (!available(8))
+            return octet8{};
+        index += 8;
+        const uint8_t *p = data + index - 8;
+        return {p[0], p[1], p[2], p[3], p[4], p[5], p[6], p[7]};
     }
 
     inline uint64_t read8UL() const
@@ -118,11 +158,25 @@ class OctetView
         return index;
     }
 
+    inline size_t remaining() const
+    {
+        return size - index;
+    }
+
     inline bool hasNext() const
     {
         return index < size;
     }
 
+    inline bool hasError() const
+    {
+        return failed;
+    }
+
+    /* Returns the next given number of octets as a separate view without copying them */
+    OctetView readView(int length) const;
+    OctetView readView(size_t length) const;
+
     OctetString readOctetString(int length) const;
     OctetString readOctetString(size_t length) const;
     OctetString readOctetString() const;
@@ -0,0 +1,120 @@
+//
+// This file is a part of UERANSIM project.
+// Copyright (c) 2023 ALİ GÜNGÖR.
+//
+// https://github.com/aligungr/UERANSIM/
+// See README, LICENSE, and CONTRIBUTING files for licensing details.
+//
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+
+/*
+ * A read-mostly value shared between the tasks. Each version of the value is immutable once published, readers take a
+ * reference to the current version and writers publish a modified copy of it.
+ *
+ * Reads are wait-free: a reader announces itself in the counter of the current epoch, copies the reference and leaves.
+ * Writers are serialized by a mutex, and before deleting the replaced reference they flip the epoch twice and wait for
+ * the readers of each epoch to leave, since those may still be copying it. The replaced version itself is freed by its
+ * last reader.
+ */
+template <typename T>
+class Snapshot
+{
+  private:
+    std::atomic<std::shared_ptr<const T> *> m_current;
+    mutable std::atomic<uint64_t> m_epoch;
+    mutable std::atomic<int> m_readers[2];
+    std::mutex m_writeMutex;
+
+  public:
+    Snapshot() : Snapshot(T{})
+    {
+    }
+
+    explicit Snapshot(T value)
+        : m_current{new std::shared_ptr<const T>{std::make_shared<const T>(std::move(value))}}, m_epoch{0},
+          m_readers{{0}, {0}}, m_writeMutex{}
+    {
+    }
+
+    ~Snapshot()
+    {
+        delete m_current.load();
+    }
+
+    static_assert(!std::is_reference<T>::value);
+
+    Snapshot(const Snapshot &) = delete;
+    Snapshot(Snapshot &&) = delete;
+
+    Snapshot &operator=(const Snapshot &) = delete;
+    Snapshot &operator=(Snapshot &&) = delete;
+
+    template <typename Func>
+    inline void access(Func &&fun) const
+    {
+        auto value = get();
+        fun(*value);
+    }
+
+    template <typename Func>
+    inline void mutate(Func &&fun)
+    {
+        std::lock_guard lk(m_writeMutex);
+        auto value = std::make_shared<T>(**m_current.load());
+        fun(*value);
+        publish(std::shared_ptr<const T>{std::move(value)});
+    }
+
+    /* The returned version stays valid and unchanged as long as it is referenced */
+    [[nodiscard]] inline std::shared_ptr<const T> get() const
+    {
+        auto &readers = m_readers[m_epoch.load() & 1];
+        readers.fetch_add(1);
+        std::shared_ptr<const T> value = *m_current.load();
+        readers.fetch_sub(1);
+        return value;
+    }
+
+    template <typename U, typename Func>
+    inline U get(Func &&fun) const
+    {
+        return fun(*get());
+    }
+
+    inline void set(const T &value)
+    {
+        set(T{value});
+    }
+
+    inline void set(T &&value)
+    {
+        std::lock_guard lk(m_writeMutex);
+        publish(std::make_shared<const T>(std::move(value)));
+    }
+
+  private:
+    /* Called with the write mutex held */
+    void publish(std::shared_ptr<const T> &&value)
+    {
+        auto *replaced = m_current.exchange(new std::shared_ptr<const T>{std::move(value)});
+
+        // A reader of the replaced reference has announced itself in one of the two epochs before the exchange. New
+        // readers join the epoch after the flip, so the waited epoch drains quickly.
+        for (int i = 0; i < 2; i++)
+        {
+            auto &readers = m_readers[m_epoch.fetch_add(1) & 1];
+            while (readers.load() != 0)
+                std::this_thread::yield();
+        }
+
+        delete replaced;
+    }
+};
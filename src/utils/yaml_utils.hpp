@@ -26,6 +26,7 @@ void AssertHasFields(const YAML::Node &node, const std::vector<std::string> &fie
 
 void AssertHasInt32(const YAML::Node &node, const std::string &name);
 void AssertHasInt64(const YAML::Node &node, const std::string &name);
+void AssertHasDouble(const YAML::Node &node, const std::string &name);
 void AssertHasString(const YAML::Node &node, const std::string &name);
 void AssertHasBool(const YAML::Node &node, const std::string &name);
 void AssertHasSequence(const YAML::Node &node, const std::string &name);
@@ -37,6 +38,10 @@ int64_t GetInt64(const YAML::Node &node, const std::string &name);
 int64_t GetInt64(const YAML::Node &node, const std::string &name, std::optional<int64_t> minValue,
                  std::optional<int64_t> maxValue);
 
+double GetDouble(const YAML::Node &node, const std::string &name);
+double GetDouble(const YAML::Node &node, const std::string &name, std::optional<double> minValue,
+                 std::optional<double> maxValue);
+
 std::string GetString(const YAML::Node &node, const std::string &name);
 std::string GetString(const YAML::Node &node, const std::string &name, std::optional<int> minLength,
                       std::optional<int> maxLength);
@@ -0,0 +1,264 @@
+//
+// This file is a part of UERANSIM project.
+// Copyright (c) 2023 ALİ GÜNGÖR.
+//
+// https://github.com/aligungr/UERANSIM/
+// See README, LICENSE, and CONTRIBUTING files for licensing details.
+//
+
+#include <iostream>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#include <lib/nas/encode.hpp>
+#include <lib/nas/msg_ies.hpp>
+
+static int g_failures = 0;
+
+static void Fail(const std::string &name, const std::string &reason)
+{
+    std::cerr << "FAIL " << name << ": " << reason << std::endl;
+    g_failures++;
+}
+
+/*
+ * Encodes the message and compares the octets with the expected ones, which are generated by the encoder of the
+ * baseline release. Then decodes it back and checks that the re-encoding gives the same octets.
+ */
+static void RoundTrip(const std::string &name, const nas::NasMessage &msg, const std::string &expected)
+{
+    OctetString encoded{};
+    nas::EncodeNasMessage(msg, encoded);
+
+    if (encoded.toHexString() != expected)
+        Fail(name, "encoding differs: " + encoded.toHexString() + " vs expected " + expected);
+
+    std::unique_ptr<nas::NasMessage> decoded{};
+    try
+    {
+        OctetView view{encoded};
+        decoded = nas::DecodeNasMessage(view);
+    }
+    catch (const std::runtime_error &e)
+    {
+        Fail(name, e.what());
+        return;
+    }
+
+    if (decoded == nullptr)
+    {
+        Fail(name, "message could not be decoded: " + encoded.toHexString());
+        return;
+    }
+
+    OctetString reencoded{};
+    nas::EncodeNasMessage(*decoded, reencoded);
+    if (!(encoded == reencoded))
+        Fail(name, "re-encoding differs: " + encoded.toHexString() + " vs " + reencoded.toHexString());
+}
+
+/*
+ * Sets every optional IE of a message to its default value, so that the whole message can be exercised.
+ */
+class NasMessageFiller
+{
+  public:
+    template <typename T>
+    inline void mandatoryIE(T *)
+    {
+    }
+
+    template <typename T>
+    inline void mandatoryIE1(T *)
+    {
+    }
+
+    template <typename T, typename U>
+    inline void mandatoryIE1(T *, U *)
+    {
+    }
+
+    template <typename T>
+    inline void optionalIE(int, std::optional<T> *ptr)
+    {
+        ptr->emplace();
+    }
+
+    template <typename T>
+    inline void optionalIE1(int, std::optional<T> *ptr)
+    {
+        ptr->emplace();
+    }
+};
+
+template <typename T, typename = void>
+struct HasEapMessage : std::false_type
+{
+};
+
+template <typename T>
+struct HasEapMessage<T, std::void_t<decltype(&T::eapMessage)>> : std::true_type
+{
+};
+
+/* The EAP message IE holds the EAP PDU by pointer, so it needs a PDU to be encodable */
+static void FillEap(nas::IEEapMessage &ie)
+{
+    ie.eap = std::make_unique<eap::EapIdentity>(eap::ECode::RESPONSE, 1, OctetString::FromHex("0102"));
+}
+
+static void FillEap(std::optional<nas::IEEapMessage> &ie)
+{
+    if (ie.has_value())
+        FillEap(*ie);
+}
+
+/* Some IEs have fixed size fields, which are left empty by the default values */
+template <typename T>
+static void FillFixedSizeIes(T &)
+{
+}
+
+static void FillFixedSizeIes(nas::AuthenticationRequest &msg)
+{
+    if (msg.authParamRAND.has_value())
+        msg.authParamRAND->value = OctetString::FromSpare(16);
+}
+
+static void FillFixedSizeIes(std::optional<nas::IESorTransparentContainer> &ie)
+{
+    if (ie.has_value())
+        ie->sorMacIAusf = OctetString::FromSpare(16);
+}
+
+static void FillFixedSizeIes(nas::RegistrationAccept &msg)
+{
+    FillFixedSizeIes(msg.sorTransparentContainer);
+}
+
+static void FillFixedSizeIes(nas::RegistrationComplete &msg)
+{
+    FillFixedSizeIes(msg.sorTransparentContainer);
+}
+
+template <typename T>
+static void TestMessage(const std::string &name, const std::string &expectedEmpty, const std::string &expectedFull)
+{
+    T empty{};
+    if constexpr (HasEapMessage<T>::value)
+        FillEap(empty.eapMessage);
+    RoundTrip(name, empty, expectedEmpty);
+
+    T full{};
+    NasMessageFiller filler{};
+    full.onBuild(filler);
+    if constexpr (HasEapMessage<T>::value)
+        FillEap(full.eapMessage);
+    FillFixedSizeIes(full);
+    RoundTrip(name + " (all optional IEs)", full, expectedFull);
+}
+
+static void TestUnknownIei()
+{
+    nas::RegistrationComplete msg{};
+    OctetString encoded{};
+    nas::EncodeNasMessage(msg, encoded);
+    encoded.appendOctet(0x01);
+
+    try
+    {
+        OctetView view{encoded};
+        nas::DecodeNasMessage(view);
+        Fail("unknown IEI", "message was accepted");
+    }
+    catch (const std::runtime_error &)
+    {
+    }
+}
+
+int main()
+{
+    TestMessage<nas::AuthenticationFailure>("AuthenticationFailure", "7E005900", "7E0059003000");
+    TestMessage<nas::AuthenticationReject>("AuthenticationReject", "7E0058", "7E005878000702010007010102");
+    TestMessage<nas::AuthenticationRequest>("AuthenticationRequest", "7E00560700",
+                                            "7E005607002100000000000000000000000000000000200078000702010007010102");
+    TestMessage<nas::AuthenticationResponse>("AuthenticationResponse", "7E0057", "7E00572D0078000702010007010102");
+    TestMessage<nas::AuthenticationResult>("AuthenticationResult", "7E005A07000702010007010102",
+                                           "7E005A070007020100070101023800");
+    // The baseline encoder dropped the flags octet of the network name IEs (43, 45), which is the only difference
+    TestMessage<nas::ConfigurationUpdateCommand>("ConfigurationUpdateCommand", "7E0054",
+                                                 "7E0054D07700010054001500270043010045010046004700000000000000490100"
+                                                 "790000B09031001100760000F0");
+    TestMessage<nas::ConfigurationUpdateComplete>("ConfigurationUpdateComplete", "7E0055", "7E0055");
+    TestMessage<nas::DeRegistrationAcceptUeOriginating>("DeRegistrationAcceptUeOriginating", "7E0046", "7E0046");
+    TestMessage<nas::DeRegistrationAcceptUeTerminated>("DeRegistrationAcceptUeTerminated", "7E0048", "7E0048");
+    TestMessage<nas::DeRegistrationRequestUeOriginating>("DeRegistrationRequestUeOriginating", "7E004570000100",
+                                                         "7E004570000100");
+    TestMessage<nas::DeRegistrationRequestUeTerminated>("DeRegistrationRequestUeTerminated", "7E004700",
+                                                        "7E00470058005F0100");
+    TestMessage<nas::DlNasTransport>("DlNasTransport", "7E0068000000", "7E0068000000120024005800370100");
+    TestMessage<nas::FiveGMmStatus>("FiveGMmStatus", "7E006400", "7E006400");
+    TestMessage<nas::FiveGSmStatus>("FiveGSmStatus", "2E0000D600", "2E0000D600");
+    TestMessage<nas::IdentityRequest>("IdentityRequest", "7E005B00", "7E005B00");
+    TestMessage<nas::IdentityResponse>("IdentityResponse", "7E005C000100", "7E005C000100");
+    TestMessage<nas::Notification>("Notification", "7E006500", "7E006500");
+    TestMessage<nas::NotificationResponse>("NotificationResponse", "7E0066", "7E006650020000");
+    TestMessage<nas::PduSessionAuthenticationCommand>("PduSessionAuthenticationCommand", "2E0000C5000702010007010102",
+                                                      "2E0000C50007020100070101027B000100");
+    TestMessage<nas::PduSessionAuthenticationComplete>("PduSessionAuthenticationComplete", "2E0000C6000702010007010102",
+                                                       "2E0000C60007020100070101027B000100");
+    TestMessage<nas::PduSessionAuthenticationResult>("PduSessionAuthenticationResult", "2E0000C7",
+                                                     "2E0000C7780007020100070101027B000100");
+    TestMessage<nas::PduSessionEstablishmentAccept>("PduSessionEstablishmentAccept", "2E0000C200000006000000000000",
+                                                    "2E0000C20000000600000000000059002901005600220100807F00007800070201"
+                                                    "00070101027900007B0001002500");
+    TestMessage<nas::PduSessionEstablishmentReject>("PduSessionEstablishmentReject", "2E0000C300",
+                                                    "2E0000C300370100F0780007020100070101027B000100");
+    TestMessage<nas::PduSessionEstablishmentRequest>("PduSessionEstablishmentRequest", "2E0000C10000",
+                                                     "2E0000C1000090A0280100550000B039007B000100");
+    TestMessage<nas::PduSessionModificationCommand>("PduSessionModificationCommand", "2E0000CB",
+                                                    "2E0000CB59002A060000000000005600807A00007F00007900007B000100");
+    TestMessage<nas::PduSessionModificationCommandReject>("PduSessionModificationCommandReject", "2E0000CD00",
+                                                          "2E0000CD007B000100");
+    TestMessage<nas::PduSessionModificationComplete>("PduSessionModificationComplete", "2E0000CC", "2E0000CC7B000100");
+    TestMessage<nas::PduSessionModificationReject>("PduSessionModificationReject", "2E0000CA00",
+                                                   "2E0000CA003701007B000100");
+    TestMessage<nas::PduSessionModificationRequest>("PduSessionModificationRequest", "2E0000C9",
+                                                    "2E0000C92801005900550000B01300007A00007900007F00007B000100");
+    TestMessage<nas::PduSessionReleaseCommand>("PduSessionReleaseCommand", "2E0000D300",
+                                               "2E0000D300370100780007020100070101027B000100");
+    TestMessage<nas::PduSessionReleaseComplete>("PduSessionReleaseComplete", "2E0000D4", "2E0000D459007B000100");
+    TestMessage<nas::PduSessionReleaseReject>("PduSessionReleaseReject", "2E0000D200", "2E0000D2007B000100");
+    TestMessage<nas::PduSessionReleaseRequest>("PduSessionReleaseRequest", "2E0000D1", "2E0000D159007B000100");
+    TestMessage<nas::RegistrationAccept>("RegistrationAccept", "7E00420100",
+                                         "7E0042010090A0B0770001004A00540015001100310021010050020000260200007200007900"
+                                         "0027005E01005D010016010034007A0000730013000000000000000000000000000000000000"
+                                         "0078000702010007010102760000510100");
+    TestMessage<nas::RegistrationComplete>("RegistrationComplete", "7E0043",
+                                           "7E004373001300000000000000000000000000000000000000");
+    TestMessage<nas::RegistrationReject>("RegistrationReject", "7E004400", "7E0044005F010016010078000702010007010102");
+    TestMessage<nas::RegistrationRequest>("RegistrationRequest", "7E004170000100",
+                                          "7E004170000100C7B0901001002E04000000002F005200F00000000017070000000000000040"
+                                          "020000500200002B010077000100250200001801005101007000007E00007B00005301007100"
+                                          "00");
+    TestMessage<nas::SecurityModeCommand>("SecurityModeCommand", "7E005D00070400000000",
+                                          "7E005D00070400000000E05700360100780007020100070101023800190700000000000000");
+    TestMessage<nas::SecurityModeComplete>("SecurityModeComplete", "7E005E", "7E005E77000100710000");
+    TestMessage<nas::SecurityModeReject>("SecurityModeReject", "7E005F00", "7E005F00");
+    TestMessage<nas::ServiceAccept>("ServiceAccept", "7E004E", "7E004E500200002602000072000078000702010007010102");
+    TestMessage<nas::ServiceReject>("ServiceReject", "7E004D00", "7E004D00500200005F010078000702010007010102");
+    TestMessage<nas::ServiceRequest>("ServiceRequest", "7E004C07000100",
+                                     "7E004C07000100400200005002000025020000710000");
+    TestMessage<nas::UlNasTransport>("UlNasTransport", "7E0067000000", "7E0067000000120059008022010025002400");
+
+    TestUnknownIei();
+
+    if (g_failures != 0)
+    {
+        std::cerr << g_failures << " NAS codec test(s) failed" << std::endl;
+        return 1;
+    }
+    return 0;
+}